@@ -0,0 +1,928 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/audit/breached_password_checker.h"
+#include "core/encryption/cryptographer.h"
+#include "core/encryption/key_derivation.h"
+#include "core/encryption/sha1.h"
+#include "core/io/csv_importer.h"
+#include "core/io/json_exporter.h"
+#include "core/io/json_importer.h"
+#include "core/io/json_reader.h"
+#include "core/password_container.h"
+#include "core/util.h"
+#include "gui/viewmodel/account_details_view_model.h"
+#include "gui/viewmodel/account_list_view_model.h"
+
+using passwordcontainer::AccountBatch;
+using passwordcontainer::BreachedPasswordChecker;
+using passwordcontainer::Cryptographer;
+using passwordcontainer::CsvImporter;
+using passwordcontainer::ImportReport;
+using passwordcontainer::JsonExporter;
+using passwordcontainer::JsonHandler;
+using passwordcontainer::JsonImporter;
+using passwordcontainer::JsonReader;
+using passwordcontainer::PasswordContainer;
+using passwordcontainer::PasswordStrength;
+using passwordcontainer::gui::viewmodel::AccountDetailsViewModel;
+using passwordcontainer::gui::viewmodel::AccountListViewModel;
+using std::string;
+
+namespace {
+
+// Counts every heap allocation made by the benchmark so the layouts can be
+// compared by how many allocations they make and how many bytes they keep
+std::atomic<size_t> allocation_count(0);
+std::atomic<size_t> free_count(0);
+std::atomic<size_t> live_heap_bytes(0);
+
+// The most bytes that were live at once since it was last reset
+std::atomic<size_t> peak_heap_bytes(0);
+
+// Every allocation starts with a header that stores its size so that the
+// number of live bytes can be updated when it is freed
+const size_t kAllocationHeaderSize = 16;
+
+void* CountedAllocate(size_t size) {
+  char* memory =
+      static_cast<char*>(std::malloc(size + kAllocationHeaderSize));
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  *reinterpret_cast<size_t*>(memory) = size;
+  allocation_count++;
+  size_t live_bytes = live_heap_bytes += size;
+  for (size_t peak_bytes = peak_heap_bytes; live_bytes > peak_bytes &&
+       !peak_heap_bytes.compare_exchange_weak(peak_bytes, live_bytes);) {
+  }
+
+  return memory + kAllocationHeaderSize;
+}
+
+void CountedFree(void* pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+
+  char* memory = static_cast<char*>(pointer) - kAllocationHeaderSize;
+  free_count++;
+  live_heap_bytes -= *reinterpret_cast<size_t*>(memory);
+  std::free(memory);
+}
+
+// Returns the number of allocations that haven't been freed yet.
+size_t GetLiveAllocationCount() {
+  return allocation_count - free_count;
+}
+
+// The heap usage measured for one layout. The allocations and bytes are the
+// ones still live once loading is done, which teardown has to free.
+struct Measurement {
+  size_t allocations;
+  size_t bytes;
+  double load_milliseconds;
+  double teardown_milliseconds;
+};
+
+const size_t kDefaultRecordCount = 1000000;
+
+// The offset and key of the containers the benchmarks create
+const size_t kContainerOffset = 100;
+const string kContainerKey = "BenchmarkKey";
+
+// The number of times every scan is repeated
+const size_t kScanRepetitions = 20;
+
+// Written with the result of every scan so the scans can't be optimized away
+volatile size_t scan_result = 0;
+
+// The names of the benchmarks that can be run
+const string kMemoryBenchmark = "memory";
+const string kScanBenchmark = "scan";
+const string kSearchBenchmark = "search";
+const string kFuzzyBenchmark = "fuzzy";
+const string kReuseBenchmark = "reuse";
+const string kBreachBenchmark = "breach";
+const string kStrengthBenchmark = "strength";
+const string kImportBenchmark = "import";
+const string kJsonBenchmark = "json";
+const string kBatchBenchmark = "batch";
+const string kFrameBenchmark = "frame";
+
+// The number of changes the batch benchmark applies, split evenly between
+// deletes, modifications, and adds
+const size_t kBatchChangeCount = 10000;
+
+// The number of frames every frame benchmark scenario simulates and the
+// number of account rows the list window shows at once
+const size_t kSimulatedFrameCount = 1000;
+const size_t kVisibleRowCount = 20;
+
+// Where the breach benchmark writes its list of breached password hashes
+const string kBreachCorpusPath = "breach-benchmark-corpus.txt";
+
+// Where the json benchmark writes its export
+const string kJsonExportPath = "json-benchmark-export.json";
+
+// Returns the number of milliseconds since the passed in start time.
+double GetMillisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Generates the fields of the record with the passed in index. Every field is
+// longer than the small string buffer so each std::string needs the heap.
+string GenerateAccountName(size_t index) {
+  return "account-" + std::to_string(index) + ".example.com";
+}
+
+string GenerateUsername(size_t index) {
+  return "user" + std::to_string(index % 1000) + "@example-mail.com";
+}
+
+string GeneratePassword(size_t index) {
+  return "p@ssw0rd-" + std::to_string(index * 7919) + "-secret";
+}
+
+// Loads record_count records into a vector of AccountDetails, the layout
+// PasswordContainer used before its passwords were packed into an arena.
+Measurement MeasureAccountDetails(size_t record_count) {
+  Measurement measurement;
+  size_t start_allocations = GetLiveAllocationCount();
+  size_t start_bytes = live_heap_bytes;
+  auto start_time = std::chrono::steady_clock::now();
+
+  {
+    std::vector<PasswordContainer::AccountDetails> accounts;
+    accounts.reserve(record_count);
+    for (size_t index = 0; index < record_count; index++) {
+      PasswordContainer::AccountDetails account;
+      account.account_name = GenerateAccountName(index);
+      account.username = GenerateUsername(index);
+      account.password = GeneratePassword(index);
+      accounts.push_back(std::move(account));
+    }
+
+    measurement.load_milliseconds = GetMillisecondsSince(start_time);
+    measurement.allocations = GetLiveAllocationCount() - start_allocations;
+    measurement.bytes = live_heap_bytes - start_bytes;
+    start_time = std::chrono::steady_clock::now();
+  }
+
+  measurement.teardown_milliseconds = GetMillisecondsSince(start_time);
+
+  return measurement;
+}
+
+// Returns a vault with record_count accounts, encrypted directly instead of
+// through a container since AddAccount checks every name that is already in
+// the container.
+string CreateLargeVault(size_t record_count) {
+  PasswordContainer writer(kContainerOffset, kContainerKey);
+  writer.SetKdfIterations(passwordcontainer::keyderivation::kMinimumIterations);
+  writer.SetCryptographerParallelism(0, 1 << 20);
+
+  string plain_text;
+  for (size_t index = 0; index < record_count; index++) {
+    plain_text += GenerateAccountName(index) + '\t' + GenerateUsername(index) +
+                  '\t' + GeneratePassword(index) + '\n';
+  }
+  plain_text.pop_back();
+
+  // Writes the header of the empty writer followed by the encrypted accounts
+  std::stringstream vault;
+  vault << writer;
+  Cryptographer cryptographer(kContainerOffset, writer.GetCryptographerKey());
+  cryptographer.SetParallelism(0, 1 << 20);
+  vault << cryptographer.EncryptString(plain_text);
+
+  return vault.str();
+}
+
+// Creates a container with record_count accounts.
+PasswordContainer CreateLargeContainer(size_t record_count) {
+  std::stringstream vault(CreateLargeVault(record_count));
+  PasswordContainer container(kContainerOffset, kContainerKey);
+  container.SetCryptographerParallelism(0, 1 << 20);
+  vault >> container;
+
+  return container;
+}
+
+// Loads record_count records into a PasswordContainer from a vault. The load
+// time includes decrypting the vault and building the container's indexes, so
+// only the allocations, bytes, and teardown time compare with AccountDetails.
+Measurement MeasurePasswordContainer(size_t record_count) {
+  std::stringstream vault(CreateLargeVault(record_count));
+
+  Measurement measurement;
+  size_t start_allocations = GetLiveAllocationCount();
+  size_t start_bytes = live_heap_bytes;
+  auto start_time = std::chrono::steady_clock::now();
+
+  {
+    PasswordContainer container(kContainerOffset, kContainerKey);
+    container.SetCryptographerParallelism(0, 1 << 20);
+    vault >> container;
+
+    measurement.load_milliseconds = GetMillisecondsSince(start_time);
+    measurement.allocations = GetLiveAllocationCount() - start_allocations;
+    measurement.bytes = live_heap_bytes - start_bytes;
+    start_time = std::chrono::steady_clock::now();
+  }
+
+  measurement.teardown_milliseconds = GetMillisecondsSince(start_time);
+
+  return measurement;
+}
+
+// Returns the average number of milliseconds one call to scan takes.
+double MeasureScan(const std::function<size_t()>& scan) {
+  size_t result = 0;
+  auto start_time = std::chrono::steady_clock::now();
+
+  for (size_t repetition = 0; repetition < kScanRepetitions; repetition++) {
+    result += scan();
+  }
+
+  scan_result = result;
+
+  return GetMillisecondsSince(start_time) / kScanRepetitions;
+}
+
+// Compares how long name only operations take on the interleaved
+// AccountDetails layout and on the container's name column.
+void RunScanBenchmark(size_t record_count) {
+  PasswordContainer container = CreateLargeContainer(record_count);
+  std::vector<PasswordContainer::AccountDetails> accounts =
+      container.GetAccounts();
+  const string missing_name = "missing.example.com";
+
+  std::cout << "Name scans over " << record_count << " records" << std::endl
+            << std::left << std::setw(16) << "layout" << std::right
+            << std::setw(16) << "lookup ms" << std::setw(16) << "list ms"
+            << std::endl;
+
+  // Looking up a missing name compares every name, like HasAccount
+  double interleaved_lookup = MeasureScan([&]() {
+    size_t matches = 0;
+    for (const PasswordContainer::AccountDetails& account : accounts) {
+      matches += account.account_name == missing_name;
+    }
+    return matches;
+  });
+  double interleaved_list = MeasureScan([&]() {
+    size_t length = 0;
+    for (const PasswordContainer::AccountDetails& account : accounts) {
+      length += account.account_name.size() + account.account_name[0];
+    }
+    return length;
+  });
+
+  double column_lookup = MeasureScan([&]() {
+    return static_cast<size_t>(container.HasAccount(missing_name));
+  });
+  double column_list = MeasureScan([&]() {
+    size_t length = 0;
+    for (const string& account_name : container.GetAccountNames()) {
+      length += account_name.size() + account_name[0];
+    }
+    return length;
+  });
+
+  std::cout << std::fixed << std::setprecision(2) << std::left
+            << std::setw(16) << "AccountDetails" << std::right << std::setw(16)
+            << interleaved_lookup << std::setw(16) << interleaved_list
+            << std::endl
+            << std::left << std::setw(16) << "name column" << std::right
+            << std::setw(16) << column_lookup << std::setw(16) << column_list
+            << std::endl;
+}
+
+// Returns the names in account_names that contain query, checking every name
+// like a search without an index would.
+std::vector<string> SearchWithoutIndex(const std::vector<string>& account_names,
+                                       const string& query) {
+  string folded_query = util::ConvertToLowerCase(query);
+  std::vector<string> matches;
+
+  for (const string& account_name : account_names) {
+    if (util::ConvertToLowerCase(account_name)
+            .find(folded_query) != string::npos) {
+      matches.push_back(account_name);
+    }
+  }
+
+  return matches;
+}
+
+// Compares how long searches for account names take with the container's
+// search index and with a scan of every name. Times are in microseconds.
+void RunSearchBenchmark(size_t record_count) {
+  PasswordContainer container = CreateLargeContainer(record_count);
+
+  // A prefix that matches a handful of names, a substring in the middle of a
+  // name that only one name has, and a query that matches nothing
+  const size_t target_index = record_count / 2;
+  const std::vector<std::pair<string, string>> queries = {
+      {"prefix", "Account-" + std::to_string(target_index) + "."},
+      {"substring", "-" + std::to_string(target_index) + ".Example"},
+      {"missing", "missing.example.com"}};
+
+  std::cout << "Searches over " << record_count << " records" << std::endl
+            << std::left << std::setw(16) << "query" << std::right
+            << std::setw(12) << "matches" << std::setw(16) << "index us"
+            << std::setw(16) << "scan us" << std::endl;
+
+  for (const std::pair<string, string>& query : queries) {
+    size_t match_count = container.SearchAccounts(query.second).size();
+    double index_milliseconds = MeasureScan(
+        [&]() { return container.SearchAccounts(query.second).size(); });
+    double scan_milliseconds = MeasureScan([&]() {
+      return SearchWithoutIndex(container.GetAccountNames(), query.second)
+          .size();
+    });
+
+    std::cout << std::fixed << std::setprecision(1) << std::left
+              << std::setw(16) << query.first << std::right << std::setw(12)
+              << match_count << std::setw(16) << index_milliseconds * 1000
+              << std::setw(16) << scan_milliseconds * 1000 << std::endl;
+  }
+
+  // Adding and deleting update the index in place instead of rebuilding it
+  const string added_name = "benchmark-added.example.com";
+  auto start_time = std::chrono::steady_clock::now();
+  container.AddAccount(added_name, "user", "password");
+  double add_milliseconds = GetMillisecondsSince(start_time);
+  start_time = std::chrono::steady_clock::now();
+  container.DeleteAccount(added_name);
+  double delete_milliseconds = GetMillisecondsSince(start_time);
+
+  std::cout << "add ms " << add_milliseconds << ", delete ms "
+            << delete_milliseconds << std::endl;
+}
+
+// Returns the edit distance between first and second using the full table,
+// like a matcher without the bit-parallel algorithm or a bound would.
+size_t GetTableDistance(const string& first, const string& second) {
+  std::vector<size_t> previous(second.size() + 1);
+  std::vector<size_t> current(second.size() + 1);
+  for (size_t column = 0; column <= second.size(); column++) {
+    previous[column] = column;
+  }
+
+  for (size_t row = 1; row <= first.size(); row++) {
+    current[0] = row;
+    for (size_t column = 1; column <= second.size(); column++) {
+      size_t replace_cost = first[row - 1] == second[column - 1] ? 0 : 1;
+      current[column] =
+          std::min(std::min(previous[column] + 1, current[column - 1] + 1),
+                   previous[column - 1] + replace_cost);
+    }
+    previous.swap(current);
+  }
+
+  return previous[second.size()];
+}
+
+// Compares how long finding the names closest to a mistyped name takes with
+// the container and with the full distance table for every name.
+void RunFuzzyBenchmark(size_t record_count) {
+  PasswordContainer container = CreateLargeContainer(record_count);
+  const size_t kMaxResults = 5;
+  const size_t kMaxDistance = 2;
+
+  // Swaps two characters in the middle of an existing name
+  string typo = GenerateAccountName(record_count / 2);
+  std::swap(typo[3], typo[4]);
+
+  std::cout << "Closest names to a typo over " << record_count << " records"
+            << std::endl
+            << std::left << std::setw(16) << "matcher" << std::right
+            << std::setw(12) << "matches" << std::setw(16) << "ms" << std::endl;
+
+  size_t match_count =
+      container.FindClosestAccounts(typo, kMaxResults, kMaxDistance).size();
+  double matcher_milliseconds = MeasureScan([&]() {
+    return container.FindClosestAccounts(typo, kMaxResults, kMaxDistance)
+        .size();
+  });
+
+  size_t table_match_count = 0;
+  double table_milliseconds = MeasureScan([&]() {
+    table_match_count = 0;
+    string folded_typo = util::ConvertToLowerCase(typo);
+    for (const string& account_name : container.GetAccountNames()) {
+      table_match_count += GetTableDistance(
+          folded_typo, util::ConvertToLowerCase(account_name)) <= kMaxDistance;
+    }
+    return table_match_count;
+  });
+
+  std::cout << std::fixed << std::setprecision(2) << std::left
+            << std::setw(16) << "bit-parallel" << std::right << std::setw(12)
+            << match_count << std::setw(16) << matcher_milliseconds
+            << std::endl
+            << std::left << std::setw(16) << "full table" << std::right
+            << std::setw(12) << table_match_count << std::setw(16)
+            << table_milliseconds << std::endl;
+}
+
+// Measures how long the first password reuse audit (which hashes every
+// password) takes on one thread and on every hardware thread, and how long an
+// audit takes after a password changes.
+void RunReuseBenchmark(size_t record_count) {
+  std::cout << "Password reuse audit over " << record_count << " records"
+            << std::endl
+            << std::left << std::setw(16) << "audit" << std::right
+            << std::setw(12) << "groups" << std::setw(16) << "ms" << std::endl;
+
+  const std::vector<std::pair<string, size_t>> thread_counts = {
+      {"1 thread", 1}, {"all threads", 0}};
+  for (const std::pair<string, size_t>& thread_count : thread_counts) {
+    PasswordContainer container = CreateLargeContainer(record_count);
+    container.SetCryptographerParallelism(thread_count.second, 1 << 20);
+
+    auto start_time = std::chrono::steady_clock::now();
+    size_t group_count = container.FindReusedPasswords().size();
+    double build_milliseconds = GetMillisecondsSince(start_time);
+
+    std::cout << std::fixed << std::setprecision(2) << std::left
+              << std::setw(16) << thread_count.first << std::right
+              << std::setw(12) << group_count << std::setw(16)
+              << build_milliseconds << std::endl;
+
+    if (thread_count.second != 0) {
+      continue;
+    }
+
+    // Only the changed password is hashed again
+    container.ModifyAccount(GenerateAccountName(0), GenerateUsername(0),
+                            GeneratePassword(1));
+    start_time = std::chrono::steady_clock::now();
+    group_count = container.FindReusedPasswords().size();
+    std::cout << std::left << std::setw(16) << "after a change" << std::right
+              << std::setw(12) << group_count << std::setw(16)
+              << GetMillisecondsSince(start_time) << std::endl;
+  }
+}
+
+// Writes a sorted list of record_count breached password hashes, one of which
+// is the password of every hundredth generated record.
+void WriteBreachCorpus(size_t record_count) {
+  std::vector<string> hashes;
+  hashes.reserve(record_count);
+  for (size_t index = 0; index < record_count; index++) {
+    string password = index % 100 == 0 ? GeneratePassword(index)
+                                        : "breached-" + std::to_string(index);
+    hashes.push_back(passwordcontainer::keyderivation::ConvertToHex(
+        passwordcontainer::Sha1(password)));
+  }
+  std::sort(hashes.begin(), hashes.end());
+
+  std::ofstream corpus(kBreachCorpusPath, std::ios::binary);
+  for (const string& hash : hashes) {
+    corpus << hash << ":1\r\n";
+  }
+}
+
+// Measures how long checking every password of the container against a list
+// of breached password hashes takes with and without a Bloom filter.
+void RunBreachBenchmark(size_t record_count) {
+  PasswordContainer container = CreateLargeContainer(record_count);
+  WriteBreachCorpus(record_count);
+  const string bloom_filter_path = kBreachCorpusPath + ".bloom";
+
+  auto start_time = std::chrono::steady_clock::now();
+  BreachedPasswordChecker::BuildBloomFilter(kBreachCorpusPath,
+                                            bloom_filter_path, 0.001);
+  double build_milliseconds = GetMillisecondsSince(start_time);
+
+  std::cout << "Breached password audit of " << record_count
+            << " records against " << record_count << " hashes" << std::endl
+            << "Bloom filter built in " << std::fixed << std::setprecision(2)
+            << build_milliseconds << " ms" << std::endl
+            << std::left << std::setw(16) << "checker" << std::right
+            << std::setw(12) << "breached" << std::setw(16) << "ms"
+            << std::endl;
+
+  const std::vector<std::pair<string, string>> checkers = {
+      {"search only", ""}, {"Bloom filter", bloom_filter_path}};
+  for (const std::pair<string, string>& checker_files : checkers) {
+    BreachedPasswordChecker checker(kBreachCorpusPath, checker_files.second);
+
+    start_time = std::chrono::steady_clock::now();
+    size_t breached_count = container.FindBreachedAccounts(checker).size();
+    std::cout << std::left << std::setw(16) << checker_files.first
+              << std::right << std::setw(12) << breached_count
+              << std::setw(16) << GetMillisecondsSince(start_time)
+              << std::endl;
+  }
+
+  std::remove(kBreachCorpusPath.c_str());
+  std::remove(bloom_filter_path.c_str());
+}
+
+// Prints one row of the results table.
+void PrintMeasurement(const string& layout, const Measurement& measurement) {
+  std::cout << std::left << std::setw(20) << layout << std::right
+            << std::setw(14) << measurement.allocations << std::setw(14)
+            << measurement.bytes / 1024 << std::setw(12) << std::fixed
+            << std::setprecision(1) << measurement.load_milliseconds
+            << std::setw(14) << measurement.teardown_milliseconds << std::endl;
+}
+
+// Compares the memory used by the AccountDetails layout with the container.
+void RunMemoryBenchmark(size_t record_count) {
+  std::cout << "Memory footprint of " << record_count << " records"
+            << std::endl
+            << std::left << std::setw(20) << "layout" << std::right
+            << std::setw(14) << "live allocs" << std::setw(14) << "KiB"
+            << std::setw(12) << "load ms" << std::setw(14) << "teardown ms"
+            << std::endl;
+
+  PrintMeasurement("AccountDetails", MeasureAccountDetails(record_count));
+  PrintMeasurement("PasswordContainer", MeasurePasswordContainer(record_count));
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  return CountedAllocate(size);
+}
+
+void* operator new[](size_t size) {
+  return CountedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  CountedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  CountedFree(pointer);
+}
+
+// Runs the benchmark named in the first argument (every benchmark if there is
+// no argument) with the number of records in the second argument.
+// Measures how long scoring every password's strength takes on one thread and
+// on every hardware thread, and how long it takes once the scores are cached
+// and after a password changes.
+void RunStrengthBenchmark(size_t record_count) {
+  std::cout << "Password strength scoring over " << record_count << " records"
+            << std::endl
+            << std::left << std::setw(16) << "scoring" << std::right
+            << std::setw(12) << "weak" << std::setw(16) << "ms" << std::endl;
+
+  const std::vector<std::pair<string, size_t>> thread_counts = {
+      {"1 thread", 1}, {"all threads", 0}};
+  for (const std::pair<string, size_t>& thread_count : thread_counts) {
+    PasswordContainer container = CreateLargeContainer(record_count);
+    container.SetCryptographerParallelism(thread_count.second, 1 << 20);
+
+    // Counts the weak passwords so the scores are used
+    auto count_weak = [](const std::vector<PasswordStrength>& strengths) {
+      size_t weak_count = 0;
+      for (const PasswordStrength& strength : strengths) {
+        weak_count += strength.rating < PasswordStrength::kFair;
+      }
+      return weak_count;
+    };
+
+    auto start_time = std::chrono::steady_clock::now();
+    size_t weak_count = count_weak(container.ScorePasswords());
+    std::cout << std::fixed << std::setprecision(2) << std::left
+              << std::setw(16) << thread_count.first << std::right
+              << std::setw(12) << weak_count << std::setw(16)
+              << GetMillisecondsSince(start_time) << std::endl;
+
+    if (thread_count.second != 0) {
+      continue;
+    }
+
+    start_time = std::chrono::steady_clock::now();
+    weak_count = count_weak(container.ScorePasswords());
+    std::cout << std::left << std::setw(16) << "cached" << std::right
+              << std::setw(12) << weak_count << std::setw(16)
+              << GetMillisecondsSince(start_time) << std::endl;
+
+    // Only the changed password is scored again
+    container.ModifyAccount(GenerateAccountName(0), GenerateUsername(0),
+                            GeneratePassword(1));
+    start_time = std::chrono::steady_clock::now();
+    weak_count = count_weak(container.ScorePasswords());
+    std::cout << std::left << std::setw(16) << "after a change" << std::right
+              << std::setw(12) << weak_count << std::setw(16)
+              << GetMillisecondsSince(start_time) << std::endl;
+  }
+}
+
+// Measures how long importing a CSV export of record_count accounts into an
+// empty container takes on one thread and on every hardware thread.
+void RunImportBenchmark(size_t record_count) {
+  // Quotes every field like browsers do, so the parser has to unquote them
+  string csv_text = "\"name\",\"url\",\"username\",\"password\"\n";
+  for (size_t index = 0; index < record_count; index++) {
+    csv_text += "\"" + GenerateAccountName(index) + "\",\"https://example.com/";
+    csv_text += std::to_string(index) + "\",\"" + GenerateUsername(index) +
+                "\",\"" + GeneratePassword(index) + "\"\n";
+  }
+
+  std::cout << "CSV import of " << record_count << " records ("
+            << csv_text.size() / (1 << 20) << " MB)" << std::endl
+            << std::left << std::setw(16) << "import" << std::right
+            << std::setw(12) << "imported" << std::setw(16) << "ms"
+            << std::endl;
+
+  const std::vector<std::pair<string, size_t>> thread_counts = {
+      {"1 thread", 1}, {"all threads", 0}};
+  for (const std::pair<string, size_t>& thread_count : thread_counts) {
+    PasswordContainer container(kContainerOffset, kContainerKey);
+    std::istringstream csv_input(csv_text);
+
+    auto start_time = std::chrono::steady_clock::now();
+    ImportReport report =
+        CsvImporter(thread_count.second).Import(csv_input, container);
+    std::cout << std::fixed << std::setprecision(2) << std::left
+              << std::setw(16) << thread_count.first << std::right
+              << std::setw(12) << report.imported_count << std::setw(16)
+              << GetMillisecondsSince(start_time) << std::endl;
+  }
+}
+
+// Measures how long exporting record_count accounts to a JSON file, parsing it
+// without keeping anything, and importing it take, and how much heap each one
+// uses on top of what was already in use.
+void RunJsonBenchmark(size_t record_count) {
+  std::cout << "JSON export and import of " << record_count << " records"
+            << std::endl
+            << std::left << std::setw(16) << "step" << std::right
+            << std::setw(16) << "extra heap KB" << std::setw(16) << "ms"
+            << std::endl;
+
+  // Prints the time since start_time and the heap used on top of start_bytes
+  auto print_step = [](const string& step,
+                       std::chrono::steady_clock::time_point start_time,
+                       size_t start_bytes) {
+    double milliseconds = GetMillisecondsSince(start_time);
+    std::cout << std::fixed << std::setprecision(2) << std::left
+              << std::setw(16) << step << std::right << std::setw(16)
+              << (peak_heap_bytes - start_bytes) / 1024 << std::setw(16)
+              << milliseconds << std::endl;
+  };
+
+  {
+    PasswordContainer container = CreateLargeContainer(record_count);
+    std::ofstream output(kJsonExportPath, std::ios::binary);
+    size_t start_bytes = peak_heap_bytes = live_heap_bytes.load();
+    auto start_time = std::chrono::steady_clock::now();
+    JsonExporter::Export(container, output);
+    print_step("export", start_time, start_bytes);
+  }
+
+  {
+    std::ifstream input(kJsonExportPath, std::ios::binary);
+    JsonReader reader(input);
+    JsonHandler handler;
+    size_t start_bytes = peak_heap_bytes = live_heap_bytes.load();
+    auto start_time = std::chrono::steady_clock::now();
+    reader.Parse(handler);
+    print_step("parse only", start_time, start_bytes);
+  }
+
+  {
+    std::ifstream input(kJsonExportPath, std::ios::binary);
+    PasswordContainer container(kContainerOffset, kContainerKey);
+    size_t start_bytes = peak_heap_bytes = live_heap_bytes.load();
+    auto start_time = std::chrono::steady_clock::now();
+    JsonImporter::Import(input, container);
+    print_step("import", start_time, start_bytes);
+  }
+
+  std::remove(kJsonExportPath.c_str());
+}
+
+// Measures how long applying up to kBatchChangeCount changes to record_count
+// accounts takes one at a time and as one committed batch, including the work
+// left for the next listing and search.
+void RunBatchBenchmark(size_t record_count) {
+  // Deletes and modifies accounts spread over the whole container and adds
+  // new ones after them
+  AccountBatch batch;
+  size_t step_count = std::min(kBatchChangeCount / 3, record_count / 2);
+  size_t stride = std::max<size_t>(record_count / (2 * step_count + 1), 1);
+  for (size_t step = 0; step < step_count; step++) {
+    size_t index = 2 * step * stride;
+    batch.DeleteAccount(GenerateAccountName(index));
+    batch.ModifyAccount(GenerateAccountName(index + stride), "batch-user",
+                        GeneratePassword(index + 1));
+    batch.AddAccount(GenerateAccountName(record_count + step), "batch-user",
+                     GeneratePassword(step));
+  }
+
+  std::cout << batch.GetSize() << " changes to " << record_count
+            << " records" << std::endl
+            << std::left << std::setw(16) << "applied" << std::right
+            << std::setw(12) << "accounts" << std::setw(16) << "ms"
+            << std::endl;
+
+  {
+    PasswordContainer container = CreateLargeContainer(record_count);
+    auto start_time = std::chrono::steady_clock::now();
+    for (const AccountBatch::Operation& operation : batch.GetOperations()) {
+      if (operation.type == AccountBatch::kAdd) {
+        container.AddAccount(operation.account_name, operation.username,
+                             operation.password);
+      } else if (operation.type == AccountBatch::kModify) {
+        container.ModifyAccount(operation.account_name, operation.username,
+                                operation.password);
+      } else {
+        container.DeleteAccount(operation.account_name);
+      }
+    }
+    container.GetAccountNames();
+    container.SearchAccounts(GenerateAccountName(0));
+    std::cout << std::fixed << std::setprecision(2) << std::left
+              << std::setw(16) << "one at a time" << std::right
+              << std::setw(12) << container.GetAccountCount() << std::setw(16)
+              << GetMillisecondsSince(start_time) << std::endl;
+  }
+
+  {
+    PasswordContainer container = CreateLargeContainer(record_count);
+    auto start_time = std::chrono::steady_clock::now();
+    container.CommitBatch(batch);
+    container.GetAccountNames();
+    container.SearchAccounts(GenerateAccountName(0));
+    std::cout << std::fixed << std::setprecision(2) << std::left
+              << std::setw(16) << "one batch" << std::right << std::setw(12)
+              << container.GetAccountCount() << std::setw(16)
+              << GetMillisecondsSince(start_time) << std::endl;
+  }
+}
+
+// Simulates one frame of the account list and details windows, which read
+// the listed names around the selected row and the selected account's
+// details.
+void SimulateFrame(AccountListViewModel& list_view_model,
+                   AccountDetailsViewModel& details_view_model) {
+  list_view_model.Update();
+  const std::vector<string>& listed_names = list_view_model.GetListedNames();
+  int selected_row = list_view_model.GetSelectedRow();
+
+  size_t first_row = selected_row == AccountListViewModel::kNoRow
+                         ? 0
+                         : static_cast<size_t>(selected_row);
+  size_t last_row = std::min(first_row + kVisibleRowCount,
+                             listed_names.size());
+  for (size_t row = first_row; row < last_row; row++) {
+    scan_result += listed_names[row].size();
+  }
+
+  if (details_view_model.Update()) {
+    scan_result += details_view_model.GetAccount().password.size();
+  }
+}
+
+// Measures the time and allocations per frame of the GUI's view models over
+// record_count accounts while idle, moving the selection, typing a search,
+// and deleting the selected account.
+void RunFrameBenchmark(size_t record_count) {
+  std::cout << kSimulatedFrameCount << " frames over " << record_count
+            << " records" << std::endl
+            << std::left << std::setw(16) << "scenario" << std::right
+            << std::setw(16) << "ms/frame" << std::setw(16)
+            << "allocs/frame" << std::endl;
+
+  const string kScenarios[] = {"idle", "select", "search", "delete"};
+  string search_name = GenerateAccountName(record_count / 2);
+
+  for (const string& scenario : kScenarios) {
+    PasswordContainer container = CreateLargeContainer(record_count);
+    PasswordContainer::AccountHandle selected_account;
+    AccountListViewModel list_view_model(container, selected_account);
+    AccountDetailsViewModel details_view_model(container, selected_account);
+    list_view_model.SelectRow(0);
+    SimulateFrame(list_view_model, details_view_model);
+
+    size_t start_allocations = allocation_count;
+    auto start_time = std::chrono::steady_clock::now();
+    for (size_t frame = 0; frame < kSimulatedFrameCount; frame++) {
+      size_t listed_count = list_view_model.GetListedNames().size();
+      if (scenario == "select" && listed_count > 0) {
+        list_view_model.SelectRow(static_cast<int>(frame % listed_count));
+      } else if (scenario == "search") {
+        // Types the name one character a frame and then starts over
+        list_view_model.SetSearchQuery(
+            search_name.substr(0, frame % search_name.size() + 1));
+      } else if (scenario == "delete" && listed_count > 0) {
+        list_view_model.SelectRow(0);
+        list_view_model.RequestDelete();
+      }
+
+      SimulateFrame(list_view_model, details_view_model);
+    }
+
+    double elapsed_milliseconds = GetMillisecondsSince(start_time);
+    size_t allocations = allocation_count - start_allocations;
+    std::cout << std::fixed << std::setprecision(4) << std::left
+              << std::setw(16) << scenario << std::right << std::setw(16)
+              << elapsed_milliseconds / kSimulatedFrameCount
+              << std::setprecision(2) << std::setw(16)
+              << static_cast<double>(allocations) / kSimulatedFrameCount
+              << std::endl;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  string benchmark = argc > 1 ? argv[1] : "";
+  size_t record_count = kDefaultRecordCount;
+
+  if (argc > 2) {
+    record_count = static_cast<size_t>(std::strtoull(argv[2], nullptr, 10));
+  }
+
+  bool is_known_benchmark = false;
+
+  if (benchmark.empty() || benchmark == kMemoryBenchmark) {
+    RunMemoryBenchmark(record_count);
+    is_known_benchmark = true;
+  }
+
+  if (benchmark.empty() || benchmark == kScanBenchmark) {
+    RunScanBenchmark(record_count);
+    is_known_benchmark = true;
+  }
+
+  if (benchmark.empty() || benchmark == kSearchBenchmark) {
+    RunSearchBenchmark(record_count);
+    is_known_benchmark = true;
+  }
+
+  if (benchmark.empty() || benchmark == kFuzzyBenchmark) {
+    RunFuzzyBenchmark(record_count);
+    is_known_benchmark = true;
+  }
+
+  if (benchmark.empty() || benchmark == kReuseBenchmark) {
+    RunReuseBenchmark(record_count);
+    is_known_benchmark = true;
+  }
+
+  if (benchmark.empty() || benchmark == kBreachBenchmark) {
+    RunBreachBenchmark(record_count);
+    is_known_benchmark = true;
+  }
+
+  if (benchmark.empty() || benchmark == kStrengthBenchmark) {
+    RunStrengthBenchmark(record_count);
+    is_known_benchmark = true;
+  }
+
+  if (benchmark.empty() || benchmark == kImportBenchmark) {
+    RunImportBenchmark(record_count);
+    is_known_benchmark = true;
+  }
+
+  if (benchmark.empty() || benchmark == kJsonBenchmark) {
+    RunJsonBenchmark(record_count);
+    is_known_benchmark = true;
+  }
+
+  if (benchmark.empty() || benchmark == kBatchBenchmark) {
+    RunBatchBenchmark(record_count);
+    is_known_benchmark = true;
+  }
+
+  if (benchmark.empty() || benchmark == kFrameBenchmark) {
+    RunFrameBenchmark(record_count);
+    is_known_benchmark = true;
+  }
+
+  if (!is_known_benchmark) {
+    std::cout << "Unknown benchmark! Available benchmarks: "
+              << kMemoryBenchmark << ", " << kScanBenchmark << ", "
+              << kSearchBenchmark << ", " << kFuzzyBenchmark << ", "
+              << kReuseBenchmark << ", " << kBreachBenchmark << ", "
+              << kStrengthBenchmark << ", " << kImportBenchmark << ", "
+              << kJsonBenchmark << ", " << kBatchBenchmark << ", "
+              << kFrameBenchmark << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -2,8 +2,12 @@
 #define CLI_COMMAND_LINE_INPUT_H
 
 #include <iostream>
+#include <memory>
 #include <string>
 
+#include "core/account_batch.h"
+#include "core/audit/breached_password_checker.h"
+#include "core/io/import_report.h"
 #include "core/password_container.h"
 
 namespace passwordcontainer {
@@ -47,6 +51,29 @@ class CommandLineInput {
  private:
   const size_t kDefaultOffset = 100;
 
+  // The number of threads used to encrypt/decrypt large containers (0 uses
+  // every hardware thread) and the number of encrypted characters the data
+  // needs before it is split across those threads
+  const size_t kEncryptionThreadCount = 0;
+  const size_t kParallelEncryptionThreshold = 1 << 20;
+
+  // The most names suggested for a mistyped account name and the most
+  // characters a suggestion can differ by
+  const size_t kMaxSuggestions = 3;
+  const size_t kMaxSuggestionDistance = 2;
+
+  // The Bloom filter of a breached password list is saved next to the list
+  // with this extension, built for this false positive rate
+  const std::string kBloomFilterExtension = ".bloom";
+  const double kBloomFilterFalsePositiveRate = 0.001;
+
+  // The most passwords generated to find one that isn't in the breached
+  // password list
+  const size_t kMaxPasswordAttempts = 10;
+
+  // The most rows that couldn't be imported that are listed one by one
+  const size_t kMaxListedImportErrors = 20;
+
   // The input and output streams for the user input.
   std::istream& user_input_;
   std::ostream& user_output_;
@@ -57,14 +84,36 @@ class CommandLineInput {
   // The container used to store the data.
   PasswordContainer* container_ = nullptr;
 
+  // The breached password list of the last breach audit, which generated
+  // passwords are also checked against. Null until a list is audited against.
+  std::shared_ptr<BreachedPasswordChecker> breach_checker_;
+
+  // The changes staged since the user began a batch, which are only applied
+  // to the container when the batch is committed. Null when no batch is open.
+  std::shared_ptr<AccountBatch> batch_;
+
   // Constants for the many possible user commands
   const std::string kAddCommand = "add";
   const std::string kDeleteCommand = "delete";
   const std::string kModifyCommand = "modify";
   const std::string kListCommand = "list accounts";
   const std::string kShowDetailsCommand = "show details";
+  const std::string kSearchCommand = "search";
+  const std::string kAccountsForUserCommand = "accounts for user";
+  const std::string kAuditReuseCommand = "audit reuse";
+  const std::string kAuditBreachesCommand = "audit breaches";
+  const std::string kAuditStrengthCommand = "audit strength";
+  const std::string kImportCsvCommand = "import csv";
+  const std::string kImportJsonCommand = "import json";
+  const std::string kExportJsonCommand = "export json";
   const std::string kGeneratePassCommand = "generate password";
   const std::string kKeyChangeCommand = "change key";
+  const std::string kRekeyCommand = "rekey";
+  const std::string kCalibrateCommand = "calibrate kdf";
+  const std::string kPoolUsernamesCommand = "pool usernames";
+  const std::string kBeginBatchCommand = "begin batch";
+  const std::string kCommitBatchCommand = "commit batch";
+  const std::string kCancelBatchCommand = "cancel batch";
   const std::string kSaveCommand = "save";
   const std::string kQuitCommand = "quit";
 
@@ -84,28 +133,98 @@ class CommandLineInput {
   // action stated in the command.
   void ParseCommand(const std::string& command);
 
-  // Adds the account by asking the user for the required data.
+  // Adds the account by asking the user for the required data. Stages the
+  // account instead if a batch is open.
   void AddSpecifiedAccount();
 
-  // Deletes the account by asking the user for the required data.
+  // Deletes the account by asking the user for the required data. Stages the
+  // deletion instead if a batch is open.
   void DeleteSpecifiedAccount();
 
   // Modifies the account that is found by asking the user for the required
-  // data.
+  // data. Stages the change instead if a batch is open.
   void ModifySpecifiedAccount();
 
+  // Opens a batch that the following adds, deletes, and modifications are
+  // staged in until it is committed or canceled.
+  void BeginBatch();
+
+  // Applies every change staged in the open batch at once, or none of them if
+  // any is invalid, and closes the batch.
+  void CommitBatch();
+
+  // Closes the open batch without applying any of its changes.
+  void CancelBatch();
+
   // Displays all the accounts in the container.
   void ListAccounts();
 
-  // Shows the username and password for the requested account
+  // Lists the accounts whose names start with or contain the text passed in
+  // by the user.
+  void SearchAccounts();
+
+  // Lists the accounts that use the username passed in by the user.
+  void ListAccountsForUsername();
+
+  // Lists the groups of accounts that share a password and how long finding
+  // them took.
+  void AuditPasswordReuse();
+
+  // Checks every password against the breached password list at the location
+  // passed in by the user, building a Bloom filter for the list if it doesn't
+  // have one yet. Lists the breached accounts and how long the check took.
+  void AuditBreachedPasswords();
+
+  // Scores the strength of every password and lists the accounts with weak
+  // ones, with how long the scoring took.
+  void AuditPasswordStrength();
+
+  // Imports the accounts in the CSV file at the location passed in by the
+  // user and lists the rows that couldn't be imported with their line
+  // numbers.
+  void ImportCsvFile();
+
+  // Imports the accounts in the JSON file at the location passed in by the
+  // user and lists the accounts that couldn't be imported with their line
+  // numbers.
+  void ImportJsonFile();
+
+  // Writes every account as unencrypted JSON to the location passed in by the
+  // user.
+  void ExportJsonFile();
+
+  // Lists the first accounts in report that couldn't be imported and how many
+  // were imported in elapsed_milliseconds.
+  void ShowImportReport(const ImportReport& report,
+                        long long elapsed_milliseconds);
+
+  // Shows the username, password, and password strength for the requested
+  // account
   void ShowAccountDetails();
 
   // Changes the key in the container to the value passed in by the user.
   void ChangeContainerKey();
 
-  // Generates a random password with the size of the value passed in by user.
+  // Re-encrypts the save file with the new key passed in by the user and
+  // changes the key in the container to it. Shows the progress while the file
+  // is being rekeyed.
+  void RekeyContainerFile();
+
+  // Sets the key stretching iterations so unlocking takes about the number of
+  // milliseconds passed in by the user.
+  void CalibrateKeyStretching();
+
+  // Turns saving every distinct username only once on or off.
+  void ToggleUsernamePooling();
+
+  // Generates a random password with the size of the value passed in by user
+  // that isn't in the breached password list if one was loaded.
   void GeneratePassword();
 
+  // Indicates that there is no account with the passed in account_name and
+  // suggests the closest account names if there are any.
+  void IndicateMissingAccount(const std::string& account_name);
+
   // Indicates that the inputted command was invalid.
   void IndicateInvalidCommand();
 
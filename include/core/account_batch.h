@@ -0,0 +1,52 @@
+#ifndef CORE_ACCOUNT_BATCH_H
+#define CORE_ACCOUNT_BATCH_H
+
+#include <string>
+#include <vector>
+
+namespace passwordcontainer {
+
+// A list of account changes that PasswordContainer::CommitBatch applies
+// together. Staging a change doesn't check it against anything; the whole
+// batch is checked when it is committed, and either every change is applied
+// or none are.
+class AccountBatch {
+ public:
+  enum OperationType { kAdd, kModify, kDelete };
+
+  // One staged change. Deletes only use account_name.
+  struct Operation {
+    OperationType type;
+    std::string account_name;
+    std::string username;
+    std::string password;
+  };
+
+  // Stages adding an account with the passed in details.
+  void AddAccount(const std::string& account_name, const std::string& username,
+                  const std::string& password);
+
+  // Stages changing the username and password of the account with the passed
+  // in account_name.
+  void ModifyAccount(const std::string& account_name,
+                     const std::string& username, const std::string& password);
+
+  // Stages deleting the account with the passed in account_name.
+  void DeleteAccount(const std::string& account_name);
+
+  // Returns the staged changes in the order they were staged.
+  const std::vector<Operation>& GetOperations() const;
+
+  // Returns the number of staged changes.
+  size_t GetSize() const;
+
+  // Drops every staged change.
+  void Clear();
+
+ private:
+  std::vector<Operation> operations_;
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_ACCOUNT_BATCH_H
@@ -0,0 +1,78 @@
+#ifndef CORE_AUDIT_BLOOM_FILTER_H
+#define CORE_AUDIT_BLOOM_FILTER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/storage/memory_mapped_file.h"
+
+namespace passwordcontainer {
+
+// A Bloom filter over hash digests: a bit array that answers "definitely not
+// added" or "probably added" using hash_count bits per digest. Digests are
+// already uniformly random, so the bits are picked straight from their bytes
+// instead of hashing them again.
+//
+// Filters can be saved to a file and opened again, in which case the file is
+// memory mapped instead of loaded.
+class BloomFilter {
+ public:
+  // The smallest number of bytes a digest can have
+  static const size_t kMinimumDigestLength = 16;
+
+  // Creates a new empty filter with bit_count bits that sets hash_count bits
+  // for every digest. Throws an invalid_argument exception if either is 0.
+  BloomFilter(size_t bit_count, size_t hash_count);
+
+  // Opens the filter saved at file_path. Throws an invalid_argument exception
+  // if the file can't be read or isn't a saved filter.
+  explicit BloomFilter(const std::string& file_path);
+
+  // Returns the number of bits a filter needs to hold item_count digests with
+  // the passed in false_positive_rate, and the best number of bits to set per
+  // digest for a filter that size.
+  static size_t GetOptimalBitCount(size_t item_count,
+                                   double false_positive_rate);
+  static size_t GetOptimalHashCount(size_t bit_count, size_t item_count);
+
+  // Adds the passed in digest to the filter. Throws an invalid_argument
+  // exception if the digest is shorter than kMinimumDigestLength or the filter
+  // was opened from a file.
+  void Add(const std::string& digest);
+
+  // Returns false if the passed in digest was definitely never added and true
+  // if it probably was. Throws an invalid_argument exception if the digest is
+  // shorter than kMinimumDigestLength.
+  bool MightContain(const std::string& digest) const;
+
+  // Saves the filter to file_path. Throws an invalid_argument exception if the
+  // file can't be written.
+  void Save(const std::string& file_path) const;
+
+  size_t GetBitCount() const;
+  size_t GetHashCount() const;
+
+ private:
+  size_t bit_count_;
+  size_t hash_count_;
+
+  // The bits of a filter that was created in memory
+  std::vector<unsigned char> bits_;
+
+  // The file of a filter that was opened, which holds the bits after its
+  // header
+  std::unique_ptr<MemoryMappedFile> file_;
+
+  // The first byte of the bits, in bits_ or in file_
+  const unsigned char* data_ = nullptr;
+
+  // Calls visit with the position of every bit of the passed in digest until
+  // visit returns false. Returns false if visit did.
+  template <typename Visitor>
+  bool ForEachBit(const std::string& digest, Visitor visit) const;
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_AUDIT_BLOOM_FILTER_H
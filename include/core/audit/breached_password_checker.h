@@ -0,0 +1,65 @@
+#ifndef CORE_AUDIT_BREACHED_PASSWORD_CHECKER_H
+#define CORE_AUDIT_BREACHED_PASSWORD_CHECKER_H
+
+#include <memory>
+#include <string>
+
+#include "core/audit/bloom_filter.h"
+#include "core/storage/memory_mapped_file.h"
+
+namespace passwordcontainer {
+
+// Checks passwords against a local list of breached password hashes without
+// sending them anywhere. The list is a text file with one upper or lower case
+// hex SHA-1 hash per line, optionally followed by ":" and the number of times
+// it was seen, sorted by hash (the format breached password lists are
+// downloaded in).
+//
+// The file is memory mapped and searched with an interpolation search: hashes
+// are uniformly random, so the position of a hash in the file can be guessed
+// from its value, which finds it in a few page reads even in a file of tens of
+// GB. A Bloom filter built from the file can be put in front so that most
+// passwords that aren't in the list never touch the file at all.
+class BreachedPasswordChecker {
+ public:
+  // Opens the list of hashes at corpus_path and the Bloom filter saved at
+  // bloom_filter_path, if it isn't empty. Throws an invalid_argument exception
+  // if either file can't be opened.
+  explicit BreachedPasswordChecker(const std::string& corpus_path,
+                                   const std::string& bloom_filter_path = "");
+
+  // Returns whether the passed in password is in the list.
+  bool IsBreached(const std::string& password) const;
+
+  // Returns the number of times the passed in password was seen in breaches,
+  // 1 if its line has no count, or 0 if it isn't in the list. Throws an
+  // invalid_argument exception if a line that is read is malformed.
+  size_t GetBreachCount(const std::string& password) const;
+
+  // Returns whether a Bloom filter is in front of the list.
+  bool HasBloomFilter() const;
+
+  // Builds a Bloom filter for the list at corpus_path with the passed in
+  // false_positive_rate and saves it to bloom_filter_path. Throws an
+  // invalid_argument exception if a file can't be read or written or a line
+  // of the list is malformed.
+  static void BuildBloomFilter(const std::string& corpus_path,
+                               const std::string& bloom_filter_path,
+                               double false_positive_rate);
+
+ private:
+  // The number of bytes left in the search range at which the lines are just
+  // read one after another
+  static const size_t kLinearSearchBytes = 4096;
+
+  MemoryMappedFile corpus_;
+  std::unique_ptr<BloomFilter> bloom_filter_;
+
+  // Returns the number of times the password with the passed in SHA-1 digest
+  // was seen, or 0 if it isn't in the list.
+  size_t FindDigest(const std::string& digest) const;
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_AUDIT_BREACHED_PASSWORD_CHECKER_H
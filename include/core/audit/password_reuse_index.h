@@ -0,0 +1,85 @@
+#ifndef CORE_AUDIT_PASSWORD_REUSE_INDEX_H
+#define CORE_AUDIT_PASSWORD_REUSE_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/encryption/key_derivation.h"
+
+namespace passwordcontainer {
+
+// Finds the accounts that share a password. Every password is hashed with
+// HMAC-SHA256 under a random key made for the index, and the accounts are
+// grouped by the hashes, so the index never holds a password and its hashes
+// can't be checked against a list of common passwords. The key only lives in
+// memory, so hashes from different indexes can't be compared either.
+class PasswordReuseIndex {
+ public:
+  // The number of bytes in the random key
+  static const size_t kKeyLength = 32;
+
+  // Creates a new empty index with a new random key.
+  PasswordReuseIndex();
+
+  // Replaces everything in the index with the passed in accounts, hashing the
+  // passwords on thread_count threads (0 uses every hardware thread). Throws
+  // an invalid_argument exception if the two vectors have different sizes.
+  void Build(const std::vector<std::string>& account_names,
+             const std::vector<std::string>& passwords, size_t thread_count);
+
+  // Adds the account with the passed in account_name and password.
+  void Add(const std::string& account_name, const std::string& password);
+
+  // Removes the account with the passed in account_name and password. Throws an
+  // invalid_argument exception if the account isn't in the index with that
+  // password.
+  void Remove(const std::string& account_name, const std::string& password);
+
+  // Returns the names of the accounts in every group of two or more accounts
+  // that share a password. Names in a group are sorted and the largest groups
+  // come first.
+  std::vector<std::vector<std::string>> GetReuseGroups() const;
+
+  // Removes every account from the index.
+  void Clear();
+
+ private:
+  // The first 16 bytes of the HMAC of a password, which make an accidental
+  // collision between two different passwords practically impossible. Kept as
+  // two ints so the hash table doesn't allocate a string for every password.
+  struct Digest {
+    uint64_t high;
+    uint64_t low;
+
+    bool operator==(const Digest& other) const;
+  };
+
+  struct DigestHash {
+    size_t operator()(const Digest& digest) const;
+  };
+
+  // Hashes every password with the random key
+  keyderivation::HmacContext hmac_;
+
+  // The names of the accounts that use every password, by the password's hash
+  std::unordered_map<Digest, std::vector<std::string>, DigestHash>
+      accounts_by_digest_;
+
+  // The hashes used by more than one account, so listing the groups doesn't
+  // have to look at every password
+  std::unordered_set<Digest, DigestHash> reused_digests_;
+
+  // Returns the hash of the passed in password.
+  Digest HashPassword(const std::string& password) const;
+
+  // Adds the account with the passed in account_name to the accounts that use
+  // the password with the passed in digest.
+  void AddDigest(const Digest& digest, const std::string& account_name);
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_AUDIT_PASSWORD_REUSE_INDEX_H
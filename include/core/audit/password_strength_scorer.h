@@ -0,0 +1,80 @@
+#ifndef CORE_AUDIT_PASSWORD_STRENGTH_SCORER_H
+#define CORE_AUDIT_PASSWORD_STRENGTH_SCORER_H
+
+#include <string>
+#include <vector>
+
+#include "core/audit/word_trie.h"
+
+namespace passwordcontainer {
+
+// How hard a password is to guess, as estimated by PasswordStrengthScorer.
+struct PasswordStrength {
+  enum Rating { kVeryWeak, kWeak, kFair, kStrong, kVeryStrong };
+
+  // The estimated number of guesses needed, as a power of two
+  double entropy_bits = 0;
+
+  // How many of lowercase letters, uppercase letters, digits and symbols the
+  // password uses
+  size_t character_class_count = 0;
+
+  // The number of dictionary words, repeats and sequences found in it
+  size_t pattern_count = 0;
+
+  Rating rating = kVeryWeak;
+};
+
+// Estimates the strength of passwords. A password is split into dictionary
+// words (also with common letter substitutions like "p@55w0rd"), runs of a
+// repeated character or of a sequence like "abc" or "321", and the other
+// characters. A word costs as many bits as it takes to pick it from the
+// dictionary, a run as much as its first character and its length, and every
+// other character as much as picking it from the character classes used.
+class PasswordStrengthScorer {
+ public:
+  // The shortest word or run that counts as a pattern
+  static const size_t kMinPatternLength = 3;
+
+  // Creates a scorer whose dictionary has a short built in list of the most
+  // common passwords and words in them.
+  PasswordStrengthScorer();
+
+  // Adds every word in the file at file_path, one per line, to the dictionary.
+  // Words are matched ignoring case and words shorter than kMinPatternLength
+  // are skipped. Throws an invalid_argument exception if the file can't be
+  // opened.
+  void LoadWordList(const std::string& file_path);
+
+  // Returns the strength of the passed in password.
+  PasswordStrength Score(const std::string& password) const;
+
+  // Returns the strength of every password, scoring them on thread_count
+  // threads (0 uses every hardware thread).
+  std::vector<PasswordStrength> ScoreAll(
+      const std::vector<std::string>& passwords, size_t thread_count) const;
+
+  // Returns the name of the passed in rating, like "Very weak".
+  static std::string GetRatingName(PasswordStrength::Rating rating);
+
+  // Returns the rating and whole bits of entropy of the passed in strength,
+  // like "Weak, 30 bits".
+  static std::string Describe(const PasswordStrength& strength);
+
+ private:
+  // The number of passwords scored by one task of a parallel batch
+  static const size_t kPasswordsPerTask = 2048;
+
+  // The lowest entropies for every rating above kVeryWeak
+  static const double kWeakBits;
+  static const double kFairBits;
+  static const double kStrongBits;
+  static const double kVeryStrongBits;
+
+  // Every dictionary word in lowercase without substitutions
+  WordTrie dictionary_;
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_AUDIT_PASSWORD_STRENGTH_SCORER_H
@@ -0,0 +1,50 @@
+#ifndef CORE_AUDIT_WORD_TRIE_H
+#define CORE_AUDIT_WORD_TRIE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace passwordcontainer {
+
+// A set of words stored as a trie, for finding the words that start at some
+// position of a string without trying every word. Every node is 12 bytes in
+// one vector and points at its first child and next sibling by index, so a
+// large word list takes a few allocations and shares its common prefixes.
+class WordTrie {
+ public:
+  WordTrie();
+
+  // Adds the passed in word. Empty words are ignored.
+  void Insert(const std::string& word);
+
+  // Returns the length of the longest word that text has at the passed in
+  // position, or 0 if no word starts there.
+  size_t FindLongestWord(const std::string& text, size_t position) const;
+
+  // Returns the number of distinct words in the trie.
+  size_t GetWordCount() const;
+
+ private:
+  // Marks nodes that have no child or no next sibling
+  static const uint32_t kNoNode = static_cast<uint32_t>(-1);
+
+  struct Node {
+    uint32_t first_child;
+    uint32_t next_sibling;
+    char character;
+    bool is_word_end;
+  };
+
+  // Every node, with the root (which has no character) first
+  std::vector<Node> nodes_;
+  size_t word_count_ = 0;
+
+  // Returns the child of the node at parent with the passed in character, or
+  // kNoNode if there isn't one.
+  uint32_t FindChild(uint32_t parent, char character) const;
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_AUDIT_WORD_TRIE_H
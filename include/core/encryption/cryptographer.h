@@ -1,13 +1,21 @@
 #ifndef CORE_CRYPTOGRAPHER_H
 #define CORE_CRYPTOGRAPHER_H
 
+#include <atomic>
 #include <iostream>
+#include <memory>
+
+#include "core/thread_pool.h"
 
 namespace passwordcontainer {
 
 class Cryptographer {
  public:
   Cryptographer(size_t offset, const std::string& key);
+  Cryptographer(const Cryptographer& other) = default;
+
+  // Wipes the key so it isn't left in freed memory.
+  ~Cryptographer();
 
   // Encrypts the string that is passed in using the character_offset_ and key_.
   std::string EncryptString(const std::string& str) const;
@@ -15,23 +23,51 @@ class Cryptographer {
   // Decrypts the string that is passed in using the character_offset_ and key_.
   std::string DecryptString(const std::string& str) const;
 
-  // Sets the key to the passed in value. Throws an invalid_argument exception
-  // if the passed in key is empty.
+  // Sets the key to the passed in value, wiping the old key. Throws an
+  // invalid_argument exception if the passed in key is empty.
   void SetKey(const std::string& new_key);
 
-  // Gets the key.
+  // Gets the key. The returned copy isn't wiped by the Cryptographer.
   std::string GetKey() const;
 
   // Sets the character_offset to the passed in value. Throws an
   // invalid_argument exception if offset is lower than the minimum offset.
   void SetOffset(size_t offset);
 
+  // Lets EncryptString and DecryptString split their work across thread_count
+  // threads once the string being processed has at least serial_threshold
+  // characters. Smaller strings are always processed on the calling thread. A
+  // thread_count of 1 turns parallel processing off and a thread_count of 0
+  // uses every hardware thread. The output is the same as the serial output.
+  void SetParallelism(size_t thread_count, size_t serial_threshold);
+
+  // Returns a value that identifies the current key and character offset
+  // without revealing them. Stored with encrypted data so a wrong key can be
+  // detected before decrypting.
+  std::string CalculateKeyCheck() const;
+
+  // Returns true if the passed in key_check was calculated with the current key
+  // and character offset. Takes the same time no matter where the values
+  // differ.
+  bool MatchesKeyCheck(const std::string& key_check) const;
+
+  // Swaps the keys, offsets, and parallelism of the passed in cryptographers.
+  friend void swap(Cryptographer& first, Cryptographer& second);
+
  private:
   const size_t kMinimumCharacterOffset = 100;
 
   // The length that 1 encrypted character has in a file
   const size_t kEncryptedCharacterLength = 3;
 
+  // The number of encrypted characters decoded at a time before checking if
+  // another thread already found bad data
+  const size_t kDecryptBlockLength = 1 << 16;
+
+  // Added in front of the key when calculating the key check so the check is
+  // never the same as a hash of the key used anywhere else
+  const std::string kKeyCheckContext = "password-container key check";
+
   // The initial offset used to calculate the final offset. Must be at least
   // kMinimumCharacterOffset.
   size_t character_offset_;
@@ -39,12 +75,34 @@ class Cryptographer {
   // The key used to generate a new offset to decrypt/encrypt the data
   std::string key_;
 
+  // The pool used to encrypt/decrypt large strings. Null when parallel
+  // processing is turned off. Shared between copies of the cryptographer.
+  std::shared_ptr<ThreadPool> thread_pool_;
+
+  // The minimum number of characters a string needs for it to be processed in
+  // parallel
+  size_t serial_threshold_ = 0;
+
   // Calculates the real offset that is used for encryption using the current
   // character_offset_ and key_.
   size_t CalculateRealOffset() const;
 
-  // Finds out whether the passed in int represents a valid char or not
-  bool IsValidChar(int int_representation) const;
+  // Returns true if a string with the passed in length should be split across
+  // the thread pool.
+  bool ShouldRunInParallel(size_t length) const;
+
+  // Encrypts the characters of str in the range [begin, end) using the passed
+  // in offset.
+  std::string EncryptRange(const std::string& str, size_t begin, size_t end,
+                           size_t offset) const;
+
+  // Decrypts the encrypted characters with indices in the range [begin, end)
+  // of str using the passed in offset and writes them to output. Sets
+  // has_bad_data if a bad encrypted character is found and stops early if
+  // has_bad_data gets set by another thread.
+  void DecryptRange(const std::string& str, size_t begin, size_t end,
+                    size_t offset, char* output,
+                    std::atomic<bool>& has_bad_data) const;
 };
 
 }  // namespace passwordcontainer
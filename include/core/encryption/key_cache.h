@@ -0,0 +1,106 @@
+#ifndef CORE_ENCRYPTION_KEY_CACHE_H
+#define CORE_ENCRYPTION_KEY_CACHE_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+
+namespace passwordcontainer {
+
+// A process wide cache of keys derived with PBKDF2 so that deriving the same
+// key again (retrying a key, reopening a vault, or opening another vault with
+// the same key and salt) only takes a few microseconds.
+//
+// Entries are found by a keyed hash of the hashed key, salt, and iterations, so
+// neither the key nor its hash is stored. All entries live in memory that is
+// locked so it is never swapped to disk, and entries are overwritten with zeros
+// when they expire, are evicted, or the cache is cleared.
+//
+// Only the cache itself is locked. A key that is found is copied into ordinary
+// memory, where the caller wipes it once it is used. The Cryptographer keeps
+// the hex key it is given in ordinary memory too and wipes it when the key is
+// replaced or the Cryptographer is destroyed, but it can be swapped to disk
+// while in use. The key the user typed in and its hash aren't covered.
+class KeyCache {
+ public:
+  // The number of bytes of every cached key
+  static const size_t kKeyLength = 32;
+
+  // Returns the cache shared by the whole process.
+  static KeyCache& GetInstance();
+
+  KeyCache(const KeyCache&) = delete;
+  KeyCache& operator=(const KeyCache&) = delete;
+
+  // Looks for the key derived from the passed in hashed_key, salt, and
+  // iterations. Returns true and sets derived_key if it hasn't expired. The
+  // caller should wipe derived_key with keyderivation::WipeString once it is
+  // done with it.
+  bool Find(const std::string& hashed_key, const std::string& salt,
+            size_t iterations, std::string& derived_key);
+
+  // Stores the derived_key for the passed in hashed_key, salt, and iterations.
+  // Evicts the least recently used entry if the cache is full. Throws an
+  // invalid_argument exception if derived_key isn't kKeyLength bytes.
+  void Insert(const std::string& hashed_key, const std::string& salt,
+              size_t iterations, const std::string& derived_key);
+
+  // Sets how long an entry stays in the cache after it was last used. A time
+  // to live of 0 turns caching off.
+  void SetTimeToLive(std::chrono::seconds time_to_live);
+
+  // Zeroes and removes every entry.
+  void Clear();
+
+  // Returns the number of entries that haven't expired.
+  size_t GetSize();
+
+  // Returns true if the entries are in memory that could be locked.
+  bool IsMemoryLocked() const;
+
+ private:
+  // The number of keys that can be cached at once
+  static const size_t kCapacity = 16;
+
+  // One cached key. Plain data so that it can live in the locked memory.
+  struct Entry {
+    bool is_used;
+    // Keyed hash of the hashed key, salt, and iterations
+    unsigned char lookup_key[kKeyLength];
+    unsigned char derived_key[kKeyLength];
+    std::chrono::steady_clock::time_point last_used;
+  };
+
+  KeyCache();
+  ~KeyCache();
+
+  // The entries, stored in locked memory
+  Entry* entries_ = nullptr;
+  // The number of bytes allocated for entries_
+  size_t allocation_size_ = 0;
+  bool is_memory_locked_ = false;
+
+  // A random key for the lookup hash so lookup keys mean nothing outside this
+  // process
+  std::string lookup_secret_;
+
+  std::chrono::seconds time_to_live_;
+
+  // Guards all entries since every vault in the process shares the cache
+  std::mutex mutex_;
+
+  // Calculates the lookup key for the passed in parameters.
+  std::string CalculateLookupKey(const std::string& hashed_key,
+                                 const std::string& salt,
+                                 size_t iterations) const;
+
+  // Zeroes every entry that hasn't been used within time_to_live_.
+  void EvictExpiredEntries();
+
+  // Overwrites the passed in entry with zeros and marks it as unused.
+  static void ZeroEntry(Entry& entry);
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_ENCRYPTION_KEY_CACHE_H
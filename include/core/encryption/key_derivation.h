@@ -0,0 +1,82 @@
+#ifndef CORE_ENCRYPTION_KEY_DERIVATION_H
+#define CORE_ENCRYPTION_KEY_DERIVATION_H
+
+#include <chrono>
+#include <string>
+
+#include "core/encryption/sha256.h"
+
+namespace passwordcontainer {
+
+namespace keyderivation {
+
+// The number of bytes in a SHA-256 digest and in a derived key
+const size_t kDerivedKeyLength = 32;
+
+// The smallest number of PBKDF2 iterations CalibrateIterations will return
+const size_t kMinimumIterations = 1000;
+
+// The largest number of PBKDF2 iterations CalibrateIterations will return. A
+// key is still derived in a few seconds with this many iterations.
+const size_t kMaximumIterations = 10000000;
+
+// HMAC-SHA256 for one key with the padded key blocks already hashed. Copying
+// the two hash states for every message means each HMAC of a short message
+// only has to hash two blocks, which is what makes PBKDF2 fast. Also used to
+// hash many messages with the same key.
+class HmacContext {
+ public:
+  explicit HmacContext(const std::string& key);
+
+  // Writes the 32 byte HMAC of the passed in message to digest.
+  void Calculate(const unsigned char* message, size_t length,
+                 unsigned char* digest) const;
+
+ private:
+  SHA256 inner_;
+  SHA256 outer_;
+};
+
+// Calculates the HMAC-SHA256 of the passed in message using the passed in key.
+// Returns the raw 32 byte digest.
+std::string HmacSha256(const std::string& key, const std::string& message);
+
+// Derives a key from a password using PBKDF2 with HMAC-SHA256.
+//
+// Takes in a string called password and a string called salt, the number of
+// iterations to stretch the password with, and the number of bytes of the key
+// to return (key_length). Returns the raw bytes of the derived key. Throws an
+// invalid_argument exception if iterations or key_length is 0.
+std::string Pbkdf2HmacSha256(const std::string& password,
+                             const std::string& salt, size_t iterations,
+                             size_t key_length);
+
+// Finds the number of PBKDF2 iterations that takes about target_latency to
+// derive a key on this machine. Never returns less than kMinimumIterations or
+// more than kMaximumIterations.
+// Throws an invalid_argument exception if target_latency isn't positive.
+size_t CalibrateIterations(std::chrono::milliseconds target_latency);
+
+// Generates length random bytes to use as a salt.
+std::string GenerateSalt(size_t length);
+
+// Converts raw bytes into a lower case hex string.
+std::string ConvertToHex(const std::string& bytes);
+
+// Converts a hex string back into raw bytes. Throws an invalid_argument
+// exception if the passed in string isn't valid hex.
+std::string ConvertFromHex(const std::string& hex);
+
+// Overwrites length bytes starting at bytes with zeros in a way the compiler
+// can't optimize away.
+void WipeBytes(void* bytes, size_t length);
+
+// Overwrites the characters of the passed in string with zeros and empties it.
+// Only the string's current buffer is wiped, not buffers it had before.
+void WipeString(std::string& str);
+
+}  // namespace keyderivation
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_ENCRYPTION_KEY_DERIVATION_H
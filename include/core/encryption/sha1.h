@@ -0,0 +1,19 @@
+#ifndef CORE_ENCRYPTION_SHA1_H
+#define CORE_ENCRYPTION_SHA1_H
+
+#include <string>
+
+namespace passwordcontainer {
+
+// The number of bytes in a SHA-1 digest
+const size_t kSha1DigestLength = 20;
+
+// Calculates the SHA-1 hash of the passed in message and returns the raw 20
+// byte digest. SHA-1 is broken for signatures and must never be used to protect
+// anything, but breached password lists are published as SHA-1 hashes, so it
+// is needed to look passwords up in them.
+std::string Sha1(const std::string& message);
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_ENCRYPTION_SHA1_H
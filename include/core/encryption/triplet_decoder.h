@@ -0,0 +1,39 @@
+#ifndef CORE_ENCRYPTION_TRIPLET_DECODER_H
+#define CORE_ENCRYPTION_TRIPLET_DECODER_H
+
+#include <cstddef>
+
+namespace passwordcontainer {
+
+namespace tripletdecoder {
+
+// The number of digits one encrypted character takes up
+const size_t kTripletLength = 3;
+
+// Decodes count encrypted characters from input into output. Every encrypted
+// character is a group of 3 decimal digits that has offset subtracted from its
+// value to get the decrypted character.
+//
+// Takes in a char* input that points to count * kTripletLength digits, the
+// number of encrypted characters called count, the offset used to encrypt the
+// characters, and a char* output that has room for count characters.
+//
+// Returns false as soon as a group that isn't made of 3 digits or doesn't
+// decode to a tab, new line, or printable ASCII character is found. Uses the
+// widest SIMD instructions the CPU supports and falls back to scalar code.
+bool DecodeTriplets(const char* input, size_t count, size_t offset,
+                    char* output);
+
+// Same as DecodeTriplets but always uses the scalar implementation.
+bool DecodeTripletsScalar(const char* input, size_t count, size_t offset,
+                          char* output);
+
+// Returns the name of the implementation DecodeTriplets uses on this CPU
+// ("avx2", "sse4.1", or "scalar").
+const char* GetImplementationName();
+
+}  // namespace tripletdecoder
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_ENCRYPTION_TRIPLET_DECODER_H
@@ -0,0 +1,49 @@
+#ifndef CORE_IO_CSV_IMPORTER_H
+#define CORE_IO_CSV_IMPORTER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "core/io/csv_reader.h"
+#include "core/io/import_report.h"
+#include "core/password_container.h"
+
+namespace passwordcontainer {
+
+// Imports accounts from the CSV files browsers and password managers export.
+// The first row must name the columns, and the account name, username, and
+// password are taken from the first columns with one of the names they are
+// known by (like "name" or "url", "username" or "login_username", and
+// "password"), ignoring case. Other columns are ignored.
+//
+// Every row is checked against the same rules as AddAccount. Rows that break
+// them are left out and listed in the report with their line number, and the
+// other rows are added to the container in one batch at the end.
+class CsvImporter {
+ public:
+  // Creates a new CsvImporter that parses the input on thread_count threads
+  // (0 uses every hardware thread), reading chunk_length bytes at a time.
+  // Throws an invalid_argument exception if chunk_length is 0.
+  CsvImporter(size_t thread_count,
+              size_t chunk_length = CsvReader::kDefaultChunkLength);
+
+  // Imports every row of input into the passed in container and returns the
+  // report. Throws an invalid_argument exception if the input has no header
+  // row or the header doesn't have the name, username, and password columns.
+  // Nothing is added if an exception is thrown.
+  ImportReport Import(std::istream& input, PasswordContainer& container) const;
+
+ private:
+  size_t thread_count_;
+  size_t chunk_length_;
+
+  // Returns the index of the first of the passed in column names that is in
+  // header (ignoring case), or header.size() if none of them are.
+  static size_t FindColumn(const std::vector<std::string>& header,
+                           const std::vector<std::string>& column_names);
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_IO_CSV_IMPORTER_H
@@ -0,0 +1,79 @@
+#ifndef CORE_IO_CSV_READER_H
+#define CORE_IO_CSV_READER_H
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/thread_pool.h"
+
+namespace passwordcontainer {
+
+// One row of a CSV file.
+struct CsvRecord {
+  // The line of the file the record starts on, counting from 1
+  size_t line_number = 0;
+
+  // The fields of the record, with quotes removed and "" turned into "
+  std::vector<std::string> fields;
+
+  // Describes what is wrong with the record, or empty if it is well formed
+  std::string error;
+};
+
+// Reads the records of a CSV file (RFC 4180, which is what browsers and
+// password managers export) a chunk at a time, so files larger than memory
+// can be read. Fields can be quoted, and quoted fields can hold commas, quotes
+// written as "", and line breaks. Lines can end with \n or \r\n.
+//
+// Finding where records end only needs to track whether the reader is inside
+// quotes, which one quick pass over a chunk does. Every record is then split
+// into fields and unquoted on its own, so that part is spread across the
+// threads.
+class CsvReader {
+ public:
+  // The number of bytes read from the input at a time by default
+  static const size_t kDefaultChunkLength = 4 << 20;
+
+  // Creates a new CsvReader that reads from input chunk_length bytes at a time
+  // and parses records on thread_count threads (0 uses every hardware thread).
+  // Throws an invalid_argument exception if chunk_length is 0.
+  CsvReader(std::istream& input, size_t thread_count,
+            size_t chunk_length = kDefaultChunkLength);
+
+  // Returns the next records in the input in order, skipping blank lines.
+  // Returns an empty vector once every record was read. Malformed records are
+  // returned with their error set instead of throwing.
+  std::vector<CsvRecord> ReadRecords();
+
+ private:
+  // The number of records parsed by one task
+  static const size_t kRecordsPerTask = 1024;
+
+  std::istream& input_;
+
+  // The pool the records are parsed on, or null if they are parsed on the
+  // calling thread
+  std::shared_ptr<ThreadPool> thread_pool_;
+
+  size_t chunk_length_;
+
+  // Input that was read but is part of a record that hasn't ended yet
+  std::string buffer_;
+
+  // The line the first record in buffer_ starts on
+  size_t line_number_ = 1;
+
+  // Whether everything in input_ was read into buffer_
+  bool is_input_done_ = false;
+
+  // Parses the record between begin and end (without its line break) into
+  // record. Leaves the fields of blank records empty.
+  static void ParseRecord(const char* begin, const char* end,
+                          CsvRecord& record);
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_IO_CSV_READER_H
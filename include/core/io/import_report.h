@@ -0,0 +1,27 @@
+#ifndef CORE_IO_IMPORT_REPORT_H
+#define CORE_IO_IMPORT_REPORT_H
+
+#include <string>
+#include <vector>
+
+namespace passwordcontainer {
+
+// What happened while importing accounts.
+struct ImportReport {
+  // An account that wasn't imported and why
+  struct Error {
+    size_t line_number;
+    std::string message;
+  };
+
+  // The number of accounts that were read and the number that were added
+  size_t row_count = 0;
+  size_t imported_count = 0;
+
+  // The accounts that weren't imported, in the order they are in the input
+  std::vector<Error> errors;
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_IO_IMPORT_REPORT_H
@@ -0,0 +1,38 @@
+#ifndef CORE_IO_JSON_EXPORTER_H
+#define CORE_IO_JSON_EXPORTER_H
+
+#include <iostream>
+
+#include "core/password_container.h"
+
+namespace passwordcontainer {
+
+// Writes the accounts of a container as unencrypted JSON for other tools to
+// read, in the form:
+//
+//   {
+//     "version": 1,
+//     "accounts": [
+//       {
+//         "name": "Github",
+//         "username": "user@example.com",
+//         "password": "..."
+//       }
+//     ]
+//   }
+//
+// Accounts are written one at a time as they are read from the container, so
+// the export never holds more than one account no matter how many there are.
+class JsonExporter {
+ public:
+  // The version of the format that is written
+  static const size_t kFormatVersion = 1;
+
+  // Writes every account in container to output in the order they were added.
+  // Throws an invalid_argument exception if output can't be written to.
+  static void Export(const PasswordContainer& container, std::ostream& output);
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_IO_JSON_EXPORTER_H
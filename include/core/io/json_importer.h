@@ -0,0 +1,32 @@
+#ifndef CORE_IO_JSON_IMPORTER_H
+#define CORE_IO_JSON_IMPORTER_H
+
+#include <iostream>
+
+#include "core/io/import_report.h"
+#include "core/password_container.h"
+
+namespace passwordcontainer {
+
+// Imports the accounts in JSON written by JsonExporter. The JSON is parsed as
+// it is read, so only the accounts themselves are kept in memory. Keys that
+// aren't part of the format are ignored.
+//
+// Every account is checked against the same rules as AddAccount. Accounts
+// that break them are left out and listed in the report with the line they
+// start on, and the other accounts are added to the container in one batch at
+// the end.
+class JsonImporter {
+ public:
+  // Imports every account in input into the passed in container and returns
+  // the report. Throws an invalid_argument exception if the input isn't valid
+  // JSON, isn't an object with an "accounts" array, or has a version newer
+  // than JsonExporter::kFormatVersion. Nothing is added if an exception is
+  // thrown.
+  static ImportReport Import(std::istream& input,
+                             PasswordContainer& container);
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_IO_JSON_IMPORTER_H
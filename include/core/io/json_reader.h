@@ -0,0 +1,101 @@
+#ifndef CORE_IO_JSON_READER_H
+#define CORE_IO_JSON_READER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace passwordcontainer {
+
+// Receives the parts of a JSON document from JsonReader in the order they are
+// in the document. Every function does nothing by default.
+class JsonHandler {
+ public:
+  virtual ~JsonHandler() = default;
+
+  virtual void StartObject() {}
+  virtual void EndObject() {}
+  virtual void StartArray() {}
+  virtual void EndArray() {}
+
+  // Called with the key of the value in an object that comes next
+  virtual void Key(const std::string& /*key*/) {}
+
+  virtual void String(const std::string& /*value*/) {}
+  virtual void Number(double /*value*/) {}
+  virtual void Bool(bool /*value*/) {}
+  virtual void Null() {}
+};
+
+// Parses JSON (RFC 8259) from a stream and hands every part of it to a
+// JsonHandler as soon as it is read, without building the document in memory.
+// Input is read through a fixed size buffer and nesting is tracked with an
+// explicit stack, so only the current string and one entry per level of
+// nesting are kept no matter how large the document is.
+class JsonReader {
+ public:
+  // The number of bytes read from the input at a time by default
+  static const size_t kDefaultBufferLength = 1 << 16;
+
+  // The deepest the values in a document can be nested
+  static const size_t kMaxDepth = 512;
+
+  // Creates a new JsonReader that reads from input buffer_length bytes at a
+  // time. Throws an invalid_argument exception if buffer_length is 0.
+  explicit JsonReader(std::istream& input,
+                      size_t buffer_length = kDefaultBufferLength);
+
+  // Parses the one value in the input and calls handler for every part of it.
+  // Throws an invalid_argument exception with the line number if the input
+  // isn't valid JSON or is nested deeper than kMaxDepth. Exceptions thrown by
+  // handler are passed on.
+  void Parse(JsonHandler& handler);
+
+  // Returns the line the reader is on, counting from 1. Handlers can call this
+  // to find where the part they were called with is.
+  size_t GetLineNumber() const;
+
+ private:
+  std::istream& input_;
+
+  // The input that was read and the part of it that wasn't parsed yet
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t end_ = 0;
+
+  size_t line_number_ = 1;
+
+  // Returns the next character without moving past it, or -1 at the end of
+  // the input.
+  int Peek();
+
+  // Returns the next character and moves past it. Throws an invalid_argument
+  // exception at the end of the input.
+  char Next();
+
+  // Moves past spaces, tabs, and line breaks.
+  void SkipWhitespace();
+
+  // Reads the rest of a string whose opening quote was already read.
+  std::string ReadString();
+
+  // Reads the 4 hex digits of a \u escape and returns their value.
+  unsigned int ReadHexCode();
+
+  // Reads the rest of a number whose first character was already read.
+  double ReadNumber(char first_character);
+
+  // Reads the rest of a literal whose first character was already read and
+  // throws an invalid_argument exception if it isn't literal.
+  void ReadLiteral(const char* literal);
+
+  // Reads a key and the colon after it and passes the key to handler.
+  void ReadKey(JsonHandler& handler);
+
+  // Throws an invalid_argument exception with the current line number.
+  void Fail() const;
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_IO_JSON_READER_H
@@ -0,0 +1,59 @@
+#ifndef CORE_IO_JSON_WRITER_H
+#define CORE_IO_JSON_WRITER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace passwordcontainer {
+
+// Writes JSON to a stream as it is produced, without building the document
+// in memory first. Values are indented by two spaces per level. The caller is
+// responsible for calling the functions in an order that makes valid JSON
+// (like only calling Key directly inside an object).
+class JsonWriter {
+ public:
+  // Creates a new JsonWriter that writes to the passed in output.
+  explicit JsonWriter(std::ostream& output);
+
+  // Starts and ends an object or array.
+  void BeginObject();
+  void EndObject();
+  void BeginArray();
+  void EndArray();
+
+  // Writes the key of the next value in an object.
+  void Key(const std::string& key);
+
+  // Writes the passed in string or number as a value.
+  void String(const std::string& value);
+  void Number(size_t value);
+
+  // Writes the passed in text as a string with every character JSON doesn't
+  // allow in a string escaped. The text is expected to be UTF-8 and is copied
+  // in runs between the characters that need escaping.
+  static void WriteEscapedString(std::ostream& output, const std::string& text);
+
+ private:
+  std::ostream& output_;
+
+  // Whether every open object or array has a value in it yet, innermost last
+  std::vector<bool> has_values_;
+
+  // Whether a key was just written, so the next value goes on the same line
+  bool is_after_key_ = false;
+
+  // Writes what goes before a value: the comma after the previous value and
+  // the line break and indentation.
+  void BeginValue();
+
+  // Ends the innermost object or array with the passed in bracket.
+  void EndContainer(char bracket);
+
+  // Writes a line break and the indentation of the current depth.
+  void WriteIndentation();
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_IO_JSON_WRITER_H
@@ -1,11 +1,24 @@
 #ifndef CORE_PASSWORD_CONTAINER_H
 #define CORE_PASSWORD_CONTAINER_H
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "core/account_batch.h"
+#include "core/audit/breached_password_checker.h"
+#include "core/audit/password_reuse_index.h"
+#include "core/audit/password_strength_scorer.h"
 #include "core/encryption/cryptographer.h"
+#include "core/search/account_search_index.h"
+#include "core/storage/string_arena.h"
+#include "core/storage/string_pool.h"
+#include "core/vault_rekeyer.h"
 
 namespace passwordcontainer {
 
@@ -14,9 +27,11 @@ namespace passwordcontainer {
 //
 // The encryption used in this container utilizes a key that has the int values
 // of all characters in it plus a specified offset averaged to find a newly
-// calculated offset. That is then used to encrypt a  string by adding the
-// calculated offset to each character in the data or decrypt the data by
-// subtracting the offset from each character.
+// calculated offset. The key used for this is derived from the key that is
+// passed in with PBKDF2-HMAC-SHA256, using a salt and iteration count that are
+// saved in the header of the save file. That is then used to encrypt a string
+// by adding the calculated offset to each character in the data or decrypt the
+// data by subtracting the offset from each character.
 class PasswordContainer {
  public:
   // A Struct that contains the final details of the accounts for the program to
@@ -29,57 +44,304 @@ class PasswordContainer {
     std::string password;
   };
 
+  // Refers to one account for as long as it exists, no matter which accounts
+  // are added or deleted around it. A handle remembers which use of its id it
+  // was made for, so a handle to a deleted account is detected instead of
+  // referring to the account that took over its id. A default constructed
+  // handle doesn't refer to any account.
+  struct AccountHandle {
+    uint32_t id = 0;
+    uint32_t generation = 0;
+
+    bool operator==(const AccountHandle& other) const;
+    bool operator!=(const AccountHandle& other) const;
+  };
+
+  // The accounts and key of a container at one point in time, in the form
+  // they are saved in. Written with the << operator, which can run on another
+  // thread while the container it was taken from keeps changing.
+  class Snapshot {
+   public:
+    // Overloaded << operator that writes the same encrypted data as the <<
+    // operator of the container did when the snapshot was taken. Derives the
+    // cipher key first if the container hadn't derived it yet.
+    friend std::ostream& operator<<(std::ostream& output,
+                                    const Snapshot& snapshot);
+
+   private:
+    friend class PasswordContainer;
+
+    explicit Snapshot(const Cryptographer& cryptographer);
+
+    // The unencrypted data the container is saved as
+    std::string plain_text_;
+
+    // The cryptographer of the container and what its key is derived from
+    mutable Cryptographer cryptographer_;
+    std::string hashed_key_;
+    size_t kdf_iterations_ = 0;
+    std::string kdf_salt_;
+    mutable bool is_key_derived_ = false;
+    bool has_username_table_ = false;
+
+    // Returns the cryptographer after deriving its key if it wasn't derived.
+    const Cryptographer& GetCryptographer() const;
+  };
+
+  // Called by LoadFile after every chunk with the number of bytes of the file
+  // read so far and the size of the file. Returns whether loading should go
+  // on.
+  typedef std::function<bool(size_t, size_t)> LoadProgressCallback;
+
   // Creates a new PasswordContainer using the passed in offset and key. Throws
   // an invalid_argument exception if the offset is less than
-  // kMinimumCharacterOffset or if the key is an empty string.
+  // kMinimumCharacterOffset or if the key is an empty string. The cipher key is
+  // only derived from the key once it is first needed.
   PasswordContainer(size_t offset, const std::string& key);
 
+  // Returned by FindAccount when there is no account with the name
+  static const size_t kNoAccountIndex = static_cast<size_t>(-1);
+
   // Returns the vector of AccountDetails that contains information for all
-  // loaded in accounts.
+  // loaded in accounts. Copies every account, so GetAccountNames or GetAccount
+  // should be used when only some of the data is needed.
   std::vector<AccountDetails> GetAccounts() const;
 
-  // Sets the key to the passed in value. Throws an invalid_argument exception
-  // if the passed in key is empty.
+  // Returns the names of all loaded in accounts in the order they were added.
+  // Doesn't touch any usernames or passwords.
+  const std::vector<std::string>& GetAccountNames() const;
+
+  // Returns the number of loaded in accounts.
+  size_t GetAccountCount() const;
+
+  // Returns a number that changes whenever an account is added, deleted, or
+  // modified, so anything copied from the container can be checked for being
+  // out of date without comparing it.
+  size_t GetRevision() const;
+
+  // Returns the AccountDetails of the account at the passed in index. Throws an
+  // invalid_argument exception if there is no account at index.
+  AccountDetails GetAccount(size_t index) const;
+
+  // Returns the AccountDetails of the account the passed in handle refers to.
+  // Throws an invalid_argument exception if the handle isn't valid.
+  AccountDetails GetAccount(const AccountHandle& handle) const;
+
+  // Returns the name of the account the passed in handle refers to without
+  // copying it. Throws an invalid_argument exception if the handle isn't
+  // valid.
+  const std::string& GetAccountName(const AccountHandle& handle) const;
+
+  // Returns a handle to the account at the passed in index. Throws an
+  // invalid_argument exception if there is no account at index.
+  AccountHandle GetAccountHandle(size_t index) const;
+
+  // Returns a handle to the account with the passed in account_name, or a
+  // default constructed handle if there is no account with that name.
+  AccountHandle FindAccountHandle(const std::string& account_name) const;
+
+  // Returns whether the passed in handle refers to an account that still
+  // exists. Takes constant time.
+  bool IsValidHandle(const AccountHandle& handle) const;
+
+  // Returns the index of the account the passed in handle refers to. Throws an
+  // invalid_argument exception if the handle isn't valid.
+  size_t GetAccountIndex(const AccountHandle& handle) const;
+
+  // Sets the key to the passed in value and picks a new salt for it. Throws an
+  // invalid_argument exception if the passed in key is empty.
   void SetCryptographerKey(const std::string& new_key);
 
-  // Gets the key.
+  // Gets the cipher key that was derived from the key.
   std::string GetCryptographerKey() const;
 
   // Sets the character_offset to the passed in value. Throws an
   // invalid_argument exception if offset is lower than the minimum offset.
   void SetCryptographerOffset(size_t offset);
 
+  // Lets the cryptographer encrypt and decrypt the container data on
+  // thread_count threads once the data is at least serial_threshold characters
+  // long. A thread_count of 0 uses every hardware thread and 1 keeps all work
+  // on the calling thread. RekeyFile and the password audits also use
+  // thread_count threads.
+  void SetCryptographerParallelism(size_t thread_count,
+                                   size_t serial_threshold);
+
+  // Sets the number of PBKDF2 iterations used to derive the cipher key. Takes
+  // effect the next time the container is saved. Throws an invalid_argument
+  // exception if iterations is less than keyderivation::kMinimumIterations or
+  // more than keyderivation::kMaximumIterations.
+  void SetKdfIterations(size_t iterations);
+
+  // Gets the number of PBKDF2 iterations used to derive the cipher key. Returns
+  // 0 if the key isn't stretched (only while reading an older save file).
+  size_t GetKdfIterations() const;
+
+  // Measures how fast keys are derived on this machine and sets the number of
+  // PBKDF2 iterations so that unlocking takes about target_latency. Returns the
+  // number of iterations that was picked. Throws an invalid_argument exception
+  // if target_latency isn't positive.
+  size_t CalibrateKdfIterations(std::chrono::milliseconds target_latency);
+
+  // Re-encrypts the save file at file_path with new_key and a new salt, then
+  // makes the container use new_key. The file must have been saved with the
+  // current key. The data is streamed through a temporary file in chunks, so
+  // the whole file is never in memory, and the temporary file replaces the
+  // original in one step so a failure never leaves a half rekeyed file.
+  //
+  // Calls progress (if it isn't empty) with the number of bytes of encrypted
+  // data rekeyed so far and the total. Throws an invalid_argument exception if
+  // new_key is empty, the file can't be read or replaced, the current key is
+  // wrong for the file, or the data is bad. The file and key are unchanged if
+  // an exception is thrown.
+  void RekeyFile(const std::string& file_path, const std::string& new_key,
+                 const VaultRekeyer::ProgressCallback& progress);
+
+  // Loads the save file at file_path the same way as the >> operator, but
+  // reads and decrypts it kLoadChunkLength bytes at a time. Calls progress (if
+  // it isn't empty) after every chunk, and stops without adding any accounts
+  // if it returns false. Returns whether the accounts were loaded.
+  //
+  // Throws an invalid_argument exception if the file can't be read, the key is
+  // wrong for the file, or the data is bad.
+  bool LoadFile(const std::string& file_path,
+                const LoadProgressCallback& progress);
+
+  // Sets whether the container is saved with a table of every distinct
+  // username at the start of the data, so that each username is only written
+  // once no matter how many accounts use it. Takes effect the next time the
+  // container is saved. Loading a save file uses the layout of the file.
+  void SetUsernamePooling(bool is_enabled);
+
+  // Returns whether the container is saved with a username table.
+  bool IsUsernamePoolingEnabled() const;
+
+  // Returns the number of distinct usernames used by the accounts.
+  size_t GetUniqueUsernameCount() const;
+
   // Adds a new account with the passed in account_name, username, and password.
   //
   // Throws an invalid_argument exception if account_name, username, or password
-  // are empty. Also throws an invalid_argument exception if there is already an
-  // account with account_name.
+  // are empty or contain a tab or line break. Also throws an invalid_argument
+  // exception if there is already an account with account_name.
   void AddAccount(const std::string& account_name, const std::string& username,
                   const std::string& password);
 
-  // Deletes the account with the passed in account_name.
+  // Adds every account in the passed in accounts at once, which is much faster
+  // than adding them one at a time since the indexes are only rebuilt once.
+  //
+  // Throws an invalid_argument exception if the details of any account are
+  // empty or contain a tab or line break, or if an account has the name of
+  // another account in the container or in accounts. Nothing is added if an
+  // exception is thrown.
+  void AddAccounts(const std::vector<AccountDetails>& accounts);
+
+  // Applies every change staged in the passed in batch in the order it was
+  // staged. Every change is checked before any is applied, as if the changes
+  // before it already were, so an account added earlier in the batch can be
+  // modified or deleted later in it.
+  //
+  // Throws an invalid_argument exception if any change would make AddAccount,
+  // ModifyAccount, or DeleteAccount throw at its point in the batch. Nothing is
+  // changed if an exception is thrown.
+  void CommitBatch(const AccountBatch& batch);
+
+  // Throws an invalid_argument exception if any of the details of the passed
+  // in account are empty or contain a tab or line break, which the save file
+  // uses to separate details and accounts.
+  static void ValidateAccountDetails(const AccountDetails& account);
+
+  // Deletes the account with the passed in account_name. Only the accounts
+  // added after it are moved, and they are moved without being copied.
+  // CommitBatch should be used to delete many accounts, since it moves every
+  // account at most once no matter how many are deleted.
   //
   // Throws an invalid_argument exception if there is no account with the passed
   // in account_name.
   void DeleteAccount(const std::string& account_name);
 
+  // Deletes the account the passed in handle refers to, which makes every
+  // handle to it invalid. Throws an invalid_argument exception if the handle
+  // isn't valid.
+  void DeleteAccount(const AccountHandle& handle);
+
   // Modifies the account with the passed in account_name to have the passed in
   // username and password.
   //
   // Throws an invalid_argument exception if there is no account with the passed
   // in account name. Also throws the exception if the username or password is
-  // empty.
+  // empty or contains a tab or line break.
   void ModifyAccount(const std::string& account_name,
                      const std::string& username, const std::string& password);
 
+  // Modifies the account the passed in handle refers to like ModifyAccount
+  // with its name. Throws an invalid_argument exception if the handle isn't
+  // valid.
+  void ModifyAccount(const AccountHandle& handle, const std::string& username,
+                     const std::string& password);
+
+  // Returns the names of every account that uses the passed in username in
+  // sorted order. Uses an index kept up to date as accounts change, so it
+  // doesn't look at any other accounts.
+  std::vector<std::string> GetAccountsForUsername(
+      const std::string& username) const;
+
+  // Returns the names of the accounts in every group of two or more accounts
+  // that use the same password, largest groups first. The passwords are
+  // hashed into a PasswordReuseIndex on the threads set by
+  // SetCryptographerParallelism the first time this is called, and the index
+  // is kept up to date as accounts change after that.
+  std::vector<std::vector<std::string>> FindReusedPasswords() const;
+
+  // Returns the names of the accounts whose passwords are in the passed in
+  // checker's list of breached passwords, in the order the accounts were added.
+  // The passwords are checked on the threads set by
+  // SetCryptographerParallelism.
+  std::vector<std::string> FindBreachedAccounts(
+      const BreachedPasswordChecker& checker) const;
+
+  // Returns the strength of the password of the account at the passed in
+  // index. Strengths are cached until the password changes. Throws an
+  // invalid_argument exception if there is no account at index.
+  PasswordStrength GetPasswordStrength(size_t index) const;
+
+  // Returns the strength of the password of the account the passed in handle
+  // refers to. Throws an invalid_argument exception if the handle isn't valid.
+  PasswordStrength GetPasswordStrength(const AccountHandle& handle) const;
+
+  // Returns the strength of every password in the order the accounts were
+  // added. Passwords that aren't cached yet are scored in one batch on the
+  // threads set by SetCryptographerParallelism.
+  std::vector<PasswordStrength> ScorePasswords() const;
+
+  // Adds the words in the file at file_path to the dictionary passwords are
+  // scored against and drops every cached strength. Throws an
+  // invalid_argument exception if the file can't be opened.
+  void LoadStrengthWordList(const std::string& file_path);
+
   // Returns a boolean that signifies whether there is an account with the
-  // passed in account_name in the file.
-  bool HasAccount(const std::string& account_name);
+  // passed in account_name in the file. Looks the name up in a hash index.
+  bool HasAccount(const std::string& account_name) const;
+
+  // Finds the index of the account with the passed in account_name with a
+  // hash index. Returns kNoAccountIndex if there is no account with that name.
+  size_t FindAccount(const std::string& account_name) const;
 
-  // Finds the iterator that refers to the AccountDetails object is referred to
-  // by the passed in account_name.
-  std::vector<AccountDetails>::iterator FindAccount(
-      const std::string& account_name);
+  // Returns the names of the accounts that start with the passed in query,
+  // followed by the names of the other accounts that contain it. Case is
+  // ignored and both groups are sorted. Returns at most max_results names
+  // unless max_results is 0. Uses an index instead of checking every name.
+  std::vector<std::string> SearchAccounts(const std::string& query,
+                                          size_t max_results = 0) const;
+
+  // Returns the names of the accounts closest to the passed in name, for
+  // suggesting the name the user meant when they mistype one. Names are ranked
+  // by the number of characters that would need to change (ignoring case) and
+  // only names at most max_distance changes away are returned. Returns at most
+  // max_results names unless max_results is 0.
+  std::vector<std::string> FindClosestAccounts(const std::string& name,
+                                               size_t max_results,
+                                               size_t max_distance) const;
 
   // Overloaded >> operator used to read in a file of encrypted username and
   // password data.
@@ -87,6 +349,10 @@ class PasswordContainer {
   // Takes in an istream called input that represents the input that contains
   // data for the encrypted data. Also takes in a PasswordContainer called
   // container that is the container where the data is being loaded into.
+  //
+  // If the data starts with a VaultHeader, the key is checked against it before
+  // any data is decrypted. Throws an invalid_argument exception if the key is
+  // wrong or the data is bad.
   friend std::istream& operator>>(std::istream& input,
                                   PasswordContainer& container);
 
@@ -95,12 +361,24 @@ class PasswordContainer {
   //
   // Takes in an ostream called output that represents the output of the
   // container. Also takes in a PasswordContainer called container that is the
-  // container that is the container where data is being read from.
+  // container that is the container where data is being read from. The
+  // encrypted data is written after a VaultHeader for the current key.
   friend std::ostream& operator<<(std::ostream& output,
                                   const PasswordContainer& container);
 
+  // Returns a snapshot of the accounts and key that can be saved on another
+  // thread. Only copies the accounts into the form they are saved in, so
+  // deriving the key and encrypting are left for when it is written.
+  Snapshot CreateSnapshot() const;
+
+  // Swaps the accounts, keys, and settings of the passed in containers in
+  // constant time. Both revisions go up, and handles made before the swap
+  // shouldn't be used with either container.
+  friend void swap(PasswordContainer& first, PasswordContainer& second);
+
  private:
-  Cryptographer cryptographer_;
+  // Only used through GetCryptographer so its key is always up to date
+  mutable Cryptographer cryptographer_;
 
   // Enum that stores values for the index value of how details are stored in
   // a file (There is the account name, then username, then password in the save
@@ -115,16 +393,212 @@ class PasswordContainer {
   // username, and password.
   const size_t kNumDetails = 3;
 
-  // A vector of all accounts stored in the program
-  std::vector<AccountDetails> accounts_;
+  // The number of PBKDF2 iterations new containers use before they are
+  // calibrated and the number of random bytes in a salt
+  const size_t kDefaultKdfIterations = 100000;
+  const size_t kKdfSaltLength = 16;
+
+  // The number of bytes of encrypted data RekeyFile handles at a time
+  const size_t kRekeyChunkLength = 3 << 20;
+
+  // The number of bytes of encrypted data LoadFile decrypts at a time
+  const size_t kLoadChunkLength = 3 << 20;
+
+  // The size of the blocks the passwords are packed into
+  const size_t kPasswordBlockSize = 1 << 16;
+
+  // The number of passwords checked by one task of FindBreachedAccounts
+  const size_t kBreachCheckBatchSize = 256;
+
+  // The search index is rebuilt instead of updated one name at a time once
+  // more than one in this many names changed since it was last searched
+  const size_t kSearchIndexRebuildRatio = 256;
+
+  // The number of threads RekeyFile, the password audits, and ScorePasswords
+  // use (0 uses every hardware thread)
+  size_t thread_count_ = 1;
+
+  // The SHA-256 hash of the key that was passed in. The cipher key is derived
+  // from this so the key itself never has to be stored.
+  std::string hashed_key_;
+
+  // The PBKDF2 iterations and raw salt used to derive the cipher key
+  size_t kdf_iterations_;
+  std::string kdf_salt_;
+
+  // Whether the key in cryptographer_ was derived from the current
+  // hashed_key_, kdf_iterations_, and kdf_salt_. Deriving is slow so it is only
+  // done when the cryptographer is actually used.
+  mutable bool is_key_derived_ = false;
+
+  // The details of all accounts stored in the program, with one column per
+  // detail. The account in a slot has its name, username, and password at
+  // that index of each column. Keeping the names apart means operations that
+  // only look at names never load usernames or passwords into the cache.
+  //
+  // A deleted account leaves its slot with an empty name (which no account
+  // can have) until the change that deleted it calls CompactAccounts, so
+  // between changes every account's slot is its index and reading never moves
+  // an account.
+  std::vector<std::string> account_names_;
+  std::vector<StringPool::Id> username_ids_;
+  std::vector<StringArena::Handle> password_handles_;
+  std::vector<uint32_t> handle_ids_;
+  size_t deleted_slot_count_ = 0;
+
+  // The characters of every password, packed one after another so loading
+  // and freeing many accounts only takes a few large allocations instead of
+  // one per password. A changed or deleted password leaves its characters
+  // behind until CompactPasswords copies the rest into a new arena.
+  StringArena password_arena_;
+  size_t wasted_password_bytes_ = 0;
+
+  // Goes up whenever an account is added, deleted, or modified
+  size_t revision_ = 0;
+
+  // The slot of the account that uses every handle id and the generation of
+  // the handles to it. An id's generation goes up when its account is
+  // deleted, and the id is then reused for a later account.
+  struct HandleEntry {
+    size_t slot;
+    uint32_t generation;
+  };
+  std::vector<HandleEntry> handle_entries_;
+  std::vector<uint32_t> free_handle_ids_;
+
+  // The handle id of the account with every name
+  std::unordered_map<std::string, uint32_t> handle_ids_by_name_;
+
+  // Every distinct username, referred to by username_ids_. Many accounts
+  // usually share a few usernames, so each is only stored once.
+  StringPool usernames_;
+
+  // The names of the accounts that use every username, by the username's id
+  // in usernames_
+  std::vector<std::set<std::string>> account_names_by_username_;
+
+  // Whether the container is saved with a username table
+  bool is_username_pooling_enabled_ = false;
+
+  // Groups the accounts by password for FindReusedPasswords. Only built once
+  // it is first needed, and updated whenever a password changes after that.
+  mutable PasswordReuseIndex reuse_index_;
+  mutable bool is_reuse_index_built_ = false;
+
+  // Scores passwords for GetPasswordStrength and ScorePasswords
+  PasswordStrengthScorer strength_scorer_;
+
+  // The strength of the password at every index, which is only valid where
+  // is_strength_scored_ is true. Cleared for a password whenever it changes.
+  mutable std::vector<PasswordStrength> password_strengths_;
+  mutable std::vector<char> is_strength_scored_;
+
+  // A name that was added to or removed from the accounts
+  struct NameChange {
+    std::string account_name;
+    bool is_added;
+  };
+
+  // Indexes account_names_ for SearchAccounts. The names that were added or
+  // removed since it was last searched are only indexed before the next
+  // search, so deleting never has to update it.
+  mutable AccountSearchIndex search_index_;
+  mutable std::vector<NameChange> unindexed_name_changes_;
+
+  // Reads the VaultHeader at the start of input if there is one and takes
+  // the key derivation settings and layout of the data from it. Throws an
+  // invalid_argument exception if the key is wrong for the header.
+  void ReadHeader(std::istream& input);
+
+  // Adds the accounts in decrypted_string, which was read after ReadHeader,
+  // and stretches the key of older save files from the next save on.
+  void FinishReading(const std::string& decrypted_string);
+
+  // Returns the cryptographer after deriving its key if the key, salt, or
+  // iterations changed since it was last derived.
+  const Cryptographer& GetCryptographer() const;
+
+  // Sets the key of the passed in cryptographer to the hex cipher key derived
+  // from the passed in hashed_key, salt, and iterations. Keys that were already
+  // derived in this process are taken from the KeyCache. The copies of the key
+  // made on the way are wiped once the key is set.
+  static void DeriveCipherKey(const std::string& hashed_key,
+                              const std::string& salt, size_t iterations,
+                              Cryptographer& cryptographer);
+
+  // Interns the passed in username for the account with account_name and
+  // returns its id.
+  StringPool::Id InternUsername(const std::string& username,
+                                const std::string& account_name);
+
+  // Releases the username with the passed in id from the account with
+  // account_name.
+  void ReleaseUsername(StringPool::Id id, const std::string& account_name);
+
+  // Adds the passed in account to a new slot at the end of every column
+  // without checking it.
+  void AppendAccount(const AccountDetails& account);
+
+  // Returns the slot of the account with the passed in account_name, or
+  // kNoAccountIndex if there is no account with that name.
+  size_t FindSlot(const std::string& account_name) const;
+
+  // Returns the slot of the account the passed in handle refers to. Throws an
+  // invalid_argument exception if the handle isn't valid.
+  size_t GetSlot(const AccountHandle& handle) const;
+
+  // Returns the details and the password strength of the account in the
+  // passed in slot.
+  AccountDetails GetAccountInSlot(size_t slot) const;
+  PasswordStrength GetStrengthInSlot(size_t slot) const;
+
+  // Changes the username and password of the account in the passed in slot
+  // without checking them.
+  void ReplaceAccountDetails(size_t slot, const std::string& username,
+                             const std::string& password);
+
+  // Empties the slot of the account in the passed in slot and removes the
+  // account from every index other than the search index, which is updated
+  // before the next search.
+  void RemoveAccount(size_t slot);
+
+  // Removes the slots of deleted accounts from every column in one pass, so
+  // every account's slot is its index again. Called at the end of every
+  // change that deletes accounts.
+  void CompactAccounts();
+
+  // Returns a copy of the password in the passed in slot.
+  std::string GetPasswordInSlot(size_t slot) const;
+
+  // Returns a copy of the password in every slot, for the audits that work on
+  // all passwords at once.
+  std::vector<std::string> CopyPasswords() const;
+
+  // Adds the passed in password to the arena and returns its handle. Copies
+  // the passwords that are still used into a new arena first if most of the
+  // arena is left behind by changed and deleted passwords.
+  StringArena::Handle AppendPassword(const std::string& password);
+
+  // Copies the passwords that are still used into a new arena so the
+  // characters left behind by changed and deleted passwords are freed.
+  void CompactPasswords();
+
+  // Brings the search index up to date with the names that changed since it
+  // was last searched.
+  void IndexChangedNames() const;
 
   // Adds all the account data that are represented in the passed in
-  // decrypted_string to the container.
-  void AddAllData(const std::string& decrypted_string);
+  // decrypted_string to the container. Reads the username table at the start
+  // of the data first if has_username_table is true.
+  void AddAllData(const std::string& decrypted_string,
+                  bool has_username_table);
 
   // Adds the data for one account that is represented by the passed in
-  // line_data string
-  void AddOneAccountData(const std::string& line_data);
+  // line_data string. If username_table isn't empty, the username in the line
+  // is an index into it. Throws an invalid_argument exception if a detail is
+  // empty or the account is already in the container.
+  void AddOneAccountData(const std::string& line_data,
+                         const std::vector<std::string>& username_table);
 
   // Returns a string representation of all the data currently in the container.
   std::string GenerateStringRepresentation() const;
@@ -0,0 +1,104 @@
+#ifndef CORE_SEARCH_ACCOUNT_SEARCH_INDEX_H
+#define CORE_SEARCH_ACCOUNT_SEARCH_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace passwordcontainer {
+
+// An index over account names that finds every name starting with or
+// containing some text without looking at every name. Searches ignore case.
+//
+// Prefixes are found with a binary search in a sorted array of the names.
+// Substrings are found with trigram posting lists: for every three character
+// sequence, the sorted ids of the names that contain it. A substring query
+// intersects the lists of its trigrams and then checks the few names that are
+// left. Both are updated as names are added and removed. Names that are only
+// close to some text are found with an EditDistanceMatcher.
+class AccountSearchIndex {
+ public:
+  // The number of characters in a trigram
+  static const size_t kGramLength = 3;
+
+  // Adds the passed in account_name to the index. Throws an invalid_argument
+  // exception if the name is already in the index.
+  void Insert(const std::string& account_name);
+
+  // Removes the passed in account_name from the index. Throws an
+  // invalid_argument exception if the name isn't in the index.
+  void Remove(const std::string& account_name);
+
+  // Replaces everything in the index with the passed in account_names. Much
+  // faster than inserting the names one by one.
+  void Rebuild(const std::vector<std::string>& account_names);
+
+  // Returns the names that start with prefix, sorted without regard to case.
+  // Returns at most max_results names unless max_results is 0.
+  std::vector<std::string> FindByPrefix(const std::string& prefix,
+                                        size_t max_results) const;
+
+  // Returns the names that contain substring, sorted without regard to case.
+  // Returns at most max_results names unless max_results is 0.
+  std::vector<std::string> FindBySubstring(const std::string& substring,
+                                           size_t max_results) const;
+
+  // Returns the names that start with query followed by the other names that
+  // contain query, both in sorted order. Returns at most max_results names
+  // unless max_results is 0.
+  std::vector<std::string> Search(const std::string& query,
+                                  size_t max_results) const;
+
+  // Returns the names closest to the passed in name by edit distance (ignoring
+  // case), closest first and then in sorted order. Only returns names at most
+  // max_distance edits away, and at most max_results names unless max_results
+  // is 0.
+  std::vector<std::string> FindClosest(const std::string& name,
+                                       size_t max_results,
+                                       size_t max_distance) const;
+
+  // Returns the number of names in the index.
+  size_t GetSize() const;
+
+ private:
+  typedef uint32_t NameId;
+
+  // A name in the index and the lower case version of it that is searched
+  struct Entry {
+    std::string name;
+    std::string folded_name;
+    bool is_used;
+  };
+
+  // Every name, by id. Removed names are marked unused and their ids reused.
+  std::vector<Entry> entries_;
+  std::vector<NameId> free_ids_;
+
+  // The ids of the names in the order of their folded names (and then their
+  // names, since two names can have the same folded name)
+  std::vector<NameId> sorted_ids_;
+
+  // The ids of the names containing every trigram, sorted by id
+  std::unordered_map<uint32_t, std::vector<NameId>> postings_;
+
+  // Returns true if the name with the first id comes before the name with the
+  // second id in sorted_ids_.
+  bool IsOrderedBefore(NameId first, NameId second) const;
+
+  // Returns the position in sorted_ids_ of the first name whose folded name
+  // isn't less than folded_prefix.
+  size_t FindFirstPosition(const std::string& folded_prefix) const;
+
+  // Returns the position in sorted_ids_ where the passed in account_name (with
+  // the lower case version folded_name) is or would be inserted.
+  size_t FindNamePosition(const std::string& account_name,
+                          const std::string& folded_name) const;
+
+  // Returns every distinct trigram of folded_name.
+  static std::vector<uint32_t> GetTrigrams(const std::string& folded_name);
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_SEARCH_ACCOUNT_SEARCH_INDEX_H
@@ -0,0 +1,47 @@
+#ifndef CORE_SEARCH_EDIT_DISTANCE_MATCHER_H
+#define CORE_SEARCH_EDIT_DISTANCE_MATCHER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace passwordcontainer {
+
+// Measures the Levenshtein distance (the number of inserted, deleted, or
+// replaced characters) between one pattern and many texts.
+//
+// Patterns of up to kMaxBitParallelLength characters use Myers' bit-parallel
+// algorithm, which handles a whole column of the distance table with a few
+// operations on one 64 bit int, so comparing a text only takes one step per
+// character of the text. Longer patterns fall back to the usual table. Both
+// stop as soon as the distance can't be within the bound they are given.
+class EditDistanceMatcher {
+ public:
+  // The longest pattern that fits in one 64 bit int
+  static const size_t kMaxBitParallelLength = 64;
+
+  // Creates a matcher that compares texts against the passed in pattern.
+  explicit EditDistanceMatcher(const std::string& pattern);
+
+  // Returns the edit distance between the pattern and the passed in text if it
+  // is at most max_distance, and max_distance + 1 otherwise.
+  size_t GetDistance(const std::string& text, size_t max_distance) const;
+
+ private:
+  std::string pattern_;
+
+  // The positions of every byte value in the pattern, one bit per position.
+  // Only filled in for patterns that use the bit-parallel algorithm.
+  std::vector<uint64_t> pattern_masks_;
+
+  // Returns the distance using the bit-parallel algorithm.
+  size_t GetBitParallelDistance(const std::string& text,
+                                size_t max_distance) const;
+
+  // Returns the distance using the full distance table.
+  size_t GetTableDistance(const std::string& text, size_t max_distance) const;
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_SEARCH_EDIT_DISTANCE_MATCHER_H
@@ -0,0 +1,45 @@
+#ifndef CORE_STORAGE_MEMORY_MAPPED_FILE_H
+#define CORE_STORAGE_MEMORY_MAPPED_FILE_H
+
+#include <string>
+
+namespace passwordcontainer {
+
+// Maps a whole file into memory read only. The operating system only reads the
+// pages that are actually touched and can drop them again when memory is
+// short, so files much larger than RAM can be searched without loading them.
+class MemoryMappedFile {
+ public:
+  // Maps the file at file_path. Throws an invalid_argument exception if the
+  // file can't be opened or mapped.
+  explicit MemoryMappedFile(const std::string& file_path);
+
+  // Unmaps the file.
+  ~MemoryMappedFile();
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+  // Returns the first byte of the file, or null if the file is empty.
+  const char* GetData() const;
+
+  // Returns the number of bytes in the file.
+  size_t GetSize() const;
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+
+#ifdef _WIN32
+  // The handles of the file and of its mapping
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#endif
+
+  // Unmaps the file and closes everything that was opened.
+  void Close();
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_STORAGE_MEMORY_MAPPED_FILE_H
@@ -0,0 +1,104 @@
+#ifndef CORE_STORAGE_STRING_ARENA_H
+#define CORE_STORAGE_STRING_ARENA_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace passwordcontainer {
+
+// A read only view of characters that are owned by something else (like a
+// StringArena). Only valid while the owner is alive and unchanged.
+struct StringRef {
+  const char* data = nullptr;
+  size_t size = 0;
+
+  StringRef() = default;
+  StringRef(const char* data, size_t size);
+
+  // Returns a copy of the characters as a string.
+  std::string ToString() const;
+
+  bool operator==(const StringRef& other) const;
+  bool operator!=(const StringRef& other) const;
+  bool operator==(const std::string& other) const;
+  bool operator!=(const std::string& other) const;
+};
+
+// Stores many strings packed one after another in a few large blocks instead
+// of one heap allocation per string. Strings are referred to by small Handles
+// and can't be changed or freed one at a time, only appended or cleared all at
+// once. Blocks are never moved, so StringRefs stay valid until Clear.
+class StringArena {
+ public:
+  // Refers to a string in the arena. Only 12 bytes, compared to the 32 bytes of
+  // a std::string plus its own heap allocation.
+  struct Handle {
+    uint32_t block = 0;
+    uint32_t offset = 0;
+    uint32_t length = 0;
+  };
+
+  // The default number of bytes in a block
+  static const size_t kDefaultBlockSize = 1 << 20;
+
+  // Creates a new empty StringArena that allocates blocks of block_size bytes
+  // (or bigger if a string doesn't fit). Throws an invalid_argument exception
+  // if block_size is 0.
+  explicit StringArena(size_t block_size = kDefaultBlockSize);
+
+  // Copies only the used bytes of every block, so Handles from other are valid
+  // in the copy.
+  StringArena(const StringArena& other);
+  StringArena& operator=(StringArena other);
+  StringArena(StringArena&& other);
+
+  // Copies the passed in str to the end of the arena and returns its Handle.
+  // Throws an invalid_argument exception if str is too long for a Handle.
+  Handle Append(const std::string& str);
+  Handle Append(const char* data, size_t length);
+
+  // Returns a view of the string the passed in handle refers to.
+  StringRef Get(const Handle& handle) const;
+
+  // Makes sure byte_count more bytes can be appended without allocating more
+  // than one block.
+  void Reserve(size_t byte_count);
+
+  // Frees every block. All Handles and StringRefs become invalid.
+  void Clear();
+
+  // Returns the number of bytes taken by strings that were appended.
+  size_t GetUsedBytes() const;
+
+  // Returns the number of bytes allocated for blocks.
+  size_t GetAllocatedBytes() const;
+
+  // Returns the number of blocks allocated.
+  size_t GetBlockCount() const;
+
+  friend void swap(StringArena& first, StringArena& second);
+
+ private:
+  // One contiguous allocation that strings are appended to
+  struct Block {
+    std::unique_ptr<char[]> data;
+    size_t capacity;
+    size_t used;
+  };
+
+  std::vector<Block> blocks_;
+  size_t block_size_;
+
+  size_t used_bytes_ = 0;
+  size_t allocated_bytes_ = 0;
+
+  // Allocates a new block that can hold at least capacity bytes and makes it
+  // the block that strings are appended to.
+  void AddBlock(size_t capacity);
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_STORAGE_STRING_ARENA_H
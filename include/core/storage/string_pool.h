@@ -0,0 +1,80 @@
+#ifndef CORE_STORAGE_STRING_POOL_H
+#define CORE_STORAGE_STRING_POOL_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace passwordcontainer {
+
+// Interns strings so that every distinct string is only stored once no matter
+// how many times it is used. Interned strings are referred to by small ids and
+// counted, so a string is freed once nothing uses it anymore.
+class StringPool {
+ public:
+  // The id type, 4 bytes instead of the 32 bytes of a std::string
+  typedef uint32_t Id;
+
+  // Returned by Find when the string isn't in the pool
+  static const Id kNoId = static_cast<Id>(-1);
+
+  StringPool() = default;
+
+  // Copies keep the same ids as the original pool.
+  StringPool(const StringPool& other);
+  StringPool& operator=(StringPool other);
+  StringPool(StringPool&& other) = default;
+
+  // Returns the id of the passed in str, adding it to the pool if it isn't in
+  // it already, and counts one more use of it.
+  Id Intern(const std::string& str);
+
+  // Counts one use of the string with the passed in id less and frees it if it
+  // isn't used anymore. Throws an invalid_argument exception if id isn't in
+  // the pool.
+  void Release(Id id);
+
+  // Returns the string with the passed in id. Throws an invalid_argument
+  // exception if id isn't in the pool.
+  const std::string& Get(Id id) const;
+
+  // Returns the id of the passed in str or kNoId if it isn't in the pool. Does
+  // not count a use of the string.
+  Id Find(const std::string& str) const;
+
+  // Returns the number of uses of the string with the passed in id. Throws an
+  // invalid_argument exception if id isn't in the pool.
+  size_t GetUseCount(Id id) const;
+
+  // Returns the number of distinct strings in the pool.
+  size_t GetSize() const;
+
+  // Removes every string from the pool.
+  void Clear();
+
+  friend void swap(StringPool& first, StringPool& second);
+
+ private:
+  // The id of a string and the number of times it is used
+  struct Entry {
+    Id id;
+    size_t use_count;
+  };
+
+  // Every distinct string, which is also the only copy of the string
+  std::unordered_map<std::string, Entry> entries_;
+
+  // Points to the key in entries_ for every id. Freed ids point to null and
+  // are kept in free_ids_ to be reused.
+  std::vector<const std::string*> strings_;
+  std::vector<Id> free_ids_;
+
+  // Throws an invalid_argument exception if the passed in id isn't in the
+  // pool.
+  void CheckId(Id id) const;
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_STORAGE_STRING_POOL_H
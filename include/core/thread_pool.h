@@ -0,0 +1,66 @@
+#ifndef CORE_THREAD_POOL_H
+#define CORE_THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace passwordcontainer {
+
+// A fixed size pool of worker threads that runs submitted tasks in the order
+// that they were submitted. Used to split large pieces of work (like
+// encrypting a big container) across all cores of the machine.
+class ThreadPool {
+ public:
+  // Creates a new ThreadPool with thread_count worker threads. A thread_count
+  // of 0 creates one worker for every hardware thread on the machine.
+  explicit ThreadPool(size_t thread_count);
+
+  // Finishes all queued tasks and joins all the worker threads.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Queues the passed in task to be run by one of the workers. Returns a future
+  // that becomes ready once the task has run. Any exception thrown by the task
+  // is rethrown when get() is called on the future.
+  std::future<void> Submit(const std::function<void()>& task);
+
+  // Splits the range [0, count) into contiguous pieces and calls body(begin,
+  // end) for each piece, using the workers and the calling thread. Every piece
+  // boundary is a multiple of granularity. Blocks until all pieces are done and
+  // rethrows the first exception thrown by body.
+  //
+  // Must not be called from a task that is running in this pool.
+  void ParallelFor(size_t count, size_t granularity,
+                   const std::function<void(size_t, size_t)>& body);
+
+  // Returns the number of worker threads in the pool.
+  size_t GetThreadCount() const;
+
+ private:
+  // The threads that are running the queued tasks
+  std::vector<std::thread> workers_;
+
+  // The tasks that are waiting for a worker
+  std::queue<std::packaged_task<void()>> tasks_;
+
+  // Guards tasks_ and is_stopping_
+  std::mutex tasks_mutex_;
+  // Used to wake up workers when a task is queued or the pool is stopping
+  std::condition_variable tasks_available_;
+  // Set when the pool is being destroyed
+  bool is_stopping_ = false;
+
+  // The loop each worker runs until the pool is destroyed.
+  void RunWorker();
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_THREAD_POOL_H
@@ -27,10 +27,14 @@ int GenerateRandomInt(int min, int max);
 std::string GenerateRandomPassword(size_t password_length);
 
 // Generates a char* vector from an input string vector.
-std::vector<char*> ConvertStringVecToCharVec(std::vector<std::string> &input);
+std::vector<const char*> ConvertStringVecToCharVec(
+    const std::vector<std::string> &input);
 
-// Copies the passed in string to the clipboard.
+#ifdef _WIN32
+// Copies the passed in string to the clipboard. Only built on Windows since it
+// uses the Win32 clipboard.
 void CopyToClipboard(const std::string &s);
+#endif
 
 }  // namespace util
 
@@ -0,0 +1,56 @@
+#ifndef CORE_VAULT_HEADER_H
+#define CORE_VAULT_HEADER_H
+
+#include <iostream>
+#include <string>
+
+namespace passwordcontainer {
+
+// The plain text line written at the start of a save file before the encrypted
+// data. It holds the parameters used to derive the cipher key from the user's
+// key and a check value for the key so that a wrong key can be rejected before
+// any of the data is decrypted.
+//
+// The line starts with kMagic followed by space separated name=value fields.
+// Fields that aren't known are ignored so newer files can still be read. Save
+// files from before the header existed only contain digits, which is how they
+// are told apart from files with a header.
+struct VaultHeader {
+  // The token every header line starts with
+  static const std::string kMagic;
+
+  // The check value of the key the data was encrypted with
+  std::string key_check;
+
+  // The number of PBKDF2 iterations used to derive the cipher key. 0 means the
+  // key wasn't stretched (files written before key stretching existed).
+  size_t kdf_iterations = 0;
+
+  // The hex encoded salt used when deriving the cipher key
+  std::string kdf_salt;
+
+  // Whether the encrypted data starts with a table of every distinct username
+  // that the accounts refer to by index instead of storing their usernames
+  bool has_username_table = false;
+
+  // Returns true if the passed in input starts with a header. Doesn't consume
+  // any of the input.
+  static bool IsPresent(std::istream& input);
+
+  // Overloaded >> operator used to read the header line from the input.
+  //
+  // Takes in an istream called input that is positioned at the start of the
+  // header and a VaultHeader called header that the fields are read into.
+  // Throws an invalid_argument exception if the header line is malformed or
+  // its iterations are outside of the range key derivation allows.
+  friend std::istream& operator>>(std::istream& input, VaultHeader& header);
+
+  // Overloaded << operator used to write the header line (including the
+  // trailing new line) to the output.
+  friend std::ostream& operator<<(std::ostream& output,
+                                  const VaultHeader& header);
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_VAULT_HEADER_H
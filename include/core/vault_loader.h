@@ -0,0 +1,82 @@
+#ifndef CORE_VAULT_LOADER_H
+#define CORE_VAULT_LOADER_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "core/password_container.h"
+
+namespace passwordcontainer {
+
+// Loads a save file into a new container on a worker thread, so the thread
+// that starts the load (like the GUI's update loop) never waits for the key to
+// be derived or the file to be decrypted. The progress of the load can be read
+// and the load can be canceled while it runs. Once it finishes, the loaded
+// container is swapped into the container in use in one step, so nothing ever
+// sees a partly loaded container.
+class VaultLoader {
+ public:
+  // Creates a new VaultLoader whose containers use the passed in character
+  // offset and decrypt on thread_count threads once the data is at least
+  // serial_threshold characters long (see SetCryptographerParallelism).
+  VaultLoader(size_t offset, size_t thread_count, size_t serial_threshold);
+
+  // Cancels the running load and waits for it to stop.
+  ~VaultLoader();
+
+  VaultLoader(const VaultLoader&) = delete;
+  VaultLoader& operator=(const VaultLoader&) = delete;
+
+  // Starts loading the save file at file_path with the passed in key on a
+  // worker thread. Drops a finished load that was never taken. Throws an
+  // invalid_argument exception if a load is still running.
+  void Start(const std::string& file_path, const std::string& key);
+
+  // Asks the running load to stop after the chunk it is decrypting.
+  void Cancel();
+
+  // Returns whether a load is running.
+  bool IsLoading() const;
+
+  // Returns the number of bytes of the file the running or last load read and
+  // the size of the file, which is 0 until the first chunk is read.
+  size_t GetReadBytes() const;
+  size_t GetTotalBytes() const;
+
+  // Swaps the container of the load that finished into the passed in
+  // container in constant time and returns true. Returns false if no load
+  // finished since this was last called or the load was canceled. Throws an
+  // invalid_argument exception with the error of a load that failed, such as
+  // a wrong key.
+  bool TakeLoadedContainer(PasswordContainer& container);
+
+ private:
+  // The settings of the containers that are loaded
+  size_t offset_;
+  size_t thread_count_;
+  size_t serial_threshold_;
+
+  // The thread the load runs on. Joinable until the load is taken.
+  std::thread worker_;
+
+  std::atomic<bool> is_loading_;
+  std::atomic<bool> is_cancel_requested_;
+  std::atomic<size_t> read_bytes_;
+  std::atomic<size_t> total_bytes_;
+
+  // The container the last load finished with, or the error it failed with.
+  // Only written by the worker, and only read once it was joined.
+  std::shared_ptr<PasswordContainer> loaded_container_;
+  std::string error_message_;
+  bool has_error_ = false;
+
+  // Loads the file at file_path with key into a new container. Runs on
+  // worker_.
+  void Load(const std::string& file_path, const std::string& key);
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_VAULT_LOADER_H
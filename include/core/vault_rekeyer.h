@@ -0,0 +1,71 @@
+#ifndef CORE_VAULT_REKEYER_H
+#define CORE_VAULT_REKEYER_H
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "core/encryption/cryptographer.h"
+#include "core/thread_pool.h"
+
+namespace passwordcontainer {
+
+// Re-encrypts encrypted container data with a new key without ever holding all
+// of it in memory. The data is read in chunks, every chunk is decrypted with
+// the old key and encrypted with the new key on a thread pool, and the chunks
+// are written out in their original order. Only a few chunks per thread are in
+// memory at once, so the memory used doesn't depend on the size of the data.
+//
+// This works because every character is encrypted on its own, so a chunk that
+// is a whole number of encrypted characters can be handled independently of
+// the rest of the data.
+class VaultRekeyer {
+ public:
+  // Called after every chunk is written with the number of bytes of encrypted
+  // data written so far and the total number that will be written.
+  typedef std::function<void(size_t, size_t)> ProgressCallback;
+
+  // Creates a new VaultRekeyer that uses thread_count threads (0 uses every
+  // hardware thread) and reads chunk_length bytes of encrypted data at a time.
+  // Throws an invalid_argument exception if chunk_length is 0 or isn't a whole
+  // number of encrypted characters.
+  VaultRekeyer(size_t thread_count, size_t chunk_length);
+
+  // Reads the encrypted data left in input, which must be total_length bytes
+  // long, and writes the same data encrypted with new_cryptographer to output.
+  // The cryptographers must not have parallel processing turned on. Calls
+  // progress (if it isn't empty) after every chunk.
+  //
+  // Throws an invalid_argument exception if the data is bad or can't be
+  // written. Nothing is left running when this returns or throws.
+  void Reencrypt(std::istream& input, std::ostream& output,
+                 const Cryptographer& old_cryptographer,
+                 const Cryptographer& new_cryptographer, size_t total_length,
+                 const ProgressCallback& progress) const;
+
+  // Replaces the file at target_path with the file at source_path in one step,
+  // so target_path always has either the old or the new file. The new file is
+  // flushed to the disk first and gets the permissions of the file it
+  // replaces. Throws an invalid_argument exception if the file can't be
+  // replaced.
+  static void OverwriteFile(const std::string& source_path,
+                            const std::string& target_path);
+
+ private:
+  // The length that 1 encrypted character has in a file
+  const size_t kEncryptedCharacterLength = 3;
+
+  // The number of chunks per thread that can be read but not written yet
+  const size_t kChunksInFlightPerThread = 2;
+
+  // The pool the chunks are re-encrypted on
+  std::shared_ptr<ThreadPool> thread_pool_;
+
+  // The number of bytes of encrypted data in every chunk
+  size_t chunk_length_;
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_VAULT_REKEYER_H
@@ -0,0 +1,64 @@
+#ifndef CORE_VAULT_SAVER_H
+#define CORE_VAULT_SAVER_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "core/password_container.h"
+
+namespace passwordcontainer {
+
+// Saves a snapshot of a container on a worker thread, so the thread that
+// starts the save (like the GUI's update loop) only waits for the accounts to
+// be copied and never for the key to be derived, the data to be encrypted, or
+// the file to be written. The file is written next to the save file first and
+// then replaces it in one step, so a failed save never leaves half a file.
+class VaultSaver {
+ public:
+  VaultSaver();
+
+  // Waits for the running save to finish so the file is never cut off.
+  ~VaultSaver();
+
+  VaultSaver(const VaultSaver&) = delete;
+  VaultSaver& operator=(const VaultSaver&) = delete;
+
+  // Takes a snapshot of the passed in container and starts writing it to
+  // file_path on a worker thread. The container can be changed as soon as
+  // this returns. Throws an invalid_argument exception if a save is still
+  // running.
+  void Start(const PasswordContainer& container, const std::string& file_path);
+
+  // Returns whether a save is running.
+  bool IsSaving() const;
+
+  // Returns true once for every save that finished since this was last
+  // called. Throws an invalid_argument exception with the error of a save
+  // that failed, which leaves the file as it was.
+  bool FinishSave();
+
+ private:
+  // Added to the save file's path for the file the snapshot is written to
+  // before it replaces the save file
+  const std::string kTemporaryExtension = ".save";
+
+  // The thread the save runs on. Joinable until the save is finished.
+  std::thread worker_;
+
+  std::atomic<bool> is_saving_;
+
+  // The error the last save failed with. Only written by the worker, and only
+  // read once it was joined.
+  std::string error_message_;
+  bool has_error_ = false;
+
+  // Writes the passed in snapshot to file_path. Runs on worker_.
+  void Save(std::shared_ptr<PasswordContainer::Snapshot> snapshot,
+            const std::string& file_path);
+};
+
+}  // namespace passwordcontainer
+
+#endif  // CORE_VAULT_SAVER_H
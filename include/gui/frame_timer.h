@@ -0,0 +1,51 @@
+#ifndef GUI_FRAME_TIMER_H
+#define GUI_FRAME_TIMER_H
+
+#include <chrono>
+#include <vector>
+
+namespace passwordcontainer {
+
+namespace gui {
+
+// Measures how long the app spends on each frame and keeps the times of the
+// most recent frames, so the average and slowest frame time can be shown while
+// the app runs.
+class FrameTimer {
+ public:
+  // Creates a FrameTimer that keeps the times of the last frame_count frames.
+  // Throws an invalid_argument exception if frame_count is 0.
+  explicit FrameTimer(size_t frame_count);
+
+  // Starts timing a frame.
+  void StartFrame();
+
+  // Stops timing the frame that was started last and records its time.
+  void EndFrame();
+
+  // Records a frame that took the passed in number of milliseconds.
+  void RecordFrame(double milliseconds);
+
+  // Returns the average and the longest time of the recorded frames in
+  // milliseconds, or 0 if no frame was recorded yet.
+  double GetAverageMilliseconds() const;
+  double GetMaxMilliseconds() const;
+
+  // Returns the number of frames the average and longest time are taken over.
+  size_t GetFrameCount() const;
+
+ private:
+  // The times of the recorded frames. Once it is full, the oldest time at
+  // next_frame_ is replaced.
+  std::vector<double> frame_milliseconds_;
+  size_t frame_count_;
+  size_t next_frame_ = 0;
+
+  std::chrono::steady_clock::time_point frame_start_;
+};
+
+}  // namespace gui
+
+}  // namespace passwordcontainer
+
+#endif  // GUI_FRAME_TIMER_H
@@ -9,11 +9,16 @@
 #include <string>
 
 #include "core/password_container.h"
+#include "core/vault_loader.h"
+#include "core/vault_saver.h"
+#include "gui/frame_timer.h"
+#include "gui/redraw_scheduler.h"
 #include "gui/window/account_details_window.h"
 #include "gui/window/account_list_window.h"
 #include "gui/window/add_account_window.h"
 #include "gui/window/change_key_window.h"
 #include "gui/window/enter_key_window.h"
+#include "gui/window/frame_time_window.h"
 #include "gui/window/modify_account_window.h"
 
 namespace passwordcontainer {
@@ -25,6 +30,21 @@ const std::string kSaveFileLocation = "Passwords.pwords";
 // The default key and offset used for creating a new file
 const std::string kDefaultKey = "key";
 const int kDefaultOffset = 100;
+// The number of threads used to encrypt/decrypt large save files (0 uses every
+// hardware thread) and the number of encrypted characters the data needs before
+// it is split across those threads
+const size_t kEncryptionThreadCount = 0;
+const size_t kParallelEncryptionThreshold = 1 << 20;
+
+// The number of recent frames the frame time window averages over
+const size_t kTimedFrameCount = 120;
+
+// The frame rate used while anything can change and the one used once nothing
+// changed for kSettleFrameCount frames. Input while idle is drawn by the next
+// idle frame at the latest, which goes back to the full frame rate.
+const float kActiveFrameRate = 60;
+const float kIdleFrameRate = 10;
+const size_t kSettleFrameCount = 30;
 
 class PasswordContainerApp : public ci::app::App {
  public:
@@ -36,10 +56,23 @@ class PasswordContainerApp : public ci::app::App {
   void draw() override;
   void update() override;
 
+  // Overridden Cinder input handlers that wake the app up from being idle.
+  void mouseDown(ci::app::MouseEvent event) override;
+  void mouseUp(ci::app::MouseEvent event) override;
+  void mouseMove(ci::app::MouseEvent event) override;
+  void mouseDrag(ci::app::MouseEvent event) override;
+  void mouseWheel(ci::app::MouseEvent event) override;
+  void keyDown(ci::app::KeyEvent event) override;
+  void keyUp(ci::app::KeyEvent event) override;
+  void resize() override;
+
  private:
   // The container used to store account information
   PasswordContainer container_;
 
+  // Saves the container off the main thread when save is pressed
+  VaultSaver vault_saver_;
+
   // The account list object used as the main window
   window::AccountListWindow account_list_;
   // The window used when modifying the an account
@@ -50,21 +83,40 @@ class PasswordContainerApp : public ci::app::App {
   window::AddAccountWindow add_account_window_;
   // The window used to change the key
   window::ChangeKeyWindow change_key_window_;
-  // The window used to enter the key when starting the app
+  // Loads the save file off the main thread once the key is entered, and the
+  // window used to enter the key when starting the app
+  VaultLoader vault_loader_;
   window::EnterKeyWindow enter_key_window_;
 
+  // Times every frame from the start of update to the end of draw, and the
+  // window that shows those times
+  FrameTimer frame_timer_;
+  window::FrameTimeWindow frame_time_window_;
+
+  // Decides when the windows need to be updated and drawn at the full frame
+  // rate, and whether the idle frame rate is being used
+  RedrawScheduler redraw_scheduler_;
+  bool is_idle_frame_rate_used_ = false;
+
   // Booleans to track the action the user expects to be executed
   bool is_modification_requested_ = false;
   bool is_addition_requested_ = false;
   bool is_key_change_requested_ = false;
   bool is_file_decrypted_ = false;
 
-  // The index of the selected item in the list of accounts. Defaults to a value
-  // where there is no account selected.
-  int selected_item_ = window::kNoAccountSelectedIndex;
+  // The handle of the account selected in the list of accounts. Defaults to a
+  // handle that doesn't refer to any account, so no account is selected.
+  PasswordContainer::AccountHandle selected_account_;
 
   // Constants for the window size
   const double kWindowSize = 600;
+
+  // Marks the frame as out of date and goes back to the full frame rate.
+  void InvalidateFrame();
+
+  // Switches between the full and the idle frame rate if the app started or
+  // stopped being idle.
+  void UpdateFrameRate();
 };
 
 }  // namespace gui
@@ -0,0 +1,58 @@
+#ifndef GUI_REDRAW_SCHEDULER_H
+#define GUI_REDRAW_SCHEDULER_H
+
+#include <cstddef>
+
+namespace passwordcontainer {
+
+namespace gui {
+
+// Tracks whether what the app shows can still change, so the app can stop
+// updating its windows and draw less often while nothing happens. Input, a
+// change to the accounts, or a job running in the background invalidates the
+// frame, and the app only counts as idle once settle_frame_count frames were
+// drawn after the last invalidation (which leaves time for the windows to
+// react to the last input).
+class RedrawScheduler {
+ public:
+  // Creates a RedrawScheduler that waits for settle_frame_count frames after
+  // the last invalidation before the app is idle. Starts out invalidated.
+  // Throws an invalid_argument exception if settle_frame_count is 0.
+  explicit RedrawScheduler(size_t settle_frame_count);
+
+  // Marks what the app shows as out of date.
+  void Invalidate();
+
+  // Invalidates the frame if the passed in revision of the accounts differs
+  // from the one passed in last time.
+  void CheckRevision(size_t revision);
+
+  // Counts a frame that was drawn.
+  void EndFrame();
+
+  // Returns whether settle_frame_count frames were drawn since the last
+  // invalidation.
+  bool IsIdle() const;
+
+  // Returns the number of frames drawn while the app was idle and the number
+  // of frames drawn in total.
+  size_t GetIdleFrameCount() const;
+  size_t GetFrameCount() const;
+
+ private:
+  size_t settle_frame_count_;
+
+  // The number of frames drawn since the last invalidation
+  size_t frames_since_invalidation_ = 0;
+
+  size_t last_revision_ = 0;
+
+  size_t idle_frame_count_ = 0;
+  size_t frame_count_ = 0;
+};
+
+}  // namespace gui
+
+}  // namespace passwordcontainer
+
+#endif  // GUI_REDRAW_SCHEDULER_H
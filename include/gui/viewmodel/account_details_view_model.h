@@ -0,0 +1,52 @@
+#ifndef GUI_VIEWMODEL_ACCOUNT_DETAILS_VIEW_MODEL_H
+#define GUI_VIEWMODEL_ACCOUNT_DETAILS_VIEW_MODEL_H
+
+#include <string>
+
+#include "core/password_container.h"
+
+namespace passwordcontainer {
+
+namespace gui {
+
+namespace viewmodel {
+
+// The state behind the account details window, kept apart from Cinder and
+// ImGui so it can be tested and benchmarked without a display. Holds the
+// details of the selected account and only copies them again when the
+// selection or the accounts change.
+class AccountDetailsViewModel {
+ public:
+  // Creates a view model that shows the details of the account the passed in
+  // handle refers to.
+  AccountDetailsViewModel(const PasswordContainer& container,
+                          const PasswordContainer::AccountHandle& account);
+
+  // Copies the details of the account again if the handle or the accounts
+  // changed since the last call. Returns whether the handle refers to an
+  // account, which is the only time the details are valid.
+  bool Update();
+
+  // Returns the details of the account and the rating and entropy of its
+  // password.
+  const PasswordContainer::AccountDetails& GetAccount() const;
+  const std::string& GetStrength() const;
+
+ private:
+  const PasswordContainer& container_;
+  const PasswordContainer::AccountHandle& account_;
+
+  // The details of shown_account_ when the container was at shown_revision_
+  PasswordContainer::AccountDetails details_;
+  std::string strength_;
+  PasswordContainer::AccountHandle shown_account_;
+  size_t shown_revision_ = 0;
+};
+
+}  // namespace viewmodel
+
+}  // namespace gui
+
+}  // namespace passwordcontainer
+
+#endif  // GUI_VIEWMODEL_ACCOUNT_DETAILS_VIEW_MODEL_H
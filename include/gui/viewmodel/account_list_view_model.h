@@ -0,0 +1,88 @@
+#ifndef GUI_VIEWMODEL_ACCOUNT_LIST_VIEW_MODEL_H
+#define GUI_VIEWMODEL_ACCOUNT_LIST_VIEW_MODEL_H
+
+#include <string>
+#include <vector>
+
+#include "core/password_container.h"
+
+namespace passwordcontainer {
+
+namespace gui {
+
+namespace viewmodel {
+
+// The state behind the account list window, kept apart from Cinder and ImGui
+// so it can be tested and benchmarked without a display. Decides which names
+// are listed for the search, which listed row is selected, and applies a
+// requested delete to the selected account.
+class AccountListViewModel {
+ public:
+  // The row returned by GetSelectedRow when no listed account is selected
+  static const int kNoRow = -1;
+
+  // Creates a view model that lists the accounts in the passed in container
+  // and keeps the handle of the selected account in selected_account, which
+  // other windows can share.
+  AccountListViewModel(PasswordContainer& container,
+                       PasswordContainer::AccountHandle& selected_account);
+
+  // Sets the text only the listed accounts' names are close to or contain.
+  // Every account is listed if it is empty.
+  void SetSearchQuery(const std::string& search_query);
+
+  // Returns the names of the listed accounts: every name if there is no
+  // search, and otherwise the names that contain the search followed by the
+  // names closest to it. Search results are reused until the search or the
+  // accounts change.
+  const std::vector<std::string>& GetListedNames();
+
+  // Returns the row of the selected account in GetListedNames, or kNoRow if
+  // no account is selected or the search doesn't list it.
+  int GetSelectedRow();
+
+  // Selects the account listed at the passed in row. Returns whether the
+  // selected account changed, which also drops a requested delete. Throws an
+  // invalid_argument exception if there is no listed row at row.
+  bool SelectRow(int row);
+
+  // Requests deleting the selected account the next time Update is called.
+  void RequestDelete();
+
+  // Returns whether deleting the selected account was requested.
+  bool IsDeleteRequested() const;
+
+  // Applies the requested delete if an account is selected, which leaves no
+  // account selected.
+  void Update();
+
+ private:
+  // The most accounts listed for a search
+  const size_t kMaxSearchResults = 1000;
+
+  // The most accounts listed for being close to the search and the most
+  // characters they can differ from it by
+  const size_t kMaxFuzzyResults = 5;
+  const size_t kMaxFuzzyDistance = 2;
+
+  PasswordContainer& container_;
+  PasswordContainer::AccountHandle& selected_account_;
+
+  std::string search_query_;
+  bool is_delete_requested_ = false;
+
+  // The accounts listed for searched_query_ when the container was at
+  // searched_revision_
+  std::vector<std::string> search_results_;
+  std::string searched_query_;
+  size_t searched_revision_ = 0;
+  bool has_search_results_ = false;
+};
+
+}  // namespace viewmodel
+
+}  // namespace gui
+
+}  // namespace passwordcontainer
+
+#endif  // GUI_VIEWMODEL_ACCOUNT_LIST_VIEW_MODEL_H
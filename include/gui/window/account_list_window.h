@@ -1,7 +1,11 @@
 #ifndef GUI_ACCOUNT_LIST_H
 #define GUI_ACCOUNT_LIST_H
 
+#include <string>
+
 #include "core/password_container.h"
+#include "core/vault_saver.h"
+#include "gui/viewmodel/account_list_view_model.h"
 #include "gui/window/window.h"
 
 namespace passwordcontainer {
@@ -14,29 +18,31 @@ namespace window {
 // bar that allows you to modify the accounts, delete the accounts, add
 // accounts, and the change the key for the encryption. It also has a list of
 // Account names that is the main interface for indicating the selected account.
+// The list and selection logic lives in an AccountListViewModel.
 class AccountListWindow : public Window {
  public:
   // Creates a new AccountListWindow object using the passed in container,
-  // booleans, and the current selected account index. Assumes that all values
+  // booleans, and the handle of the selected account. Assumes that all values
   // are valid when creating objects.
   //
   // Takes in a PasswordContainer object that represents the container being
   // shown on screen. Then takes in booleans for if the window should be open,
   // boolean for modifying accounts, adding accounts,
   // and for changing accounts, all in order.
-  // Takes in an int which represents the index of the account that is currently
-  // selected. Also takes in a string that represents the location of the save
-  // file.
+  // Takes in the handle of the account that is currently selected. Also takes
+  // in a string that represents the location of the save file and the saver
+  // that saves it.
   AccountListWindow(PasswordContainer& container_, bool& window_open,
                     bool& modify_bool, bool& add_bool, bool& key_change_bool,
-                    int& selected_acc_ind, const std::string& save_location);
+                    PasswordContainer::AccountHandle& selected_account,
+                    const std::string& save_location, VaultSaver& vault_saver);
 
   // Draws the window with the menu bar and a list of all accounts. Updates the
-  // values of all booleans and integers that might be used by other windows.
+  // values of all booleans and the handle that might be used by other windows.
   void DrawWindow() override;
 
   // Deletes the selected account if the delete option is pressed in the menu
-  // bar
+  // bar, and starts saving the container once for every time save is pressed
   void UpdateWindow() override;
 
  private:
@@ -44,21 +50,30 @@ class AccountListWindow : public Window {
   PasswordContainer& container_;
 
   // Booleans that represents whether a certain button is pressed in the menu
-  // bar
+  // bar. Deleting is requested through view_model_.
   bool& modify_account_pressed_;
-  bool delete_account_pressed_ = false;
   bool& add_account_pressed_;
   bool& change_key_pressed_;
   bool save_pressed_ = false;
   // Boolean that checks if the window should be open or not
   bool& window_open_;
 
-  // The index of the account that is currently selected in the list
-  int& selected_account_;
-
   // The location of the save file
   std::string save_file_location_;
 
+  // Encrypts and writes the container to the save file off the main thread,
+  // and the result of the last save that is shown under the menu bar
+  VaultSaver& vault_saver_;
+  std::string save_status_;
+
+  // The text typed in the search box. Only accounts whose names contain it are
+  // listed unless it is empty.
+  std::string search_query_;
+
+  // Decides what is listed and selected, and holds the handle of the selected
+  // account, which stops being valid if the account is deleted
+  viewmodel::AccountListViewModel view_model_;
+
   // Draws the menu bar and updates all variables that relate to the menu bar.
   void DrawMenuBar();
 
@@ -68,8 +83,8 @@ class AccountListWindow : public Window {
   // the boolean if is_clicked is true.
   void DrawMenuSubOption(bool& is_clicked, const char* option_name);
 
-  // Draws the Account list and updates all variables that relate to the
-  // account list.
+  // Draws the search box and the Account list and updates all variables that
+  // relate to the account list.
   void DrawAccountList();
 };
 
@@ -2,6 +2,7 @@
 #define GUI_WINDOW_ENTER_KEY_WINDOW_H
 
 #include "core/password_container.h"
+#include "core/vault_loader.h"
 #include "gui/window/window.h"
 
 namespace passwordcontainer {
@@ -13,15 +14,16 @@ namespace window {
 // Class that is an implementation of the Window interface. This window shows up
 // before all other windows and doesn't allow the user farther until they input
 // the correct key. The window is very simple and only has a text box and a
-// continue button.
+// continue button. The save file is loaded on the vault loader's thread while
+// the window shows its progress and a cancel button.
 class EnterKeyWindow : public Window {
  public:
   // Creates a new window to enter the key using the passed in container that
   // represents the container the data is getting loaded into and a boolean
   // representing the correct key being entered. Also takes in a string that
-  // represents the location of the save file.
+  // represents the location of the save file and the loader that loads it.
   EnterKeyWindow(PasswordContainer& container, bool& correct_key_entered,
-                 const std::string& save_location);
+                 const std::string& save_location, VaultLoader& vault_loader);
 
   // Draws and updates the values of the window
   void DrawWindow() override;
@@ -37,6 +39,11 @@ class EnterKeyWindow : public Window {
   bool wrong_key_entered_ = false;
   // Boolean that checks if the continue button was pressed
   bool continue_pressed_ = false;
+  // Boolean that checks if the cancel button was pressed while loading
+  bool cancel_pressed_ = false;
+
+  // Loads the save file without blocking the window
+  VaultLoader& vault_loader_;
 
   // The key that is being entered
   std::string entered_key_;
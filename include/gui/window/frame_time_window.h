@@ -0,0 +1,54 @@
+#ifndef GUI_WINDOW_FRAME_TIME_WINDOW_H
+#define GUI_WINDOW_FRAME_TIME_WINDOW_H
+
+#include <string>
+
+#include "core/password_container.h"
+#include "gui/frame_timer.h"
+#include "gui/redraw_scheduler.h"
+#include "gui/window/window.h"
+
+namespace passwordcontainer {
+
+namespace gui {
+
+namespace window {
+
+// This class is an implementation of the Window interface that shows how long
+// the recent frames took next to the number of accounts in the container, so
+// the cost of drawing large containers can be seen while the app runs. Also
+// shows how many frames were drawn while the app was idle.
+class FrameTimeWindow : public Window {
+ public:
+  // Creates a new FrameTimeWindow that shows the times measured by the passed
+  // in frame_timer for the passed in container, and the idle frames counted by
+  // the passed in redraw_scheduler.
+  FrameTimeWindow(const PasswordContainer& container,
+                  const FrameTimer& frame_timer,
+                  const RedrawScheduler& redraw_scheduler);
+
+  // Draws the window with the last measured frame times.
+  void DrawWindow() override;
+
+  // Updates the text of the window from the frame timer.
+  void UpdateWindow() override;
+
+ private:
+  const PasswordContainer& container_;
+  const FrameTimer& frame_timer_;
+  const RedrawScheduler& redraw_scheduler_;
+
+  // The text showing the frame times, the number of accounts, and the number
+  // of idle frames
+  std::string frame_time_text_;
+  std::string account_count_text_;
+  std::string idle_frame_text_;
+};
+
+}  // namespace window
+
+}  // namespace gui
+
+}  // namespace passwordcontainer
+
+#endif  // GUI_WINDOW_FRAME_TIME_WINDOW_H
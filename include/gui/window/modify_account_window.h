@@ -22,10 +22,9 @@ class ModifyAccountWindow : public Window {
  public:
   // Creates a new Modify Window object with the passed in container and the
   // boolean that represents whether the window should be shown or not. Also
-  // takes in an int that represents the account_index of the account being
-  // modified.
+  // takes in the handle of the account being modified.
   ModifyAccountWindow(PasswordContainer& container, bool& window_active,
-                      int& account_index);
+                      const PasswordContainer::AccountHandle& account);
 
   // Draws the window to modify the account that is currently selected in the
   // container and updates the new_username and new_password parameters.
@@ -60,8 +59,8 @@ class ModifyAccountWindow : public Window {
   // The length of the random password to be generated
   int generate_password_length_ = kGeneratePasswordMinLength;
 
-  // The index of the account that is having its details modified.
-  int& account_index_;
+  // The handle of the account that is having its details modified.
+  const PasswordContainer::AccountHandle& account_;
 
   // Strings that represent the new username and password
   std::string new_username_;
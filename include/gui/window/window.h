@@ -9,6 +9,7 @@ namespace gui {
 
 namespace window {
 
+// The index ImGui list boxes use when none of their items are selected
 const int kNoAccountSelectedIndex = -1;
 
 // Interface for all windows in the app that allows them to draw the window and
@@ -1,7 +1,11 @@
 #include "cli/command_line_input.h"
 
+#include <algorithm>
 #include <fstream>
 
+#include "core/io/csv_importer.h"
+#include "core/io/json_exporter.h"
+#include "core/io/json_importer.h"
 #include "core/util.h"
 
 using std::string;
@@ -53,6 +57,8 @@ PasswordContainer CommandLineInput::GetContainer() const {
 
 void CommandLineInput::LoadContainer(const std::string& key) {
   container_ = new PasswordContainer(kDefaultOffset, key);
+  container_->SetCryptographerParallelism(kEncryptionThreadCount,
+                                          kParallelEncryptionThreshold);
 
   // Creates a new istream to read data from
   std::ifstream file_input(container_location_);
@@ -88,10 +94,38 @@ void CommandLineInput::ParseCommand(const string& command) {
     ListAccounts();
   } else if (command == kShowDetailsCommand) {
     ShowAccountDetails();
+  } else if (command == kSearchCommand) {
+    SearchAccounts();
+  } else if (command == kAccountsForUserCommand) {
+    ListAccountsForUsername();
+  } else if (command == kAuditReuseCommand) {
+    AuditPasswordReuse();
+  } else if (command == kAuditBreachesCommand) {
+    AuditBreachedPasswords();
+  } else if (command == kAuditStrengthCommand) {
+    AuditPasswordStrength();
+  } else if (command == kImportCsvCommand) {
+    ImportCsvFile();
+  } else if (command == kImportJsonCommand) {
+    ImportJsonFile();
+  } else if (command == kExportJsonCommand) {
+    ExportJsonFile();
   } else if (command == kGeneratePassCommand) {
     GeneratePassword();
   } else if (command == kKeyChangeCommand) {
     ChangeContainerKey();
+  } else if (command == kRekeyCommand) {
+    RekeyContainerFile();
+  } else if (command == kCalibrateCommand) {
+    CalibrateKeyStretching();
+  } else if (command == kPoolUsernamesCommand) {
+    ToggleUsernamePooling();
+  } else if (command == kBeginBatchCommand) {
+    BeginBatch();
+  } else if (command == kCommitBatchCommand) {
+    CommitBatch();
+  } else if (command == kCancelBatchCommand) {
+    CancelBatch();
   } else if (command == kSaveCommand) {
     SaveContainer();
   } else {
@@ -104,6 +138,14 @@ void CommandLineInput::AddSpecifiedAccount() {
   string account_name = PromptForInput("Please enter the Account Name: ");
   string username = PromptForInput("Please enter the username: ");
   string password = PromptForInput("Please enter the password: ");
+
+  // Only checks the account once the batch is committed
+  if (batch_ != nullptr) {
+    batch_->AddAccount(account_name, username, password);
+    user_output_ << "The account has been staged!" << std::endl << std::endl;
+    return;
+  }
+
   container_->AddAccount(account_name, username, password);
 
   user_output_ << "The account has been added!" << std::endl << std::endl;
@@ -112,51 +154,328 @@ void CommandLineInput::AddSpecifiedAccount() {
 void CommandLineInput::DeleteSpecifiedAccount() {
   string account_name = PromptForInput("Please enter the Account Name: ");
 
+  // The account might be added earlier in the batch, so it is only checked
+  // once the batch is committed
+  if (batch_ != nullptr) {
+    batch_->DeleteAccount(account_name);
+    user_output_ << "The deletion has been staged!" << std::endl << std::endl;
+    return;
+  }
+
   // Makes sure the container really has the account
   if (container_->HasAccount(account_name)) {
     container_->DeleteAccount(account_name);
     user_output_ << "The account has been deleted!" << std::endl << std::endl;
   } else {
-    user_output_ << "That account does not exist!" << std::endl << std::endl;
+    IndicateMissingAccount(account_name);
   }
 }
 
 void CommandLineInput::ModifySpecifiedAccount() {
   string account_name = PromptForInput("Please enter the Account Name: ");
 
-  // Leaves the function if there is no account with the passed in name
-  if (!(container_->HasAccount(account_name))) {
-    user_output_ << "That account does not exist!" << std::endl << std::endl;
+  // Leaves the function if there is no account with the passed in name. The
+  // account might be added earlier in an open batch, so it isn't checked then.
+  if (batch_ == nullptr && !(container_->HasAccount(account_name))) {
+    IndicateMissingAccount(account_name);
     return;
   }
 
   // Gets the new username and password and modifies the account
   string new_username = PromptForInput("Please enter the new username: ");
   string new_password = PromptForInput("Please enter the new password: ");
+
+  if (batch_ != nullptr) {
+    batch_->ModifyAccount(account_name, new_username, new_password);
+    user_output_ << "The change has been staged!" << std::endl << std::endl;
+    return;
+  }
+
   container_->ModifyAccount(account_name, new_username, new_password);
 
   user_output_ << "The account has been modified!" << std::endl << std::endl;
 }
 
+void CommandLineInput::BeginBatch() {
+  if (batch_ != nullptr) {
+    user_output_ << "A batch is already open!" << std::endl << std::endl;
+    return;
+  }
+
+  batch_ = std::make_shared<AccountBatch>();
+  user_output_ << "Changes will be staged until the batch is committed!"
+               << std::endl << std::endl;
+}
+
+void CommandLineInput::CommitBatch() {
+  if (batch_ == nullptr) {
+    user_output_ << "There is no open batch!" << std::endl << std::endl;
+    return;
+  }
+
+  // Closes the batch whether or not it could be committed
+  std::shared_ptr<AccountBatch> batch = batch_;
+  batch_.reset();
+
+  auto start_time = std::chrono::steady_clock::now();
+  try {
+    container_->CommitBatch(*batch);
+  } catch (const std::invalid_argument& exception) {
+    user_output_ << exception.what() << std::endl
+                 << "None of the " << batch->GetSize()
+                 << " changes were committed!" << std::endl << std::endl;
+    return;
+  }
+  auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_time);
+
+  user_output_ << "Committed " << batch->GetSize() << " changes ("
+               << elapsed_time.count() << " ms)!" << std::endl << std::endl;
+}
+
+void CommandLineInput::CancelBatch() {
+  if (batch_ == nullptr) {
+    user_output_ << "There is no open batch!" << std::endl << std::endl;
+    return;
+  }
+
+  user_output_ << "Discarded " << batch_->GetSize() << " staged changes!"
+               << std::endl << std::endl;
+  batch_.reset();
+}
+
 void CommandLineInput::ListAccounts() {
   // Lists out all accounts in the container
-  for (auto& account : container_->GetAccounts()) {
-    user_output_ << account.account_name << std::endl;
+  for (const string& account_name : container_->GetAccountNames()) {
+    user_output_ << account_name << std::endl;
+  }
+
+  user_output_ << std::endl;
+}
+
+void CommandLineInput::SearchAccounts() {
+  string query = PromptForInput("Please enter the search text: ");
+  std::vector<string> account_names = container_->SearchAccounts(query);
+
+  if (account_names.empty()) {
+    user_output_ << "No accounts found!" << std::endl << std::endl;
+    return;
+  }
+
+  // Lists the names that start with the text before the others
+  for (const string& account_name : account_names) {
+    user_output_ << account_name << std::endl;
   }
 
   user_output_ << std::endl;
 }
 
+void CommandLineInput::ListAccountsForUsername() {
+  string username = PromptForInput("Please enter the username: ");
+  std::vector<string> account_names =
+      container_->GetAccountsForUsername(username);
+
+  if (account_names.empty()) {
+    user_output_ << "No accounts use that username!" << std::endl << std::endl;
+    return;
+  }
+
+  for (const string& account_name : account_names) {
+    user_output_ << account_name << std::endl;
+  }
+
+  user_output_ << std::endl;
+}
+
+void CommandLineInput::AuditPasswordReuse() {
+  auto start_time = std::chrono::steady_clock::now();
+  std::vector<std::vector<string>> groups = container_->FindReusedPasswords();
+  auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_time);
+
+  // Lists every group of accounts that share a password on its own line
+  for (const std::vector<string>& group : groups) {
+    user_output_ << "Accounts sharing a password: ";
+    for (size_t index = 0; index < group.size(); index++) {
+      user_output_ << (index == 0 ? "" : ", ") << group[index];
+    }
+    user_output_ << std::endl;
+  }
+
+  user_output_ << "Found " << groups.size() << " reused passwords in "
+               << container_->GetAccountCount() << " accounts ("
+               << elapsed_time.count() << " ms)!" << std::endl
+               << std::endl;
+}
+
+void CommandLineInput::AuditBreachedPasswords() {
+  string corpus_location =
+      PromptForInput("Please enter the breached password list location: ");
+  if (!std::ifstream(corpus_location).is_open()) {
+    user_output_ << "There is no file in the passed in location!" << std::endl
+                 << std::endl;
+    return;
+  }
+  string bloom_filter_location = corpus_location + kBloomFilterExtension;
+
+  auto start_time = std::chrono::steady_clock::now();
+  std::vector<string> account_names;
+  try {
+    // Builds the Bloom filter the first time a list is used, which reads the
+    // whole list once
+    if (!std::ifstream(bloom_filter_location)) {
+      user_output_ << "Building a Bloom filter for the list..." << std::endl;
+      BreachedPasswordChecker::BuildBloomFilter(
+          corpus_location, bloom_filter_location,
+          kBloomFilterFalsePositiveRate);
+    }
+
+    breach_checker_ = std::make_shared<BreachedPasswordChecker>(
+        corpus_location, bloom_filter_location);
+    start_time = std::chrono::steady_clock::now();
+    account_names = container_->FindBreachedAccounts(*breach_checker_);
+  } catch (const std::invalid_argument& exception) {
+    breach_checker_.reset();
+    user_output_ << exception.what() << std::endl << std::endl;
+    return;
+  }
+  auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_time);
+
+  for (const string& account_name : account_names) {
+    user_output_ << "Breached password: " << account_name << std::endl;
+  }
+
+  user_output_ << "Found " << account_names.size()
+               << " breached passwords in " << container_->GetAccountCount()
+               << " accounts (" << elapsed_time.count() << " ms)!" << std::endl
+               << std::endl;
+}
+
+void CommandLineInput::AuditPasswordStrength() {
+  auto start_time = std::chrono::steady_clock::now();
+  std::vector<PasswordStrength> strengths = container_->ScorePasswords();
+  auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_time);
+
+  // Lists the accounts whose passwords are rated below fair
+  const std::vector<string>& account_names = container_->GetAccountNames();
+  size_t weak_count = 0;
+  for (size_t index = 0; index < strengths.size(); index++) {
+    if (strengths[index].rating < PasswordStrength::kFair) {
+      user_output_ << "Weak password: " << account_names[index] << " ("
+                   << PasswordStrengthScorer::Describe(strengths[index]) << ")"
+                   << std::endl;
+      weak_count++;
+    }
+  }
+
+  user_output_ << "Found " << weak_count << " weak passwords in "
+               << container_->GetAccountCount() << " accounts ("
+               << elapsed_time.count() << " ms)!" << std::endl
+               << std::endl;
+}
+
+void CommandLineInput::ImportCsvFile() {
+  string csv_location = PromptForInput("Please enter the CSV file location: ");
+  std::ifstream csv_input(csv_location, std::ios::binary);
+  if (!csv_input.is_open()) {
+    user_output_ << "There is no file in the passed in location!" << std::endl
+                 << std::endl;
+    return;
+  }
+
+  auto start_time = std::chrono::steady_clock::now();
+  ImportReport report;
+  try {
+    report = CsvImporter(kEncryptionThreadCount).Import(csv_input, *container_);
+  } catch (const std::invalid_argument& exception) {
+    user_output_ << exception.what() << std::endl << std::endl;
+    return;
+  }
+  auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_time);
+
+  ShowImportReport(report, elapsed_time.count());
+}
+
+void CommandLineInput::ImportJsonFile() {
+  string json_location =
+      PromptForInput("Please enter the JSON file location: ");
+  std::ifstream json_input(json_location, std::ios::binary);
+  if (!json_input.is_open()) {
+    user_output_ << "There is no file in the passed in location!" << std::endl
+                 << std::endl;
+    return;
+  }
+
+  auto start_time = std::chrono::steady_clock::now();
+  ImportReport report;
+  try {
+    report = JsonImporter::Import(json_input, *container_);
+  } catch (const std::invalid_argument& exception) {
+    user_output_ << exception.what() << std::endl << std::endl;
+    return;
+  }
+  auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_time);
+
+  ShowImportReport(report, elapsed_time.count());
+}
+
+void CommandLineInput::ExportJsonFile() {
+  string json_location =
+      PromptForInput("Please enter the JSON file location: ");
+  std::ofstream json_output(json_location, std::ios::binary);
+  if (!json_output.is_open()) {
+    user_output_ << "The passed location doesn't exist!" << std::endl
+                 << std::endl;
+    return;
+  }
+
+  JsonExporter::Export(*container_, json_output);
+
+  user_output_ << "Exported " << container_->GetAccountCount()
+               << " accounts! The file is not encrypted." << std::endl
+               << std::endl;
+}
+
+void CommandLineInput::ShowImportReport(const ImportReport& report,
+                                        long long elapsed_milliseconds) {
+  // Lists the first rows that couldn't be imported so a bad file doesn't
+  // flood the output
+  size_t listed_count = std::min(report.errors.size(), kMaxListedImportErrors);
+  for (size_t index = 0; index < listed_count; index++) {
+    user_output_ << "Line " << report.errors[index].line_number << ": "
+                 << report.errors[index].message << std::endl;
+  }
+  if (report.errors.size() > listed_count) {
+    user_output_ << "And " << report.errors.size() - listed_count
+                 << " more rows couldn't be imported!" << std::endl;
+  }
+
+  user_output_ << "Imported " << report.imported_count << " of "
+               << report.row_count << " accounts (" << elapsed_milliseconds
+               << " ms)!" << std::endl
+               << std::endl;
+}
+
 void CommandLineInput::ShowAccountDetails() {
   string account_name = PromptForInput("Please enter the account name: ");
 
   if (container_->HasAccount(account_name)) {
     // Finds the account and prints out the details
-    auto account = *(container_->FindAccount(account_name));
+    size_t index = container_->FindAccount(account_name);
+    auto account = container_->GetAccount(index);
     user_output_ << "Username: " << account.username << std::endl;
-    user_output_ << "Password: " << account.password << std::endl << std::endl;
+    user_output_ << "Password: " << account.password << std::endl;
+    user_output_ << "Strength: "
+                 << PasswordStrengthScorer::Describe(
+                        container_->GetPasswordStrength(index))
+                 << std::endl
+                 << std::endl;
   } else {
-    user_output_ << "That account does not exist!" << std::endl << std::endl;
+    IndicateMissingAccount(account_name);
   }
 }
 
@@ -173,8 +492,23 @@ void CommandLineInput::GeneratePassword() {
     }
   }
 
-  user_output_ << util::GenerateRandomPassword(password_size) << std::endl
-               << std::endl;
+  // Generates a new password while the last one is in the breached password
+  // list, if one was loaded by an audit. Short passwords can all be in the
+  // list, so it only tries a few times.
+  string password = util::GenerateRandomPassword(password_size);
+  bool is_breached = breach_checker_ && breach_checker_->IsBreached(password);
+  for (size_t attempt = 1; is_breached && attempt < kMaxPasswordAttempts;
+       attempt++) {
+    password = util::GenerateRandomPassword(password_size);
+    is_breached = breach_checker_->IsBreached(password);
+  }
+
+  user_output_ << password << std::endl;
+  if (is_breached) {
+    user_output_ << "This password is in the breached password list!"
+                 << std::endl;
+  }
+  user_output_ << std::endl;
 }
 
 void CommandLineInput::ChangeContainerKey() {
@@ -185,6 +519,80 @@ void CommandLineInput::ChangeContainerKey() {
   user_output_ << "Key Changed!" << std::endl << std::endl;
 }
 
+void CommandLineInput::RekeyContainerFile() {
+  string new_key = PromptForInput("Please enter the new key: ");
+  size_t shown_percent = 0;
+
+  // Only shows the progress when the percentage changes
+  try {
+    container_->RekeyFile(
+        container_location_, new_key,
+        [this, &shown_percent](size_t rekeyed_length, size_t total_length) {
+          size_t percent = rekeyed_length * 100 / total_length;
+          if (percent != shown_percent) {
+            shown_percent = percent;
+            user_output_ << "Rekeying: " << percent << "%" << std::endl;
+          }
+        });
+  } catch (const std::invalid_argument& exception) {
+    user_output_ << exception.what() << std::endl << std::endl;
+    return;
+  }
+
+  user_output_ << "File Rekeyed!" << std::endl << std::endl;
+}
+
+void CommandLineInput::CalibrateKeyStretching() {
+  int target_milliseconds;
+
+  // Keeps prompting for the time until a positive integer is passed in.
+  while (true) {
+    try {
+      string input =
+          PromptForInput("Please enter the target unlock time in ms: ");
+      target_milliseconds = util::ConvertStringToInt(input);
+      if (target_milliseconds <= 0) {
+        throw std::invalid_argument("Invalid unlock time passed in!");
+      }
+      break;
+    } catch (...) {
+    }
+  }
+
+  size_t iterations = container_->CalibrateKdfIterations(
+      std::chrono::milliseconds(target_milliseconds));
+
+  user_output_ << "Key stretching now uses " << iterations << " iterations!"
+               << std::endl
+               << std::endl;
+}
+
+void CommandLineInput::ToggleUsernamePooling() {
+  bool is_enabled = !container_->IsUsernamePoolingEnabled();
+  container_->SetUsernamePooling(is_enabled);
+
+  user_output_ << "Username pooling is now " << (is_enabled ? "on" : "off")
+               << "!" << std::endl
+               << std::endl;
+}
+
+void CommandLineInput::IndicateMissingAccount(const string& account_name) {
+  user_output_ << "That account does not exist!" << std::endl;
+
+  // Suggests the names the user might have meant to type
+  std::vector<string> suggestions = container_->FindClosestAccounts(
+      account_name, kMaxSuggestions, kMaxSuggestionDistance);
+  if (!suggestions.empty()) {
+    user_output_ << "Did you mean: ";
+    for (size_t index = 0; index < suggestions.size(); index++) {
+      user_output_ << (index == 0 ? "" : ", ") << suggestions[index];
+    }
+    user_output_ << "?" << std::endl;
+  }
+
+  user_output_ << std::endl;
+}
+
 void CommandLineInput::IndicateInvalidCommand() {
   user_output_ << "Invalid Command!" << std::endl << std::endl;
 }
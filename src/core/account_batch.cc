@@ -0,0 +1,35 @@
+#include "core/account_batch.h"
+
+using std::string;
+using std::vector;
+
+namespace passwordcontainer {
+
+void AccountBatch::AddAccount(const string& account_name,
+                              const string& username, const string& password) {
+  operations_.push_back({kAdd, account_name, username, password});
+}
+
+void AccountBatch::ModifyAccount(const string& account_name,
+                                 const string& username,
+                                 const string& password) {
+  operations_.push_back({kModify, account_name, username, password});
+}
+
+void AccountBatch::DeleteAccount(const string& account_name) {
+  operations_.push_back({kDelete, account_name, "", ""});
+}
+
+const vector<AccountBatch::Operation>& AccountBatch::GetOperations() const {
+  return operations_;
+}
+
+size_t AccountBatch::GetSize() const {
+  return operations_.size();
+}
+
+void AccountBatch::Clear() {
+  operations_.clear();
+}
+
+}  // namespace passwordcontainer
@@ -0,0 +1,158 @@
+#include "core/audit/bloom_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using std::string;
+
+namespace passwordcontainer {
+
+const size_t BloomFilter::kMinimumDigestLength;
+
+namespace {
+
+// The first word of the header of a saved filter
+const string kFileSignature = "PWCBLOOM1";
+
+// Returns the little endian int in the 8 bytes starting at bytes.
+uint64_t ReadUint64(const char* bytes) {
+  uint64_t value = 0;
+  for (size_t index = 8; index > 0; index--) {
+    value = (value << 8) | static_cast<unsigned char>(bytes[index - 1]);
+  }
+
+  return value;
+}
+
+}  // namespace
+
+BloomFilter::BloomFilter(size_t bit_count, size_t hash_count)
+    : bit_count_(bit_count),
+      hash_count_(hash_count),
+      bits_((bit_count + 7) / 8, 0) {
+  if (bit_count == 0 || hash_count == 0) {
+    throw std::invalid_argument("Invalid parameters passed in to constructor!");
+  }
+
+  data_ = bits_.data();
+}
+
+BloomFilter::BloomFilter(const string& file_path)
+    : file_(new MemoryMappedFile(file_path)) {
+  // The header is one line like "PWCBLOOM1 bits=1024 hashes=7"
+  const char* data = file_->GetData();
+  size_t header_end = 0;
+  while (header_end < file_->GetSize() && data[header_end] != '\n') {
+    header_end++;
+  }
+  if (header_end == file_->GetSize()) {
+    throw std::invalid_argument("Bad Bloom filter file passed in!");
+  }
+
+  std::istringstream header(string(data, header_end));
+  string signature, bits_field, hashes_field;
+  header >> signature >> bits_field >> hashes_field;
+  if (signature != kFileSignature || bits_field.compare(0, 5, "bits=") != 0 ||
+      hashes_field.compare(0, 7, "hashes=") != 0) {
+    throw std::invalid_argument("Bad Bloom filter file passed in!");
+  }
+
+  try {
+    bit_count_ = static_cast<size_t>(std::stoull(bits_field.substr(5)));
+    hash_count_ = static_cast<size_t>(std::stoull(hashes_field.substr(7)));
+  } catch (...) {
+    throw std::invalid_argument("Bad Bloom filter file passed in!");
+  }
+
+  if (bit_count_ == 0 || hash_count_ == 0 ||
+      file_->GetSize() - header_end - 1 != (bit_count_ + 7) / 8) {
+    throw std::invalid_argument("Bad Bloom filter file passed in!");
+  }
+
+  data_ = reinterpret_cast<const unsigned char*>(data + header_end + 1);
+}
+
+size_t BloomFilter::GetOptimalBitCount(size_t item_count,
+                                       double false_positive_rate) {
+  // m = -n ln(p) / ln(2)^2
+  double bits = -static_cast<double>(item_count) *
+                std::log(false_positive_rate) / (std::log(2.0) * std::log(2.0));
+
+  return std::max<size_t>(8, static_cast<size_t>(std::ceil(bits)));
+}
+
+size_t BloomFilter::GetOptimalHashCount(size_t bit_count, size_t item_count) {
+  // k = m / n ln(2)
+  double hashes = static_cast<double>(bit_count) /
+                  std::max<size_t>(1, item_count) * std::log(2.0);
+
+  return std::max<size_t>(1, static_cast<size_t>(std::round(hashes)));
+}
+
+void BloomFilter::Add(const string& digest) {
+  if (file_) {
+    throw std::invalid_argument("Can't add to a Bloom filter file!");
+  }
+
+  ForEachBit(digest, [this](uint64_t bit) {
+    bits_[bit / 8] |= static_cast<unsigned char>(1 << (bit % 8));
+    return true;
+  });
+}
+
+bool BloomFilter::MightContain(const string& digest) const {
+  return ForEachBit(digest, [this](uint64_t bit) {
+    return (data_[bit / 8] & (1 << (bit % 8))) != 0;
+  });
+}
+
+void BloomFilter::Save(const string& file_path) const {
+  std::ofstream file(file_path, std::ios::binary);
+  if (!file) {
+    throw std::invalid_argument("The passed location doesn't exist!");
+  }
+
+  file << kFileSignature << " bits=" << bit_count_ << " hashes=" << hash_count_
+       << '\n';
+  file.write(reinterpret_cast<const char*>(data_),
+             static_cast<std::streamsize>((bit_count_ + 7) / 8));
+
+  if (!file) {
+    throw std::invalid_argument("Could not write the Bloom filter!");
+  }
+}
+
+size_t BloomFilter::GetBitCount() const {
+  return bit_count_;
+}
+
+size_t BloomFilter::GetHashCount() const {
+  return hash_count_;
+}
+
+template <typename Visitor>
+bool BloomFilter::ForEachBit(const string& digest, Visitor visit) const {
+  if (digest.size() < kMinimumDigestLength) {
+    throw std::invalid_argument("Digest is too short!");
+  }
+
+  // Double hashing: the bits are first + i * second for i below hash_count_,
+  // with both halves taken from the digest. second is odd so it never sticks
+  // on one bit.
+  uint64_t first = ReadUint64(digest.data());
+  uint64_t second = ReadUint64(digest.data() + 8) | 1;
+
+  for (size_t index = 0; index < hash_count_; index++) {
+    if (!visit((first + index * second) % bit_count_)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace passwordcontainer
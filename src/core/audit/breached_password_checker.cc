@@ -0,0 +1,220 @@
+#include "core/audit/breached_password_checker.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "core/encryption/sha1.h"
+
+using std::string;
+
+namespace passwordcontainer {
+
+const size_t BreachedPasswordChecker::kLinearSearchBytes;
+
+namespace {
+
+// The number of hex characters in a SHA-1 hash
+const size_t kHexDigestLength = kSha1DigestLength * 2;
+
+// One line of the list
+struct CorpusLine {
+  string digest;
+  size_t count;
+  // The position of the line after this one
+  size_t next_line;
+};
+
+// Returns the value of the passed in hex character. Throws an invalid_argument
+// exception if it isn't a hex character.
+int ParseHexCharacter(char character) {
+  if (character >= '0' && character <= '9') {
+    return character - '0';
+  }
+  if (character >= 'a' && character <= 'f') {
+    return character - 'a' + 10;
+  }
+  if (character >= 'A' && character <= 'F') {
+    return character - 'A' + 10;
+  }
+
+  throw std::invalid_argument("Bad breach file passed in!");
+}
+
+// Reads the line that starts at position in the data with size bytes. Throws
+// an invalid_argument exception if the line is malformed.
+CorpusLine ReadLine(const char* data, size_t size, size_t position) {
+  if (size - position < kHexDigestLength) {
+    throw std::invalid_argument("Bad breach file passed in!");
+  }
+
+  CorpusLine line;
+  line.digest.resize(kSha1DigestLength);
+  for (size_t index = 0; index < kSha1DigestLength; index++) {
+    line.digest[index] = static_cast<char>(
+        ParseHexCharacter(data[position + index * 2]) * 16 +
+        ParseHexCharacter(data[position + index * 2 + 1]));
+  }
+  position += kHexDigestLength;
+
+  // Lines without a count count as seen once
+  line.count = 1;
+  if (position < size && data[position] == ':') {
+    line.count = 0;
+    for (position++; position < size && data[position] >= '0' &&
+                     data[position] <= '9';
+         position++) {
+      line.count = line.count * 10 + (data[position] - '0');
+    }
+  }
+
+  // Skips the \r of files with Windows line endings
+  if (position < size && data[position] == '\r') {
+    position++;
+  }
+  if (position < size && data[position] != '\n') {
+    throw std::invalid_argument("Bad breach file passed in!");
+  }
+
+  line.next_line = position < size ? position + 1 : size;
+  return line;
+}
+
+// Returns the first 8 bytes of the passed in digest as a big endian int, which
+// is where the digest falls between the smallest and largest digests.
+uint64_t GetDigestKey(const string& digest) {
+  uint64_t key = 0;
+  for (size_t index = 0; index < 8; index++) {
+    key = (key << 8) | static_cast<unsigned char>(digest[index]);
+  }
+
+  return key;
+}
+
+}  // namespace
+
+BreachedPasswordChecker::BreachedPasswordChecker(
+    const string& corpus_path, const string& bloom_filter_path)
+    : corpus_(corpus_path) {
+  if (!bloom_filter_path.empty()) {
+    bloom_filter_.reset(new BloomFilter(bloom_filter_path));
+  }
+}
+
+bool BreachedPasswordChecker::IsBreached(const string& password) const {
+  return GetBreachCount(password) != 0;
+}
+
+size_t BreachedPasswordChecker::GetBreachCount(const string& password) const {
+  string digest = Sha1(password);
+
+  // The filter never misses a hash that is in the list, so a password it
+  // rules out doesn't need to be searched for
+  if (bloom_filter_ && !bloom_filter_->MightContain(digest)) {
+    return 0;
+  }
+
+  return FindDigest(digest);
+}
+
+bool BreachedPasswordChecker::HasBloomFilter() const {
+  return static_cast<bool>(bloom_filter_);
+}
+
+void BreachedPasswordChecker::BuildBloomFilter(
+    const string& corpus_path, const string& bloom_filter_path,
+    double false_positive_rate) {
+  MemoryMappedFile corpus(corpus_path);
+  const char* data = corpus.GetData();
+  size_t size = corpus.GetSize();
+
+  // Counts the lines first so the filter can be sized for them
+  size_t line_count = 0;
+  for (size_t position = 0; position < size; position++) {
+    line_count += data[position] == '\n';
+  }
+  if (size != 0 && data[size - 1] != '\n') {
+    line_count++;
+  }
+
+  size_t bit_count =
+      BloomFilter::GetOptimalBitCount(line_count, false_positive_rate);
+  BloomFilter filter(bit_count,
+                     BloomFilter::GetOptimalHashCount(bit_count, line_count));
+
+  for (size_t position = 0; position < size;) {
+    CorpusLine line = ReadLine(data, size, position);
+    filter.Add(line.digest);
+    position = line.next_line;
+  }
+
+  filter.Save(bloom_filter_path);
+}
+
+size_t BreachedPasswordChecker::FindDigest(const string& digest) const {
+  const char* data = corpus_.GetData();
+  size_t size = corpus_.GetSize();
+
+  // The digest can only be in the lines between low and high, which always
+  // start lines. low_key and high_key bound the digests in that range.
+  size_t low = 0;
+  size_t high = size;
+  uint64_t low_key = 0;
+  uint64_t high_key = UINT64_MAX;
+  uint64_t key = GetDigestKey(digest);
+  bool should_bisect = false;
+
+  while (high - low > kLinearSearchBytes) {
+    // Guesses the position from where the digest falls between the bounds,
+    // unless the last guess didn't at least halve the range
+    size_t range = high - low;
+    size_t guess;
+    if (should_bisect) {
+      guess = low + range / 2;
+    } else {
+      long double fraction = static_cast<long double>(key - low_key) /
+                             (static_cast<long double>(high_key - low_key) + 1);
+      guess = low + static_cast<size_t>(fraction * range);
+    }
+    guess = std::min(guess, high - 1);
+
+    // Moves back to the start of the line the guess is in
+    while (guess > low && data[guess - 1] != '\n') {
+      guess--;
+    }
+
+    CorpusLine line = ReadLine(data, size, guess);
+    int comparison = line.digest.compare(digest);
+    if (comparison == 0) {
+      return line.count;
+    }
+
+    if (comparison < 0) {
+      low = line.next_line;
+      low_key = GetDigestKey(line.digest);
+    } else {
+      high = guess;
+      high_key = GetDigestKey(line.digest);
+    }
+
+    should_bisect = high - low > range / 2;
+  }
+
+  // Reads the few lines that are left one after another
+  for (size_t position = low; position < high;) {
+    CorpusLine line = ReadLine(data, size, position);
+    int comparison = line.digest.compare(digest);
+    if (comparison == 0) {
+      return line.count;
+    }
+    if (comparison > 0) {
+      break;
+    }
+
+    position = line.next_line;
+  }
+
+  return 0;
+}
+
+}  // namespace passwordcontainer
@@ -0,0 +1,152 @@
+#include "core/audit/password_reuse_index.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "core/thread_pool.h"
+
+using std::string;
+using std::vector;
+
+namespace passwordcontainer {
+
+const size_t PasswordReuseIndex::kKeyLength;
+
+namespace {
+
+// The number of passwords hashed by one task of a parallel build
+const size_t kPasswordsPerTask = 1024;
+
+// Returns the big endian int in the 8 bytes starting at bytes.
+uint64_t ReadUint64(const unsigned char* bytes) {
+  uint64_t value = 0;
+  for (size_t index = 0; index < 8; index++) {
+    value = (value << 8) | bytes[index];
+  }
+
+  return value;
+}
+
+}  // namespace
+
+bool PasswordReuseIndex::Digest::operator==(const Digest& other) const {
+  return high == other.high && low == other.low;
+}
+
+size_t PasswordReuseIndex::DigestHash::operator()(const Digest& digest) const {
+  // The digest is already uniformly random, so any of its bits will do
+  return static_cast<size_t>(digest.low);
+}
+
+PasswordReuseIndex::PasswordReuseIndex()
+    : hmac_(keyderivation::GenerateSalt(kKeyLength)) {
+}
+
+void PasswordReuseIndex::Build(const vector<string>& account_names,
+                               const vector<string>& passwords,
+                               size_t thread_count) {
+  if (account_names.size() != passwords.size()) {
+    throw std::invalid_argument("Bad data passed in!");
+  }
+
+  // Hashing is the slow part and every password is independent, so only it is
+  // split across the threads
+  vector<Digest> digests(passwords.size());
+  auto hash_range = [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; index++) {
+      digests[index] = HashPassword(passwords[index]);
+    }
+  };
+
+  if (thread_count == 1 || passwords.size() <= kPasswordsPerTask) {
+    hash_range(0, passwords.size());
+  } else {
+    ThreadPool thread_pool(thread_count);
+    thread_pool.ParallelFor(passwords.size(), kPasswordsPerTask, hash_range);
+  }
+
+  Clear();
+  accounts_by_digest_.reserve(digests.size());
+  for (size_t index = 0; index < digests.size(); index++) {
+    AddDigest(digests[index], account_names[index]);
+  }
+}
+
+void PasswordReuseIndex::Add(const string& account_name,
+                             const string& password) {
+  AddDigest(HashPassword(password), account_name);
+}
+
+void PasswordReuseIndex::Remove(const string& account_name,
+                                const string& password) {
+  auto accounts = accounts_by_digest_.find(HashPassword(password));
+  if (accounts == accounts_by_digest_.end()) {
+    throw std::invalid_argument("Account is not in the index!");
+  }
+
+  vector<string>& account_names = accounts->second;
+  auto position =
+      std::find(account_names.begin(), account_names.end(), account_name);
+  if (position == account_names.end()) {
+    throw std::invalid_argument("Account is not in the index!");
+  }
+  account_names.erase(position);
+
+  // Drops hashes that aren't reused or used at all anymore
+  if (account_names.size() == 1) {
+    reused_digests_.erase(accounts->first);
+  } else if (account_names.empty()) {
+    accounts_by_digest_.erase(accounts);
+  }
+}
+
+vector<vector<string>> PasswordReuseIndex::GetReuseGroups() const {
+  vector<vector<string>> groups;
+  for (const Digest& digest : reused_digests_) {
+    groups.push_back(accounts_by_digest_.at(digest));
+    std::sort(groups.back().begin(), groups.back().end());
+  }
+
+  // Shows the most reused passwords first and keeps the order the same every
+  // time for groups of the same size
+  std::sort(groups.begin(), groups.end(),
+            [](const vector<string>& first, const vector<string>& second) {
+              if (first.size() != second.size()) {
+                return first.size() > second.size();
+              }
+
+              return first.front() < second.front();
+            });
+
+  return groups;
+}
+
+void PasswordReuseIndex::Clear() {
+  accounts_by_digest_.clear();
+  reused_digests_.clear();
+}
+
+PasswordReuseIndex::Digest PasswordReuseIndex::HashPassword(
+    const string& password) const {
+  unsigned char hmac[SHA256::DIGEST_SIZE];
+  hmac_.Calculate(reinterpret_cast<const unsigned char*>(password.data()),
+                  password.size(), hmac);
+
+  Digest digest;
+  digest.high = ReadUint64(hmac);
+  digest.low = ReadUint64(hmac + 8);
+
+  return digest;
+}
+
+void PasswordReuseIndex::AddDigest(const Digest& digest,
+                                   const string& account_name) {
+  vector<string>& account_names = accounts_by_digest_[digest];
+  account_names.push_back(account_name);
+
+  if (account_names.size() == 2) {
+    reused_digests_.insert(digest);
+  }
+}
+
+}  // namespace passwordcontainer
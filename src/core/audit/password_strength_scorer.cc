@@ -0,0 +1,258 @@
+#include "core/audit/password_strength_scorer.h"
+
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+#include "core/thread_pool.h"
+
+using std::string;
+using std::vector;
+
+namespace passwordcontainer {
+
+const size_t PasswordStrengthScorer::kMinPatternLength;
+const size_t PasswordStrengthScorer::kPasswordsPerTask;
+const double PasswordStrengthScorer::kWeakBits = 28;
+const double PasswordStrengthScorer::kFairBits = 36;
+const double PasswordStrengthScorer::kStrongBits = 60;
+const double PasswordStrengthScorer::kVeryStrongBits = 80;
+
+namespace {
+
+// The most common passwords and the words they are made of, which every
+// dictionary starts with
+const char* const kCommonWords[] = {
+    "password", "qwerty",   "qwertyuiop", "asdf",     "zxcvbn",   "letmein",
+    "welcome",  "admin",    "login",      "iloveyou", "love",     "monkey",
+    "dragon",   "master",   "shadow",     "sunshine", "princess", "football",
+    "baseball", "soccer",   "hockey",     "superman", "batman",   "trustno1",
+    "secret",   "summer",   "winter",     "spring",   "autumn",   "freedom",
+    "whatever", "computer", "internet",   "starwars", "charlie",  "michael",
+    "jessica",  "ashley",   "jordan",     "hunter",   "killer",   "pepper",
+    "cheese",   "orange",   "banana",     "flower",   "mustang",  "access",
+    "hello",    "money",    "abc123",     "pass",     "user",     "test",
+    "guest",    "root",     "changeme",   "default",  "google",   "linkedin"};
+
+// The number of characters in every character class
+const double kLowercaseCount = 26;
+const double kUppercaseCount = 26;
+const double kDigitCount = 10;
+const double kSymbolCount = 33;
+
+// Returns the passed in character in lowercase with the common digit and
+// symbol substitutions for letters undone.
+char FoldCharacter(char character) {
+  switch (character) {
+    case '0':
+      return 'o';
+    case '1':
+    case '!':
+      return 'i';
+    case '3':
+      return 'e';
+    case '4':
+    case '@':
+      return 'a';
+    case '5':
+    case '$':
+      return 's';
+    case '7':
+      return 't';
+    default:
+      return static_cast<char>(
+          std::tolower(static_cast<unsigned char>(character)));
+  }
+}
+
+// Returns the passed in text with every character folded.
+string FoldText(const string& text) {
+  string folded(text.size(), '\0');
+  for (size_t index = 0; index < text.size(); index++) {
+    folded[index] = FoldCharacter(text[index]);
+  }
+
+  return folded;
+}
+
+}  // namespace
+
+PasswordStrengthScorer::PasswordStrengthScorer() {
+  for (const char* word : kCommonWords) {
+    dictionary_.Insert(FoldText(word));
+  }
+}
+
+void PasswordStrengthScorer::LoadWordList(const string& file_path) {
+  std::ifstream word_file(file_path);
+  if (!word_file.is_open()) {
+    throw std::invalid_argument("Could not open the file!");
+  }
+
+  string word;
+  while (std::getline(word_file, word)) {
+    if (!word.empty() && word.back() == '\r') {
+      word.pop_back();
+    }
+
+    if (word.size() >= kMinPatternLength) {
+      dictionary_.Insert(FoldText(word));
+    }
+  }
+}
+
+PasswordStrength PasswordStrengthScorer::Score(const string& password) const {
+  PasswordStrength strength;
+
+  // Finds the character classes and the bits needed to guess a character
+  // picked from them
+  bool has_lowercase = false, has_uppercase = false;
+  bool has_digit = false, has_symbol = false;
+  for (char character : password) {
+    unsigned char byte = static_cast<unsigned char>(character);
+    if (std::islower(byte)) {
+      has_lowercase = true;
+    } else if (std::isupper(byte)) {
+      has_uppercase = true;
+    } else if (std::isdigit(byte)) {
+      has_digit = true;
+    } else {
+      has_symbol = true;
+    }
+  }
+
+  double pool_size = 0;
+  if (has_lowercase) {
+    pool_size += kLowercaseCount;
+    strength.character_class_count++;
+  }
+  if (has_uppercase) {
+    pool_size += kUppercaseCount;
+    strength.character_class_count++;
+  }
+  if (has_digit) {
+    pool_size += kDigitCount;
+    strength.character_class_count++;
+  }
+  if (has_symbol) {
+    pool_size += kSymbolCount;
+    strength.character_class_count++;
+  }
+  double character_bits = pool_size > 1 ? std::log2(pool_size) : 0;
+  double word_bits =
+      std::log2(static_cast<double>(dictionary_.GetWordCount() + 1));
+
+  // Takes the longest dictionary word at every position from the left
+  string folded = FoldText(password);
+  vector<bool> is_covered(password.size(), false);
+  size_t position = 0;
+  while (position < password.size()) {
+    size_t length = dictionary_.FindLongestWord(folded, position);
+    if (length < kMinPatternLength) {
+      position++;
+      continue;
+    }
+
+    // Capitals and substitutions only add about a bit each, since they are
+    // the first thing tried
+    bool has_capital = false, has_substitution = false;
+    for (size_t index = position; index < position + length; index++) {
+      unsigned char byte = static_cast<unsigned char>(password[index]);
+      has_capital = has_capital || std::isupper(byte);
+      has_substitution =
+          has_substitution ||
+          (!std::isalpha(byte) && folded[index] != password[index]);
+      is_covered[index] = true;
+    }
+
+    strength.entropy_bits += word_bits + (has_capital ? 1 : 0) +
+                             (has_substitution ? 1 : 0);
+    strength.pattern_count++;
+    position += length;
+  }
+
+  // Finds runs of a repeated character or a sequence in what is left
+  position = 0;
+  while (position < password.size()) {
+    if (is_covered[position]) {
+      position++;
+      continue;
+    }
+
+    size_t end = position + 1;
+    if (end < password.size() && !is_covered[end]) {
+      int step = password[end] - password[position];
+      if (step >= -1 && step <= 1) {
+        while (end + 1 < password.size() && !is_covered[end + 1] &&
+               password[end + 1] - password[end] == step) {
+          end++;
+        }
+        end++;
+      }
+    }
+
+    size_t length = end - position;
+    if (length >= kMinPatternLength) {
+      strength.entropy_bits +=
+          character_bits + std::log2(static_cast<double>(length));
+      strength.pattern_count++;
+    } else {
+      strength.entropy_bits += character_bits * length;
+    }
+    position = end;
+  }
+
+  if (strength.entropy_bits >= kVeryStrongBits) {
+    strength.rating = PasswordStrength::kVeryStrong;
+  } else if (strength.entropy_bits >= kStrongBits) {
+    strength.rating = PasswordStrength::kStrong;
+  } else if (strength.entropy_bits >= kFairBits) {
+    strength.rating = PasswordStrength::kFair;
+  } else if (strength.entropy_bits >= kWeakBits) {
+    strength.rating = PasswordStrength::kWeak;
+  }
+
+  return strength;
+}
+
+vector<PasswordStrength> PasswordStrengthScorer::ScoreAll(
+    const vector<string>& passwords, size_t thread_count) const {
+  vector<PasswordStrength> strengths(passwords.size());
+  auto score_range = [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; index++) {
+      strengths[index] = Score(passwords[index]);
+    }
+  };
+
+  if (thread_count == 1 || passwords.size() <= kPasswordsPerTask) {
+    score_range(0, passwords.size());
+  } else {
+    ThreadPool thread_pool(thread_count);
+    thread_pool.ParallelFor(passwords.size(), kPasswordsPerTask, score_range);
+  }
+
+  return strengths;
+}
+
+string PasswordStrengthScorer::GetRatingName(PasswordStrength::Rating rating) {
+  switch (rating) {
+    case PasswordStrength::kVeryWeak:
+      return "Very weak";
+    case PasswordStrength::kWeak:
+      return "Weak";
+    case PasswordStrength::kFair:
+      return "Fair";
+    case PasswordStrength::kStrong:
+      return "Strong";
+    default:
+      return "Very strong";
+  }
+}
+
+string PasswordStrengthScorer::Describe(const PasswordStrength& strength) {
+  return GetRatingName(strength.rating) + ", " +
+         std::to_string(static_cast<long>(strength.entropy_bits)) + " bits";
+}
+
+}  // namespace passwordcontainer
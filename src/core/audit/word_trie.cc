@@ -0,0 +1,83 @@
+#include "core/audit/word_trie.h"
+
+using std::string;
+
+namespace passwordcontainer {
+
+const uint32_t WordTrie::kNoNode;
+
+WordTrie::WordTrie() {
+  Node root;
+  root.first_child = kNoNode;
+  root.next_sibling = kNoNode;
+  root.character = '\0';
+  root.is_word_end = false;
+  nodes_.push_back(root);
+}
+
+void WordTrie::Insert(const string& word) {
+  if (word.empty()) {
+    return;
+  }
+
+  uint32_t current = 0;
+  for (char character : word) {
+    uint32_t child = FindChild(current, character);
+
+    // Adds the missing node as the new first child of the current node
+    if (child == kNoNode) {
+      Node node;
+      node.first_child = kNoNode;
+      node.next_sibling = nodes_[current].first_child;
+      node.character = character;
+      node.is_word_end = false;
+
+      child = static_cast<uint32_t>(nodes_.size());
+      nodes_.push_back(node);
+      nodes_[current].first_child = child;
+    }
+
+    current = child;
+  }
+
+  if (!nodes_[current].is_word_end) {
+    nodes_[current].is_word_end = true;
+    word_count_++;
+  }
+}
+
+size_t WordTrie::FindLongestWord(const string& text, size_t position) const {
+  size_t longest_length = 0;
+  uint32_t current = 0;
+
+  // Follows the text down the trie, remembering the last word that ended
+  for (size_t index = position; index < text.size(); index++) {
+    current = FindChild(current, text[index]);
+    if (current == kNoNode) {
+      break;
+    }
+
+    if (nodes_[current].is_word_end) {
+      longest_length = index - position + 1;
+    }
+  }
+
+  return longest_length;
+}
+
+size_t WordTrie::GetWordCount() const {
+  return word_count_;
+}
+
+uint32_t WordTrie::FindChild(uint32_t parent, char character) const {
+  for (uint32_t child = nodes_[parent].first_child; child != kNoNode;
+       child = nodes_[child].next_sibling) {
+    if (nodes_[child].character == character) {
+      return child;
+    }
+  }
+
+  return kNoNode;
+}
+
+}  // namespace passwordcontainer
@@ -1,8 +1,12 @@
 #include "core/encryption/cryptographer.h"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
-#include "core/util.h"
+#include "core/encryption/key_derivation.h"
+#include "core/encryption/sha256.h"
+#include "core/encryption/triplet_decoder.h"
 
 using std::string;
 
@@ -17,11 +21,16 @@ Cryptographer::Cryptographer(size_t offset, const std::string& key) {
   key_ = key;
 }
 
+Cryptographer::~Cryptographer() {
+  keyderivation::WipeString(key_);
+}
+
 void Cryptographer::SetKey(const string& new_key) {
   if (new_key.empty()) {
     throw std::invalid_argument("Invalid parameter passed in to SetKey!");
   }
 
+  keyderivation::WipeString(key_);
   key_ = new_key;
 }
 
@@ -37,25 +46,82 @@ void Cryptographer::SetOffset(size_t offset) {
   character_offset_ = offset;
 }
 
+void Cryptographer::SetParallelism(size_t thread_count,
+                                   size_t serial_threshold) {
+  serial_threshold_ = serial_threshold;
+
+  // Drops the pool if everything should stay on the calling thread
+  if (thread_count == 1) {
+    thread_pool_.reset();
+  } else {
+    thread_pool_ = std::make_shared<ThreadPool>(thread_count);
+  }
+}
+
+void swap(Cryptographer& first, Cryptographer& second) {
+  using std::swap;
+  swap(first.character_offset_, second.character_offset_);
+  swap(first.key_, second.key_);
+  swap(first.thread_pool_, second.thread_pool_);
+  swap(first.serial_threshold_, second.serial_threshold_);
+}
+
+string Cryptographer::CalculateKeyCheck() const {
+  string check_input = kKeyCheckContext + '\t' +
+                       std::to_string(character_offset_) + '\t' + key_;
+  string key_check = sha256(check_input);
+  keyderivation::WipeString(check_input);
+
+  return key_check;
+}
+
+bool Cryptographer::MatchesKeyCheck(const string& key_check) const {
+  string expected_check = CalculateKeyCheck();
+  if (key_check.size() != expected_check.size()) {
+    return false;
+  }
+
+  // Combines the differences of every character instead of stopping at the
+  // first one so the time taken doesn't leak how much of the check matched
+  unsigned char difference = 0;
+  for (size_t index = 0; index < expected_check.size(); index++) {
+    difference |= static_cast<unsigned char>(key_check[index] ^
+                                             expected_check[index]);
+  }
+
+  return difference == 0;
+}
+
 string Cryptographer::DecryptString(const string& str) const {
+  // A partial encrypted character can never be valid data
+  if (str.size() % kEncryptedCharacterLength != 0) {
+    throw std::invalid_argument("Bad string data passed in!");
+  }
+
   size_t offset = CalculateRealOffset();
-  string decrypted_string;
-
-  // Loops through every encrypted character in the passed in string
-  for (size_t index = 0; index < str.size();
-       index += kEncryptedCharacterLength) {
-    // Gets the int ASCII representation of the char
-    string encrypted_char = str.substr(index, kEncryptedCharacterLength);
-    int char_int_representation =
-        util::ConvertStringToInt(encrypted_char) - offset;
-
-    // Makes sure the encrypted char strings actually refers to a char
-    if (!IsValidChar(char_int_representation)) {
-      throw std::invalid_argument("Bad string data passed in!");
-    }
 
-    // Adds the character to the string
-    decrypted_string += static_cast<char>(char_int_representation);
+  // Every encrypted character turns into exactly one decrypted character
+  size_t decrypted_length = str.size() / kEncryptedCharacterLength;
+  string decrypted_string(decrypted_length, '\0');
+  std::atomic<bool> has_bad_data(false);
+
+  if (ShouldRunInParallel(str.size())) {
+    // Splits the string on encrypted character boundaries so each thread
+    // decrypts whole characters into its own part of the output
+    thread_pool_->ParallelFor(decrypted_length, 1,
+                              [&](size_t begin, size_t end) {
+                                DecryptRange(str, begin, end, offset,
+                                             &decrypted_string[begin],
+                                             has_bad_data);
+                              });
+  } else if (!str.empty()) {
+    DecryptRange(str, 0, decrypted_length, offset, &decrypted_string[0],
+                 has_bad_data);
+  }
+
+  // Makes sure the encrypted char strings actually referred to chars
+  if (has_bad_data) {
+    throw std::invalid_argument("Bad string data passed in!");
   }
 
   return decrypted_string;
@@ -63,16 +129,66 @@ string Cryptographer::DecryptString(const string& str) const {
 
 string Cryptographer::EncryptString(const string& str) const {
   size_t offset = CalculateRealOffset();
+
+  if (!ShouldRunInParallel(str.size())) {
+    return EncryptRange(str, 0, str.size(), offset);
+  }
+
+  // Encrypts pieces of the string on different threads and then joins them in
+  // order, which gives the same result as encrypting the string in one go
+  std::vector<string> encrypted_pieces(thread_pool_->GetThreadCount() + 1);
+  size_t piece_size =
+      (str.size() + encrypted_pieces.size() - 1) / encrypted_pieces.size();
+  thread_pool_->ParallelFor(str.size(), piece_size,
+                            [&](size_t begin, size_t end) {
+                              encrypted_pieces[begin / piece_size] =
+                                  EncryptRange(str, begin, end, offset);
+                            });
+
+  string encrypted_string;
+  for (const string& piece : encrypted_pieces) {
+    encrypted_string += piece;
+  }
+
+  return encrypted_string;
+}
+
+string Cryptographer::EncryptRange(const string& str, size_t begin, size_t end,
+                                   size_t offset) const {
   string encrypted_string;
+  encrypted_string.reserve((end - begin) * kEncryptedCharacterLength);
 
-  // Encrypts every character in the passed in string and returns it
-  for (char c : str) {
-    encrypted_string += std::to_string(static_cast<size_t>(c) + offset);
+  // Encrypts every character in the range and returns it
+  for (size_t index = begin; index < end; index++) {
+    encrypted_string +=
+        std::to_string(static_cast<size_t>(str[index]) + offset);
   }
 
   return encrypted_string;
 }
 
+void Cryptographer::DecryptRange(const string& str, size_t begin, size_t end,
+                                 size_t offset, char* output,
+                                 std::atomic<bool>& has_bad_data) const {
+  // Decodes the range a block at a time so the work stops soon after any
+  // thread finds bad data (which usually means the key is wrong)
+  for (size_t index = begin; index < end && !has_bad_data;
+       index += kDecryptBlockLength) {
+    size_t block_length = std::min(kDecryptBlockLength, end - index);
+
+    if (!tripletdecoder::DecodeTriplets(
+            str.data() + index * kEncryptedCharacterLength, block_length,
+            offset, output + (index - begin))) {
+      has_bad_data = true;
+    }
+  }
+}
+
+bool Cryptographer::ShouldRunInParallel(size_t length) const {
+  return thread_pool_ != nullptr && length >= serial_threshold_ &&
+         length >= kEncryptedCharacterLength * 2;
+}
+
 size_t Cryptographer::CalculateRealOffset() const {
   // Counts the total of the ASCII value of each value in the key
   size_t key_ascii_total = 0;
@@ -85,11 +201,4 @@ size_t Cryptographer::CalculateRealOffset() const {
   return (key_ascii_total + key_.size() * character_offset_) / key_.size();
 }
 
-bool Cryptographer::IsValidChar(int int_representation) const {
-  // Returns true if the passed in int represents a tab character, new line
-  // character, or any character in the ASCII range of ' ' to '~'
-  return int_representation == '\t' || int_representation == '\n' ||
-         (int_representation >= ' ' && int_representation <= '~');
-}
-
 }  // namespace passwordcontainer
\ No newline at end of file
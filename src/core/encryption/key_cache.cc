@@ -0,0 +1,201 @@
+#include "core/encryption/key_cache.h"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "core/encryption/key_derivation.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+using std::string;
+
+namespace passwordcontainer {
+
+const size_t KeyCache::kKeyLength;
+const size_t KeyCache::kCapacity;
+
+namespace {
+
+// How long an unused key stays in the cache by default
+const std::chrono::seconds kDefaultTimeToLive(15 * 60);
+
+}  // namespace
+
+KeyCache& KeyCache::GetInstance() {
+  static KeyCache instance;
+  return instance;
+}
+
+KeyCache::KeyCache()
+    : lookup_secret_(keyderivation::GenerateSalt(kKeyLength)),
+      time_to_live_(kDefaultTimeToLive) {
+  allocation_size_ = sizeof(Entry) * kCapacity;
+
+  // Allocates whole pages for the entries and locks them into RAM. The cache
+  // still works if locking isn't allowed (for example because of a low
+  // RLIMIT_MEMLOCK), it just can't promise the keys are never swapped.
+#ifdef _WIN32
+  void* memory = VirtualAlloc(nullptr, allocation_size_,
+                              MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  is_memory_locked_ = VirtualLock(memory, allocation_size_) != 0;
+#else
+  void* memory = mmap(nullptr, allocation_size_, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  is_memory_locked_ = mlock(memory, allocation_size_) == 0;
+#endif
+
+  entries_ = static_cast<Entry*>(memory);
+  for (size_t index = 0; index < kCapacity; index++) {
+    new (&entries_[index]) Entry();
+    ZeroEntry(entries_[index]);
+  }
+}
+
+KeyCache::~KeyCache() {
+  Clear();
+
+#ifdef _WIN32
+  if (is_memory_locked_) {
+    VirtualUnlock(entries_, allocation_size_);
+  }
+  VirtualFree(entries_, 0, MEM_RELEASE);
+#else
+  if (is_memory_locked_) {
+    munlock(entries_, allocation_size_);
+  }
+  munmap(entries_, allocation_size_);
+#endif
+}
+
+bool KeyCache::Find(const string& hashed_key, const string& salt,
+                    size_t iterations, string& derived_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EvictExpiredEntries();
+
+  string lookup_key = CalculateLookupKey(hashed_key, salt, iterations);
+
+  // Looks through every entry for one with the same lookup key
+  for (size_t index = 0; index < kCapacity; index++) {
+    Entry& entry = entries_[index];
+    if (entry.is_used &&
+        std::memcmp(entry.lookup_key, lookup_key.data(), kKeyLength) == 0) {
+      derived_key.assign(reinterpret_cast<char*>(entry.derived_key),
+                         kKeyLength);
+      entry.last_used = std::chrono::steady_clock::now();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void KeyCache::Insert(const string& hashed_key, const string& salt,
+                      size_t iterations, const string& derived_key) {
+  if (derived_key.size() != kKeyLength) {
+    throw std::invalid_argument("Invalid key passed in to Insert!");
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  EvictExpiredEntries();
+
+  // Nothing is kept if caching is turned off
+  if (time_to_live_.count() == 0) {
+    return;
+  }
+
+  string lookup_key = CalculateLookupKey(hashed_key, salt, iterations);
+
+  // Reuses the entry for the same parameters, or else an empty entry, or else
+  // the least recently used entry
+  Entry* target = nullptr;
+  for (size_t index = 0; index < kCapacity; index++) {
+    Entry& entry = entries_[index];
+    if (entry.is_used &&
+        std::memcmp(entry.lookup_key, lookup_key.data(), kKeyLength) == 0) {
+      target = &entry;
+      break;
+    }
+
+    if (target == nullptr || (target->is_used && !entry.is_used) ||
+        (target->is_used && entry.last_used < target->last_used)) {
+      target = &entry;
+    }
+  }
+
+  ZeroEntry(*target);
+  target->is_used = true;
+  std::memcpy(target->lookup_key, lookup_key.data(), kKeyLength);
+  std::memcpy(target->derived_key, derived_key.data(), kKeyLength);
+  target->last_used = std::chrono::steady_clock::now();
+}
+
+void KeyCache::SetTimeToLive(std::chrono::seconds time_to_live) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  time_to_live_ = time_to_live;
+  EvictExpiredEntries();
+}
+
+void KeyCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t index = 0; index < kCapacity; index++) {
+    ZeroEntry(entries_[index]);
+  }
+}
+
+size_t KeyCache::GetSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EvictExpiredEntries();
+
+  size_t size = 0;
+  for (size_t index = 0; index < kCapacity; index++) {
+    if (entries_[index].is_used) {
+      size++;
+    }
+  }
+
+  return size;
+}
+
+bool KeyCache::IsMemoryLocked() const {
+  return is_memory_locked_;
+}
+
+string KeyCache::CalculateLookupKey(const string& hashed_key,
+                                    const string& salt,
+                                    size_t iterations) const {
+  // Keeps the fields apart with their lengths so different fields can never
+  // produce the same message
+  string message = std::to_string(hashed_key.size()) + ':' + hashed_key +
+                   std::to_string(salt.size()) + ':' + salt +
+                   std::to_string(iterations);
+  return keyderivation::HmacSha256(lookup_secret_, message);
+}
+
+void KeyCache::EvictExpiredEntries() {
+  auto now = std::chrono::steady_clock::now();
+
+  for (size_t index = 0; index < kCapacity; index++) {
+    Entry& entry = entries_[index];
+    if (entry.is_used && now - entry.last_used >= time_to_live_) {
+      ZeroEntry(entry);
+    }
+  }
+}
+
+void KeyCache::ZeroEntry(Entry& entry) {
+  keyderivation::WipeBytes(&entry, sizeof(Entry));
+  entry.is_used = false;
+}
+
+}  // namespace passwordcontainer
@@ -0,0 +1,241 @@
+#include "core/encryption/key_derivation.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "core/encryption/sha256.h"
+
+using std::string;
+
+namespace passwordcontainer {
+
+namespace keyderivation {
+
+namespace {
+
+// The size of the blocks SHA-256 works on
+const size_t kBlockSize = 64;
+
+// The bytes the key is xor'ed with for the inner and outer hash of HMAC
+const unsigned char kInnerPad = 0x36;
+const unsigned char kOuterPad = 0x5c;
+
+// The number of iterations timed first when calibrating and the shortest time
+// a measurement needs to take to be trusted
+const size_t kCalibrationStartIterations = 1000;
+const std::chrono::milliseconds kMinimumCalibrationTime(50);
+
+// Returns the number of milliseconds it takes to derive a key with the passed
+// in number of iterations.
+double TimeIterations(size_t iterations) {
+  auto start = std::chrono::steady_clock::now();
+  Pbkdf2HmacSha256("calibration password", "calibration salt", iterations,
+                   kDerivedKeyLength);
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}  // namespace
+
+HmacContext::HmacContext(const string& key) {
+  // Keys longer than a block are hashed first
+  unsigned char key_block[kBlockSize] = {0};
+  if (key.size() > kBlockSize) {
+    SHA256 key_hash;
+    key_hash.init();
+    key_hash.update(reinterpret_cast<const unsigned char*>(key.data()),
+                    static_cast<unsigned int>(key.size()));
+    key_hash.final(key_block);
+  } else {
+    std::copy(key.begin(), key.end(), key_block);
+  }
+
+  unsigned char inner_block[kBlockSize];
+  unsigned char outer_block[kBlockSize];
+  for (size_t index = 0; index < kBlockSize; index++) {
+    inner_block[index] = key_block[index] ^ kInnerPad;
+    outer_block[index] = key_block[index] ^ kOuterPad;
+  }
+
+  inner_.init();
+  inner_.update(inner_block, kBlockSize);
+  outer_.init();
+  outer_.update(outer_block, kBlockSize);
+
+  WipeBytes(key_block, kBlockSize);
+  WipeBytes(inner_block, kBlockSize);
+  WipeBytes(outer_block, kBlockSize);
+}
+
+void HmacContext::Calculate(const unsigned char* message, size_t length,
+                            unsigned char* digest) const {
+  unsigned char inner_digest[SHA256::DIGEST_SIZE];
+
+  SHA256 inner = inner_;
+  inner.update(message, static_cast<unsigned int>(length));
+  inner.final(inner_digest);
+
+  SHA256 outer = outer_;
+  outer.update(inner_digest, SHA256::DIGEST_SIZE);
+  outer.final(digest);
+}
+
+string HmacSha256(const string& key, const string& message) {
+  unsigned char digest[SHA256::DIGEST_SIZE];
+  HmacContext(key).Calculate(
+      reinterpret_cast<const unsigned char*>(message.data()), message.size(),
+      digest);
+
+  return string(reinterpret_cast<char*>(digest), SHA256::DIGEST_SIZE);
+}
+
+string Pbkdf2HmacSha256(const string& password, const string& salt,
+                        size_t iterations, size_t key_length) {
+  if (iterations == 0 || key_length == 0) {
+    throw std::invalid_argument("Invalid parameters passed in to PBKDF2!");
+  }
+
+  HmacContext hmac(password);
+
+  // Reserves the whole key up front so no copy of it is left behind when the
+  // string grows
+  string derived_key;
+  derived_key.reserve(key_length);
+
+  // Calculates one digest sized block of the key at a time
+  for (unsigned int block_index = 1; derived_key.size() < key_length;
+       block_index++) {
+    // The first message is the salt followed by the big endian block index
+    string first_message = salt;
+    first_message += static_cast<char>((block_index >> 24) & 0xff);
+    first_message += static_cast<char>((block_index >> 16) & 0xff);
+    first_message += static_cast<char>((block_index >> 8) & 0xff);
+    first_message += static_cast<char>(block_index & 0xff);
+
+    unsigned char current[SHA256::DIGEST_SIZE];
+    unsigned char block[SHA256::DIGEST_SIZE];
+    hmac.Calculate(reinterpret_cast<const unsigned char*>(first_message.data()),
+                   first_message.size(), current);
+    std::copy(current, current + SHA256::DIGEST_SIZE, block);
+
+    // Every other iteration hashes the previous digest and xors it in
+    for (size_t iteration = 1; iteration < iterations; iteration++) {
+      hmac.Calculate(current, SHA256::DIGEST_SIZE, current);
+      for (size_t index = 0; index < SHA256::DIGEST_SIZE; index++) {
+        block[index] ^= current[index];
+      }
+    }
+
+    size_t bytes_needed =
+        std::min(key_length - derived_key.size(),
+                 static_cast<size_t>(SHA256::DIGEST_SIZE));
+    derived_key.append(reinterpret_cast<char*>(block), bytes_needed);
+
+    WipeBytes(current, SHA256::DIGEST_SIZE);
+    WipeBytes(block, SHA256::DIGEST_SIZE);
+  }
+
+  return derived_key;
+}
+
+size_t CalibrateIterations(std::chrono::milliseconds target_latency) {
+  if (target_latency.count() <= 0) {
+    throw std::invalid_argument(
+        "Invalid parameter passed in to CalibrateIterations!");
+  }
+
+  // Keeps doubling the iterations until the measurement is long enough to be
+  // accurate
+  size_t iterations = kCalibrationStartIterations;
+  double elapsed_milliseconds = TimeIterations(iterations);
+  while (elapsed_milliseconds < kMinimumCalibrationTime.count()) {
+    iterations *= 2;
+    elapsed_milliseconds = TimeIterations(iterations);
+  }
+
+  // Scales the measured iterations to the target since the time taken is
+  // linear in the number of iterations
+  double iterations_per_millisecond = iterations / elapsed_milliseconds;
+  size_t calibrated_iterations = static_cast<size_t>(
+      iterations_per_millisecond * target_latency.count());
+
+  return std::min(std::max(calibrated_iterations, kMinimumIterations),
+                  kMaximumIterations);
+}
+
+string GenerateSalt(size_t length) {
+  std::random_device random;
+  string salt;
+
+  for (size_t index = 0; index < length; index++) {
+    salt += static_cast<char>(random() & 0xff);
+  }
+
+  return salt;
+}
+
+string ConvertToHex(const string& bytes) {
+  const char kHexDigits[] = "0123456789abcdef";
+  string hex;
+  hex.reserve(bytes.size() * 2);
+
+  for (char byte : bytes) {
+    unsigned char value = static_cast<unsigned char>(byte);
+    hex += kHexDigits[value >> 4];
+    hex += kHexDigits[value & 0xf];
+  }
+
+  return hex;
+}
+
+string ConvertFromHex(const string& hex) {
+  if (hex.size() % 2 != 0) {
+    throw std::invalid_argument("Invalid hex string passed in!");
+  }
+
+  string bytes;
+  for (size_t index = 0; index < hex.size(); index += 2) {
+    int value = 0;
+
+    // Converts both hex digits of the byte
+    for (size_t digit = index; digit < index + 2; digit++) {
+      char c = hex[digit];
+      value <<= 4;
+      if (c >= '0' && c <= '9') {
+        value |= c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        value |= c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        value |= c - 'A' + 10;
+      } else {
+        throw std::invalid_argument("Invalid hex string passed in!");
+      }
+    }
+
+    bytes += static_cast<char>(value);
+  }
+
+  return bytes;
+}
+
+void WipeBytes(void* bytes, size_t length) {
+  // Writes through a volatile pointer so the compiler can't skip the writes
+  volatile unsigned char* volatile_bytes = static_cast<unsigned char*>(bytes);
+  for (size_t index = 0; index < length; index++) {
+    volatile_bytes[index] = 0;
+  }
+}
+
+void WipeString(string& str) {
+  if (!str.empty()) {
+    WipeBytes(&str[0], str.size());
+  }
+
+  str.clear();
+}
+
+}  // namespace keyderivation
+
+}  // namespace passwordcontainer
@@ -0,0 +1,113 @@
+#include "core/encryption/sha1.h"
+
+#include <cstdint>
+
+using std::string;
+
+namespace passwordcontainer {
+
+namespace {
+
+// The size of the blocks SHA-1 works on and of the length at the end of the
+// padding
+const size_t kBlockSize = 64;
+const size_t kLengthSize = 8;
+
+// Rotates value left by bits.
+uint32_t RotateLeft(uint32_t value, int bits) {
+  return (value << bits) | (value >> (32 - bits));
+}
+
+// Mixes the 64 byte block into state.
+void ProcessBlock(const unsigned char* block, uint32_t* state) {
+  uint32_t words[80];
+  for (size_t index = 0; index < 16; index++) {
+    words[index] = (uint32_t(block[index * 4]) << 24) |
+                   (uint32_t(block[index * 4 + 1]) << 16) |
+                   (uint32_t(block[index * 4 + 2]) << 8) |
+                   uint32_t(block[index * 4 + 3]);
+  }
+  for (size_t index = 16; index < 80; index++) {
+    words[index] = RotateLeft(words[index - 3] ^ words[index - 8] ^
+                                  words[index - 14] ^ words[index - 16],
+                              1);
+  }
+
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3],
+           e = state[4];
+  for (size_t round = 0; round < 80; round++) {
+    uint32_t mixed, constant;
+    if (round < 20) {
+      mixed = (b & c) | (~b & d);
+      constant = 0x5a827999;
+    } else if (round < 40) {
+      mixed = b ^ c ^ d;
+      constant = 0x6ed9eba1;
+    } else if (round < 60) {
+      mixed = (b & c) | (b & d) | (c & d);
+      constant = 0x8f1bbcdc;
+    } else {
+      mixed = b ^ c ^ d;
+      constant = 0xca62c1d6;
+    }
+
+    uint32_t next = RotateLeft(a, 5) + mixed + e + constant + words[round];
+    e = d;
+    d = c;
+    c = RotateLeft(b, 30);
+    b = a;
+    a = next;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+}
+
+}  // namespace
+
+string Sha1(const string& message) {
+  uint32_t state[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476,
+                       0xc3d2e1f0};
+
+  // Hashes every full block straight from the message
+  size_t full_length = message.size() - message.size() % kBlockSize;
+  const unsigned char* data =
+      reinterpret_cast<const unsigned char*>(message.data());
+  for (size_t offset = 0; offset < full_length; offset += kBlockSize) {
+    ProcessBlock(data + offset, state);
+  }
+
+  // Pads the rest with a 1 bit, zeros, and the length in bits so it fills one
+  // or two blocks
+  unsigned char tail[kBlockSize * 2] = {0};
+  size_t tail_length = message.size() - full_length;
+  for (size_t index = 0; index < tail_length; index++) {
+    tail[index] = data[full_length + index];
+  }
+  tail[tail_length] = 0x80;
+
+  size_t padded_length =
+      tail_length + 1 + kLengthSize <= kBlockSize ? kBlockSize : kBlockSize * 2;
+  uint64_t bit_length = uint64_t(message.size()) * 8;
+  for (size_t index = 0; index < kLengthSize; index++) {
+    tail[padded_length - 1 - index] =
+        static_cast<unsigned char>(bit_length >> (index * 8));
+  }
+
+  for (size_t offset = 0; offset < padded_length; offset += kBlockSize) {
+    ProcessBlock(tail + offset, state);
+  }
+
+  string digest(kSha1DigestLength, '\0');
+  for (size_t index = 0; index < kSha1DigestLength; index++) {
+    digest[index] =
+        static_cast<char>(state[index / 4] >> (24 - (index % 4) * 8));
+  }
+
+  return digest;
+}
+
+}  // namespace passwordcontainer
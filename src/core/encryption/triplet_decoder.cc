@@ -0,0 +1,420 @@
+#include "core/encryption/triplet_decoder.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define TRIPLET_DECODER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang need to be told which functions may use SSE4.1/AVX2 since the
+// rest of the program is compiled for the baseline instruction set. MSVC allows
+// the intrinsics anywhere.
+#if defined(TRIPLET_DECODER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TRIPLET_DECODER_TARGET(isa) __attribute__((target(isa)))
+#else
+#define TRIPLET_DECODER_TARGET(isa)
+#endif
+
+namespace passwordcontainer {
+
+namespace tripletdecoder {
+
+namespace {
+
+// The largest value that a group of 3 digits can hold
+const size_t kMaxTripletValue = 999;
+
+// The implementations DecodeTriplets can choose from
+enum Implementation { kScalar, kSse41, kAvx2 };
+
+// Returns true if the passed in int represents a tab character, new line
+// character, or any character in the ASCII range of ' ' to '~'.
+bool IsValidChar(int int_representation) {
+  return int_representation == '\t' || int_representation == '\n' ||
+         (int_representation >= ' ' && int_representation <= '~');
+}
+
+#ifdef TRIPLET_DECODER_X86
+
+// The number of encrypted characters decoded by one SSE4.1 block (48 bytes)
+// and by one AVX2 block (96 bytes)
+const size_t kSseBlockLength = 16;
+const size_t kAvxBlockLength = 32;
+
+// pshufb masks that gather the hundreds, tens, and ones digits of 16
+// consecutive groups out of the three 16 byte registers that hold them. Indexed
+// by [digit][register][lane]. Lanes that don't come from a register are 0x80,
+// which makes pshufb write a 0.
+struct ShuffleMasks {
+  signed char masks[kTripletLength][kTripletLength][16];
+};
+
+ShuffleMasks BuildShuffleMasks() {
+  ShuffleMasks shuffle_masks;
+
+  for (size_t digit = 0; digit < kTripletLength; digit++) {
+    for (size_t reg = 0; reg < kTripletLength; reg++) {
+      for (size_t lane = 0; lane < 16; lane++) {
+        size_t source = lane * kTripletLength + digit;
+        shuffle_masks.masks[digit][reg][lane] =
+            source / 16 == reg ? static_cast<signed char>(source % 16)
+                               : static_cast<signed char>(0x80);
+      }
+    }
+  }
+
+  return shuffle_masks;
+}
+
+const ShuffleMasks& GetShuffleMasks() {
+  static const ShuffleMasks shuffle_masks = BuildShuffleMasks();
+  return shuffle_masks;
+}
+
+// Subtracts '0' from every byte and clears the lanes of all_digits that were
+// not a digit.
+TRIPLET_DECODER_TARGET("sse4.1")
+inline __m128i ToDigitsSse(__m128i bytes, __m128i& all_digits) {
+  __m128i digits = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+  __m128i is_digit =
+      _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+  all_digits = _mm_and_si128(all_digits, is_digit);
+  return digits;
+}
+
+// Gathers one digit of all 16 groups using the three masks for that digit.
+TRIPLET_DECODER_TARGET("sse4.1")
+inline __m128i GatherDigitSse(__m128i first, __m128i second, __m128i third,
+                              const __m128i* masks) {
+  return _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(first, masks[0]),
+                                   _mm_shuffle_epi8(second, masks[1])),
+                      _mm_shuffle_epi8(third, masks[2]));
+}
+
+// Turns 8 hundreds/tens/ones digits into 16 bit values and subtracts offset.
+TRIPLET_DECODER_TARGET("sse4.1")
+inline __m128i CombineDigitsSse(__m128i hundreds, __m128i tens, __m128i ones,
+                                __m128i offset) {
+  __m128i value = _mm_add_epi16(
+      _mm_add_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(hundreds),
+                                    _mm_set1_epi16(100)),
+                    _mm_mullo_epi16(_mm_cvtepu8_epi16(tens),
+                                    _mm_set1_epi16(10))),
+      _mm_cvtepu8_epi16(ones));
+  return _mm_sub_epi16(value, offset);
+}
+
+// Returns a mask with the 16 bit lanes set that hold a valid character.
+TRIPLET_DECODER_TARGET("sse4.1")
+inline __m128i ValidCharsSse(__m128i values) {
+  // A value is printable if (value - ' ') <= ('~' - ' ') as an unsigned number,
+  // and is a tab or new line if (value - '\t') <= 1
+  __m128i printable = _mm_sub_epi16(values, _mm_set1_epi16(' '));
+  __m128i whitespace = _mm_sub_epi16(values, _mm_set1_epi16('\t'));
+  __m128i is_printable = _mm_cmpeq_epi16(
+      _mm_min_epu16(printable, _mm_set1_epi16('~' - ' ')), printable);
+  __m128i is_whitespace = _mm_cmpeq_epi16(
+      _mm_min_epu16(whitespace, _mm_set1_epi16(1)), whitespace);
+  return _mm_or_si128(is_printable, is_whitespace);
+}
+
+// Decodes as many whole 48 byte blocks as fit in count groups. Returns the
+// number of groups decoded and sets is_valid to false if a block was bad.
+TRIPLET_DECODER_TARGET("sse4.1")
+size_t DecodeBlocksSse41(const char* input, size_t count, int offset,
+                         char* output, bool& is_valid) {
+  const ShuffleMasks& shuffle_masks = GetShuffleMasks();
+  __m128i masks[kTripletLength][kTripletLength];
+  for (size_t digit = 0; digit < kTripletLength; digit++) {
+    for (size_t reg = 0; reg < kTripletLength; reg++) {
+      masks[digit][reg] = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(shuffle_masks.masks[digit][reg]));
+    }
+  }
+  __m128i offset_vector = _mm_set1_epi16(static_cast<short>(offset));
+
+  size_t index = 0;
+  for (; index + kSseBlockLength <= count; index += kSseBlockLength) {
+    const char* block = input + index * kTripletLength;
+
+    // Loads the 48 bytes and makes sure they are all digits
+    __m128i all_digits = _mm_set1_epi8(-1);
+    __m128i first = ToDigitsSse(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(block)), all_digits);
+    __m128i second = ToDigitsSse(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16)),
+        all_digits);
+    __m128i third = ToDigitsSse(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 32)),
+        all_digits);
+    if (_mm_movemask_epi8(all_digits) != 0xFFFF) {
+      is_valid = false;
+      return index;
+    }
+
+    // Splits the groups into their hundreds, tens, and ones digits
+    __m128i hundreds = GatherDigitSse(first, second, third, masks[0]);
+    __m128i tens = GatherDigitSse(first, second, third, masks[1]);
+    __m128i ones = GatherDigitSse(first, second, third, masks[2]);
+
+    // Calculates the characters of the first and second half of the block
+    __m128i low = CombineDigitsSse(hundreds, tens, ones, offset_vector);
+    __m128i high = CombineDigitsSse(_mm_srli_si128(hundreds, 8),
+                                    _mm_srli_si128(tens, 8),
+                                    _mm_srli_si128(ones, 8), offset_vector);
+
+    __m128i all_valid = _mm_and_si128(ValidCharsSse(low), ValidCharsSse(high));
+    if (_mm_movemask_epi8(all_valid) != 0xFFFF) {
+      is_valid = false;
+      return index;
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + index),
+                     _mm_packus_epi16(low, high));
+  }
+
+  return index;
+}
+
+// Loads 16 bytes from first and 16 bytes from second into one register.
+TRIPLET_DECODER_TARGET("avx2")
+inline __m256i LoadTwoLanesAvx(const char* first, const char* second) {
+  return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(first))),
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(second)), 1);
+}
+
+TRIPLET_DECODER_TARGET("avx2")
+inline __m256i ToDigitsAvx(__m256i bytes, __m256i& all_digits) {
+  __m256i digits = _mm256_sub_epi8(bytes, _mm256_set1_epi8('0'));
+  __m256i is_digit =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+  all_digits = _mm256_and_si256(all_digits, is_digit);
+  return digits;
+}
+
+TRIPLET_DECODER_TARGET("avx2")
+inline __m256i GatherDigitAvx(__m256i first, __m256i second, __m256i third,
+                              const __m256i* masks) {
+  return _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(first, masks[0]),
+                                         _mm256_shuffle_epi8(second, masks[1])),
+                         _mm256_shuffle_epi8(third, masks[2]));
+}
+
+TRIPLET_DECODER_TARGET("avx2")
+inline __m256i CombineDigitsAvx(__m256i hundreds, __m256i tens, __m256i ones,
+                                __m256i offset) {
+  __m256i value = _mm256_add_epi16(
+      _mm256_add_epi16(_mm256_mullo_epi16(hundreds, _mm256_set1_epi16(100)),
+                       _mm256_mullo_epi16(tens, _mm256_set1_epi16(10))),
+      ones);
+  return _mm256_sub_epi16(value, offset);
+}
+
+TRIPLET_DECODER_TARGET("avx2")
+inline __m256i ValidCharsAvx(__m256i values) {
+  __m256i printable = _mm256_sub_epi16(values, _mm256_set1_epi16(' '));
+  __m256i whitespace = _mm256_sub_epi16(values, _mm256_set1_epi16('\t'));
+  __m256i is_printable = _mm256_cmpeq_epi16(
+      _mm256_min_epu16(printable, _mm256_set1_epi16('~' - ' ')), printable);
+  __m256i is_whitespace = _mm256_cmpeq_epi16(
+      _mm256_min_epu16(whitespace, _mm256_set1_epi16(1)), whitespace);
+  return _mm256_or_si256(is_printable, is_whitespace);
+}
+
+// Decodes as many whole 96 byte blocks as fit in count groups. Each 128 bit
+// lane works on its own 48 byte half of the block exactly like the SSE4.1
+// version, since pshufb can't move bytes between lanes.
+TRIPLET_DECODER_TARGET("avx2")
+size_t DecodeBlocksAvx2(const char* input, size_t count, int offset,
+                        char* output, bool& is_valid) {
+  const ShuffleMasks& shuffle_masks = GetShuffleMasks();
+  __m256i masks[kTripletLength][kTripletLength];
+  for (size_t digit = 0; digit < kTripletLength; digit++) {
+    for (size_t reg = 0; reg < kTripletLength; reg++) {
+      masks[digit][reg] = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(shuffle_masks.masks[digit][reg])));
+    }
+  }
+  __m256i offset_vector = _mm256_set1_epi16(static_cast<short>(offset));
+  __m256i zero = _mm256_setzero_si256();
+  const size_t kHalfBlockBytes = kSseBlockLength * kTripletLength;
+
+  size_t index = 0;
+  for (; index + kAvxBlockLength <= count; index += kAvxBlockLength) {
+    const char* block = input + index * kTripletLength;
+
+    // Loads the 96 bytes and makes sure they are all digits
+    __m256i all_digits = _mm256_set1_epi8(-1);
+    __m256i first = ToDigitsAvx(
+        LoadTwoLanesAvx(block, block + kHalfBlockBytes), all_digits);
+    __m256i second = ToDigitsAvx(
+        LoadTwoLanesAvx(block + 16, block + kHalfBlockBytes + 16), all_digits);
+    __m256i third = ToDigitsAvx(
+        LoadTwoLanesAvx(block + 32, block + kHalfBlockBytes + 32), all_digits);
+    if (_mm256_movemask_epi8(all_digits) != -1) {
+      is_valid = false;
+      return index;
+    }
+
+    __m256i hundreds = GatherDigitAvx(first, second, third, masks[0]);
+    __m256i tens = GatherDigitAvx(first, second, third, masks[1]);
+    __m256i ones = GatherDigitAvx(first, second, third, masks[2]);
+
+    // Widening with unpack and narrowing with packus both work per lane, so
+    // the characters come back out in their original order
+    __m256i low = CombineDigitsAvx(_mm256_unpacklo_epi8(hundreds, zero),
+                                   _mm256_unpacklo_epi8(tens, zero),
+                                   _mm256_unpacklo_epi8(ones, zero),
+                                   offset_vector);
+    __m256i high = CombineDigitsAvx(_mm256_unpackhi_epi8(hundreds, zero),
+                                    _mm256_unpackhi_epi8(tens, zero),
+                                    _mm256_unpackhi_epi8(ones, zero),
+                                    offset_vector);
+
+    __m256i all_valid =
+        _mm256_and_si256(ValidCharsAvx(low), ValidCharsAvx(high));
+    if (_mm256_movemask_epi8(all_valid) != -1) {
+      is_valid = false;
+      return index;
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + index),
+                        _mm256_packus_epi16(low, high));
+  }
+
+  return index;
+}
+
+#endif  // TRIPLET_DECODER_X86
+
+// Finds the widest implementation that the CPU and operating system support.
+Implementation DetectImplementation() {
+#ifdef TRIPLET_DECODER_X86
+#ifdef _MSC_VER
+  int cpu_info[4];
+  __cpuid(cpu_info, 0);
+  int highest_leaf = cpu_info[0];
+
+  __cpuid(cpu_info, 1);
+  bool has_sse41 = (cpu_info[2] & (1 << 19)) != 0;
+  // AVX registers can only be used if the OS saves them (OSXSAVE + XCR0)
+  bool has_os_avx = (cpu_info[2] & (1 << 27)) != 0 &&
+                    (cpu_info[2] & (1 << 28)) != 0 &&
+                    (_xgetbv(0) & 0x6) == 0x6;
+
+  bool has_avx2 = false;
+  if (highest_leaf >= 7 && has_os_avx) {
+    __cpuidex(cpu_info, 7, 0);
+    has_avx2 = (cpu_info[1] & (1 << 5)) != 0;
+  }
+#else
+  __builtin_cpu_init();
+  bool has_sse41 = __builtin_cpu_supports("sse4.1");
+  bool has_avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+  if (has_avx2) {
+    return kAvx2;
+  } else if (has_sse41) {
+    return kSse41;
+  }
+#endif
+
+  return kScalar;
+}
+
+Implementation GetImplementation() {
+  static const Implementation implementation = DetectImplementation();
+  return implementation;
+}
+
+}  // namespace
+
+bool DecodeTriplets(const char* input, size_t count, size_t offset,
+                    char* output) {
+  // No group can decode to a valid character with an offset this large
+  if (offset > kMaxTripletValue) {
+    return count == 0;
+  }
+
+  size_t decoded_count = 0;
+  bool is_valid = true;
+
+#ifdef TRIPLET_DECODER_X86
+  int int_offset = static_cast<int>(offset);
+  Implementation implementation = GetImplementation();
+
+  // Decodes full blocks with the widest instructions available, then the rest
+  // with narrower ones
+  if (implementation == kAvx2) {
+    decoded_count +=
+        DecodeBlocksAvx2(input, count, int_offset, output, is_valid);
+  }
+
+  if (is_valid && implementation != kScalar) {
+    decoded_count += DecodeBlocksSse41(
+        input + decoded_count * kTripletLength, count - decoded_count,
+        int_offset, output + decoded_count, is_valid);
+  }
+#endif
+
+  if (!is_valid) {
+    return false;
+  }
+
+  return DecodeTripletsScalar(input + decoded_count * kTripletLength,
+                              count - decoded_count, offset,
+                              output + decoded_count);
+}
+
+bool DecodeTripletsScalar(const char* input, size_t count, size_t offset,
+                          char* output) {
+  if (offset > kMaxTripletValue) {
+    return count == 0;
+  }
+
+  // Loops through every group of 3 digits
+  for (size_t index = 0; index < count; index++) {
+    const char* triplet = input + index * kTripletLength;
+
+    // Gets the value of each digit (non digits wrap around to large values)
+    unsigned hundreds = static_cast<unsigned char>(triplet[0]) - '0';
+    unsigned tens = static_cast<unsigned char>(triplet[1]) - '0';
+    unsigned ones = static_cast<unsigned char>(triplet[2]) - '0';
+    if (hundreds > 9 || tens > 9 || ones > 9) {
+      return false;
+    }
+
+    // Makes sure the group actually refers to a char
+    int char_int_representation =
+        static_cast<int>(hundreds * 100 + tens * 10 + ones) -
+        static_cast<int>(offset);
+    if (!IsValidChar(char_int_representation)) {
+      return false;
+    }
+
+    output[index] = static_cast<char>(char_int_representation);
+  }
+
+  return true;
+}
+
+const char* GetImplementationName() {
+  switch (GetImplementation()) {
+    case kAvx2:
+      return "avx2";
+    case kSse41:
+      return "sse4.1";
+    default:
+      return "scalar";
+  }
+}
+
+}  // namespace tripletdecoder
+
+}  // namespace passwordcontainer
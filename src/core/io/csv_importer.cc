@@ -0,0 +1,129 @@
+#include "core/io/csv_importer.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "core/util.h"
+
+using std::string;
+using std::vector;
+
+namespace passwordcontainer {
+
+namespace {
+
+// The names every detail's column is known by in common exports, with the
+// most specific first. Firefox only names the site by its url.
+const vector<string> kAccountNameColumns = {"name", "title", "account",
+                                            "account_name", "url",
+                                            "login_uri"};
+const vector<string> kUsernameColumns = {"username", "login_username",
+                                         "user", "login", "email"};
+const vector<string> kPasswordColumns = {"password", "login_password"};
+
+// The bytes some programs start UTF-8 files with
+const char* const kByteOrderMark = "\xEF\xBB\xBF";
+
+}  // namespace
+
+CsvImporter::CsvImporter(size_t thread_count, size_t chunk_length)
+    : thread_count_(thread_count), chunk_length_(chunk_length) {
+  if (chunk_length == 0) {
+    throw std::invalid_argument("Invalid parameters passed in to constructor!");
+  }
+}
+
+ImportReport CsvImporter::Import(std::istream& input,
+                                 PasswordContainer& container) const {
+  CsvReader reader(input, thread_count_, chunk_length_);
+  vector<CsvRecord> records = reader.ReadRecords();
+  if (records.empty() || !records.front().error.empty()) {
+    throw std::invalid_argument("Bad CSV header passed in!");
+  }
+
+  // Finds the columns in the header row, after the byte order mark that
+  // spreadsheet programs put at the start of UTF-8 files
+  vector<string>& header = records.front().fields;
+  if (!header.empty() && header.front().compare(0, 3, kByteOrderMark) == 0) {
+    header.front().erase(0, 3);
+  }
+  size_t account_name_column = FindColumn(header, kAccountNameColumns);
+  size_t username_column = FindColumn(header, kUsernameColumns);
+  size_t password_column = FindColumn(header, kPasswordColumns);
+  if (account_name_column == header.size() ||
+      username_column == header.size() || password_column == header.size()) {
+    throw std::invalid_argument("Bad CSV header passed in!");
+  }
+  size_t column_count = std::max(std::max(account_name_column, username_column),
+                                 password_column) +
+                        1;
+  records.erase(records.begin());
+
+  // The names that are already taken, so duplicates are found without
+  // searching the container for every row
+  const vector<string>& existing_names = container.GetAccountNames();
+  std::unordered_set<string> account_names(existing_names.begin(),
+                                           existing_names.end());
+
+  ImportReport report;
+  AccountBatch batch;
+  do {
+    for (CsvRecord& record : records) {
+      report.row_count++;
+
+      if (!record.error.empty()) {
+        report.errors.push_back({record.line_number, record.error});
+        continue;
+      }
+
+      if (record.fields.size() < column_count) {
+        report.errors.push_back({record.line_number, "Missing a column!"});
+        continue;
+      }
+
+      PasswordContainer::AccountDetails account;
+      account.account_name = std::move(record.fields[account_name_column]);
+      account.username = std::move(record.fields[username_column]);
+      account.password = std::move(record.fields[password_column]);
+
+      try {
+        PasswordContainer::ValidateAccountDetails(account);
+      } catch (const std::invalid_argument& exception) {
+        report.errors.push_back({record.line_number, exception.what()});
+        continue;
+      }
+
+      if (!account_names.insert(account.account_name).second) {
+        report.errors.push_back(
+            {record.line_number, "Account already in container!"});
+        continue;
+      }
+
+      batch.AddAccount(account.account_name, account.username,
+                       account.password);
+    }
+
+    records = reader.ReadRecords();
+  } while (!records.empty());
+
+  container.CommitBatch(batch);
+  report.imported_count = batch.GetSize();
+
+  return report;
+}
+
+size_t CsvImporter::FindColumn(const vector<string>& header,
+                               const vector<string>& column_names) {
+  for (const string& column_name : column_names) {
+    for (size_t index = 0; index < header.size(); index++) {
+      if (util::ConvertToLowerCase(header[index]) == column_name) {
+        return index;
+      }
+    }
+  }
+
+  return header.size();
+}
+
+}  // namespace passwordcontainer
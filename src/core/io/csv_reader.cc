@@ -0,0 +1,153 @@
+#include "core/io/csv_reader.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using std::string;
+using std::vector;
+
+namespace passwordcontainer {
+
+const size_t CsvReader::kDefaultChunkLength;
+const size_t CsvReader::kRecordsPerTask;
+
+CsvReader::CsvReader(std::istream& input, size_t thread_count,
+                     size_t chunk_length)
+    : input_(input), chunk_length_(chunk_length) {
+  if (chunk_length == 0) {
+    throw std::invalid_argument("Invalid parameters passed in to constructor!");
+  }
+
+  if (thread_count != 1) {
+    thread_pool_ = std::make_shared<ThreadPool>(thread_count);
+  }
+}
+
+vector<CsvRecord> CsvReader::ReadRecords() {
+  vector<CsvRecord> records;
+
+  // Keeps reading until a chunk has a record that isn't blank, since a chunk
+  // can be all blank lines or one long quoted field
+  while (records.empty() && !(is_input_done_ && buffer_.empty())) {
+    if (!is_input_done_) {
+      size_t old_length = buffer_.size();
+      buffer_.resize(old_length + chunk_length_);
+      input_.read(&buffer_[old_length], chunk_length_);
+      size_t read_length = static_cast<size_t>(input_.gcount());
+      buffer_.resize(old_length + read_length);
+      is_input_done_ = read_length < chunk_length_;
+    }
+
+    // Finds the line breaks that end records, which are the ones outside
+    // quotes. An escaped quote is two quotes, so it never changes whether the
+    // reader is inside quotes.
+    vector<size_t> record_starts, record_ends;
+    size_t record_start = 0;
+    size_t line_number = line_number_;
+    bool is_in_quotes = false;
+    for (size_t index = 0; index < buffer_.size(); index++) {
+      if (buffer_[index] == '"') {
+        is_in_quotes = !is_in_quotes;
+      } else if (buffer_[index] == '\n') {
+        line_number++;
+        if (!is_in_quotes) {
+          record_starts.push_back(record_start);
+          record_ends.push_back(index);
+          record_start = index + 1;
+          records.emplace_back();
+          records.back().line_number = line_number_;
+          line_number_ = line_number;
+        }
+      }
+    }
+
+    // The last record doesn't need a line break once the input is done
+    if (is_input_done_ && record_start < buffer_.size()) {
+      record_starts.push_back(record_start);
+      record_ends.push_back(buffer_.size());
+      record_start = buffer_.size();
+      records.emplace_back();
+      records.back().line_number = line_number_;
+    }
+
+    auto parse_range = [&](size_t begin, size_t end) {
+      for (size_t index = begin; index < end; index++) {
+        ParseRecord(buffer_.data() + record_starts[index],
+                    buffer_.data() + record_ends[index], records[index]);
+      }
+    };
+
+    if (!thread_pool_ || records.size() <= kRecordsPerTask) {
+      parse_range(0, records.size());
+    } else {
+      thread_pool_->ParallelFor(records.size(), kRecordsPerTask, parse_range);
+    }
+
+    buffer_.erase(0, record_start);
+    records.erase(std::remove_if(records.begin(), records.end(),
+                                 [](const CsvRecord& record) {
+                                   return record.fields.empty() &&
+                                          record.error.empty();
+                                 }),
+                  records.end());
+  }
+
+  return records;
+}
+
+void CsvReader::ParseRecord(const char* begin, const char* end,
+                            CsvRecord& record) {
+  if (begin != end && *(end - 1) == '\r') {
+    end--;
+  }
+
+  if (begin == end) {
+    return;
+  }
+
+  const char* position = begin;
+  while (true) {
+    string field;
+
+    if (position != end && *position == '"') {
+      // Copies the quoted text up to every quote and keeps going past the
+      // quotes that are escaped
+      position++;
+      while (true) {
+        const char* quote = std::find(position, end, '"');
+        if (quote == end) {
+          record.error = "Unterminated quoted field!";
+          return;
+        }
+
+        field.append(position, quote);
+        position = quote + 1;
+        if (position == end || *position != '"') {
+          break;
+        }
+
+        field += '"';
+        position++;
+      }
+
+      if (position != end && *position != ',') {
+        record.error = "Unexpected character after a quoted field!";
+        return;
+      }
+    } else {
+      const char* comma = std::find(position, end, ',');
+      field.assign(position, comma);
+      position = comma;
+    }
+
+    record.fields.push_back(field);
+    if (position == end) {
+      break;
+    }
+
+    // Skips the comma before the next field
+    position++;
+  }
+}
+
+}  // namespace passwordcontainer
@@ -0,0 +1,40 @@
+#include "core/io/json_exporter.h"
+
+#include <stdexcept>
+
+#include "core/io/json_writer.h"
+
+namespace passwordcontainer {
+
+const size_t JsonExporter::kFormatVersion;
+
+void JsonExporter::Export(const PasswordContainer& container,
+                          std::ostream& output) {
+  JsonWriter writer(output);
+  writer.BeginObject();
+  writer.Key("version");
+  writer.Number(kFormatVersion);
+  writer.Key("accounts");
+  writer.BeginArray();
+
+  for (size_t index = 0; index < container.GetAccountCount(); index++) {
+    PasswordContainer::AccountDetails account = container.GetAccount(index);
+    writer.BeginObject();
+    writer.Key("name");
+    writer.String(account.account_name);
+    writer.Key("username");
+    writer.String(account.username);
+    writer.Key("password");
+    writer.String(account.password);
+    writer.EndObject();
+  }
+
+  writer.EndArray();
+  writer.EndObject();
+
+  if (!output) {
+    throw std::invalid_argument("Could not write the JSON!");
+  }
+}
+
+}  // namespace passwordcontainer
@@ -0,0 +1,229 @@
+#include "core/io/json_importer.h"
+
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include "core/io/json_exporter.h"
+#include "core/io/json_reader.h"
+
+using std::string;
+using std::vector;
+
+namespace passwordcontainer {
+
+namespace {
+
+// The depths of the values in the format, where the outer object is 1
+const size_t kRootDepth = 1;
+const size_t kAccountsDepth = 2;
+const size_t kAccountDepth = 3;
+
+// Collects the accounts from the parts of the JSON as they are parsed.
+class AccountHandler : public JsonHandler {
+ public:
+  AccountHandler(const JsonReader& reader,
+                 const vector<string>& existing_names)
+      : reader_(reader),
+        account_names_(existing_names.begin(), existing_names.end()) {
+  }
+
+  void StartObject() override {
+    StartContainer(true);
+  }
+
+  void EndObject() override {
+    EndContainer();
+  }
+
+  void StartArray() override {
+    StartContainer(false);
+  }
+
+  void EndArray() override {
+    EndContainer();
+  }
+
+  void Key(const string& key) override {
+    key_ = key;
+  }
+
+  void String(const string& value) override {
+    if (!is_in_accounts_) {
+      return;
+    }
+
+    if (depth_ == kAccountsDepth) {
+      AddRowError("Account isn't an object!");
+    } else if (depth_ == kAccountDepth && account_error_.empty()) {
+      if (key_ == "name") {
+        account_.account_name = value;
+      } else if (key_ == "username") {
+        account_.username = value;
+      } else if (key_ == "password") {
+        account_.password = value;
+      }
+    }
+  }
+
+  void Number(double value) override {
+    if (depth_ == kRootDepth && key_ == "version" &&
+        value > JsonExporter::kFormatVersion) {
+      throw std::invalid_argument("Unsupported JSON version passed in!");
+    }
+
+    OtherValue();
+  }
+
+  void Bool(bool /*value*/) override {
+    OtherValue();
+  }
+
+  void Null() override {
+    OtherValue();
+  }
+
+  // Throws an invalid_argument exception if there was no accounts array.
+  void CheckHasAccounts() const {
+    if (!has_accounts_) {
+      throw std::invalid_argument("Bad JSON passed in!");
+    }
+  }
+
+  ImportReport& GetReport() {
+    return report_;
+  }
+
+  const AccountBatch& GetBatch() const {
+    return batch_;
+  }
+
+ private:
+  const JsonReader& reader_;
+
+  // The number of objects and arrays that are open
+  size_t depth_ = 0;
+
+  // The last key that was read
+  string key_;
+
+  // Whether the reader is in the accounts array and whether it was found
+  bool is_in_accounts_ = false;
+  bool has_accounts_ = false;
+
+  // The account being read, the line it started on, and what is wrong with
+  // it if anything
+  PasswordContainer::AccountDetails account_;
+  size_t account_line_number_ = 0;
+  string account_error_;
+
+  // The names that are already taken, so duplicates are found without
+  // searching the container for every account
+  std::unordered_set<string> account_names_;
+
+  ImportReport report_;
+  AccountBatch batch_;
+
+  void StartContainer(bool is_object) {
+    depth_++;
+
+    if (depth_ == kRootDepth && !is_object) {
+      throw std::invalid_argument("Bad JSON passed in!");
+    } else if (depth_ == kAccountsDepth && key_ == "accounts") {
+      if (is_object) {
+        throw std::invalid_argument("Bad JSON passed in!");
+      }
+      is_in_accounts_ = true;
+      has_accounts_ = true;
+    } else if (depth_ == kAccountDepth && is_in_accounts_) {
+      account_ = PasswordContainer::AccountDetails();
+      account_line_number_ = reader_.GetLineNumber();
+      account_error_ = is_object ? "" : "Account isn't an object!";
+    } else if (depth_ == kAccountDepth + 1 && is_in_accounts_ &&
+               IsDetailKey(key_)) {
+      account_error_ = "Account details must be strings!";
+    }
+
+    // Keys only belong to the object they are in
+    key_.clear();
+  }
+
+  void EndContainer() {
+    if (depth_ == kAccountDepth && is_in_accounts_) {
+      AddAccount();
+    } else if (depth_ == kAccountsDepth) {
+      is_in_accounts_ = false;
+    }
+
+    depth_--;
+  }
+
+  // Handles a value that isn't a string, which is only allowed outside the
+  // accounts or for keys that aren't part of the format
+  void OtherValue() {
+    if (!is_in_accounts_) {
+      return;
+    }
+
+    if (depth_ == kAccountsDepth) {
+      AddRowError("Account isn't an object!");
+    } else if (depth_ == kAccountDepth && IsDetailKey(key_)) {
+      account_error_ = "Account details must be strings!";
+    }
+  }
+
+  // Returns whether the passed in key is one of the details of an account.
+  static bool IsDetailKey(const string& key) {
+    return key == "name" || key == "username" || key == "password";
+  }
+
+  // Lists the account at the current line as not imported.
+  void AddRowError(const string& message) {
+    report_.row_count++;
+    report_.errors.push_back({reader_.GetLineNumber(), message});
+  }
+
+  // Checks the account that was just read and adds it if it is valid.
+  void AddAccount() {
+    report_.row_count++;
+
+    if (account_error_.empty()) {
+      try {
+        PasswordContainer::ValidateAccountDetails(account_);
+      } catch (const std::invalid_argument& exception) {
+        account_error_ = exception.what();
+      }
+    }
+
+    if (account_error_.empty() &&
+        !account_names_.insert(account_.account_name).second) {
+      account_error_ = "Account already in container!";
+    }
+
+    if (!account_error_.empty()) {
+      report_.errors.push_back({account_line_number_, account_error_});
+      return;
+    }
+
+    batch_.AddAccount(account_.account_name, account_.username,
+                      account_.password);
+  }
+};
+
+}  // namespace
+
+ImportReport JsonImporter::Import(std::istream& input,
+                                  PasswordContainer& container) {
+  JsonReader reader(input);
+  AccountHandler handler(reader, container.GetAccountNames());
+  reader.Parse(handler);
+  handler.CheckHasAccounts();
+
+  container.CommitBatch(handler.GetBatch());
+  ImportReport& report = handler.GetReport();
+  report.imported_count = handler.GetBatch().GetSize();
+
+  return report;
+}
+
+}  // namespace passwordcontainer
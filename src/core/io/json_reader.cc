@@ -0,0 +1,334 @@
+#include "core/io/json_reader.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+using std::string;
+
+namespace passwordcontainer {
+
+const size_t JsonReader::kDefaultBufferLength;
+const size_t JsonReader::kMaxDepth;
+
+namespace {
+
+// Appends the UTF-8 encoding of the passed in code point to text.
+void AppendUtf8(unsigned int code_point, string& text) {
+  if (code_point < 0x80) {
+    text += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    text += static_cast<char>(0xC0 | (code_point >> 6));
+    text += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    text += static_cast<char>(0xE0 | (code_point >> 12));
+    text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    text += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    text += static_cast<char>(0xF0 | (code_point >> 18));
+    text += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    text += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
+
+}  // namespace
+
+JsonReader::JsonReader(std::istream& input, size_t buffer_length)
+    : input_(input), buffer_(buffer_length) {
+  if (buffer_length == 0) {
+    throw std::invalid_argument("Invalid parameters passed in to constructor!");
+  }
+}
+
+void JsonReader::Parse(JsonHandler& handler) {
+  // Whether every object or array that is open is an object, innermost last
+  std::vector<bool> is_object_stack;
+  bool is_expecting_value = true;
+
+  while (true) {
+    SkipWhitespace();
+
+    if (is_expecting_value) {
+      char character = Next();
+      if ((character == '{' || character == '[') &&
+          is_object_stack.size() == kMaxDepth) {
+        Fail();
+      }
+
+      switch (character) {
+        case '{':
+          handler.StartObject();
+          SkipWhitespace();
+          if (Peek() == '}') {
+            Next();
+            handler.EndObject();
+            is_expecting_value = false;
+          } else {
+            is_object_stack.push_back(true);
+            ReadKey(handler);
+          }
+          break;
+        case '[':
+          handler.StartArray();
+          SkipWhitespace();
+          if (Peek() == ']') {
+            Next();
+            handler.EndArray();
+            is_expecting_value = false;
+          } else {
+            is_object_stack.push_back(false);
+          }
+          break;
+        case '"':
+          handler.String(ReadString());
+          is_expecting_value = false;
+          break;
+        case 't':
+          ReadLiteral("true");
+          handler.Bool(true);
+          is_expecting_value = false;
+          break;
+        case 'f':
+          ReadLiteral("false");
+          handler.Bool(false);
+          is_expecting_value = false;
+          break;
+        case 'n':
+          ReadLiteral("null");
+          handler.Null();
+          is_expecting_value = false;
+          break;
+        default:
+          handler.Number(ReadNumber(character));
+          is_expecting_value = false;
+          break;
+      }
+    } else {
+      // Reads the comma before the next value or the end of the innermost
+      // object or array
+      char character = Next();
+      if (character == ',') {
+        if (is_object_stack.back()) {
+          ReadKey(handler);
+        }
+        is_expecting_value = true;
+      } else if (character == '}' && is_object_stack.back()) {
+        is_object_stack.pop_back();
+        handler.EndObject();
+      } else if (character == ']' && !is_object_stack.back()) {
+        is_object_stack.pop_back();
+        handler.EndArray();
+      } else {
+        Fail();
+      }
+    }
+
+    // Nothing but whitespace can come after the value at the top
+    if (!is_expecting_value && is_object_stack.empty()) {
+      SkipWhitespace();
+      if (Peek() != -1) {
+        Fail();
+      }
+      return;
+    }
+  }
+}
+
+size_t JsonReader::GetLineNumber() const {
+  return line_number_;
+}
+
+int JsonReader::Peek() {
+  if (position_ == end_) {
+    input_.read(buffer_.data(), buffer_.size());
+    position_ = 0;
+    end_ = static_cast<size_t>(input_.gcount());
+    if (end_ == 0) {
+      return -1;
+    }
+  }
+
+  return static_cast<unsigned char>(buffer_[position_]);
+}
+
+char JsonReader::Next() {
+  if (Peek() == -1) {
+    Fail();
+  }
+
+  char character = buffer_[position_++];
+  if (character == '\n') {
+    line_number_++;
+  }
+
+  return character;
+}
+
+void JsonReader::SkipWhitespace() {
+  for (int character = Peek();
+       character == ' ' || character == '\t' || character == '\n' ||
+       character == '\r';
+       character = Peek()) {
+    Next();
+  }
+}
+
+string JsonReader::ReadString() {
+  string text;
+
+  while (true) {
+    // Copies the run of plain characters in the buffer at once
+    if (Peek() == -1) {
+      Fail();
+    }
+    size_t run_end = position_;
+    while (run_end < end_ && buffer_[run_end] != '"' &&
+           buffer_[run_end] != '\\' &&
+           static_cast<unsigned char>(buffer_[run_end]) >= 0x20) {
+      run_end++;
+    }
+    text.append(buffer_.data() + position_, run_end - position_);
+    position_ = run_end;
+    if (position_ == end_) {
+      continue;
+    }
+
+    char character = Next();
+    if (character == '"') {
+      return text;
+    }
+
+    // Control characters have to be escaped
+    if (character != '\\') {
+      Fail();
+    }
+
+    character = Next();
+    switch (character) {
+      case '"':
+      case '\\':
+      case '/':
+        text += character;
+        break;
+      case 'b':
+        text += '\b';
+        break;
+      case 'f':
+        text += '\f';
+        break;
+      case 'n':
+        text += '\n';
+        break;
+      case 'r':
+        text += '\r';
+        break;
+      case 't':
+        text += '\t';
+        break;
+      case 'u': {
+        unsigned int code_point = ReadHexCode();
+
+        // Characters outside the first plane are written as a pair of
+        // surrogates
+        if (code_point >= 0xD800 && code_point < 0xDC00) {
+          if (Next() != '\\' || Next() != 'u') {
+            Fail();
+          }
+          unsigned int low_surrogate = ReadHexCode();
+          if (low_surrogate < 0xDC00 || low_surrogate >= 0xE000) {
+            Fail();
+          }
+          code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                       (low_surrogate - 0xDC00);
+        } else if (code_point >= 0xDC00 && code_point < 0xE000) {
+          Fail();
+        }
+
+        AppendUtf8(code_point, text);
+        break;
+      }
+      default:
+        Fail();
+    }
+  }
+}
+
+unsigned int JsonReader::ReadHexCode() {
+  unsigned int value = 0;
+  for (size_t index = 0; index < 4; index++) {
+    char character = Next();
+    value <<= 4;
+    if (character >= '0' && character <= '9') {
+      value |= character - '0';
+    } else if (character >= 'a' && character <= 'f') {
+      value |= character - 'a' + 10;
+    } else if (character >= 'A' && character <= 'F') {
+      value |= character - 'A' + 10;
+    } else {
+      Fail();
+    }
+  }
+
+  return value;
+}
+
+double JsonReader::ReadNumber(char first_character) {
+  // Collects the characters a number can have and lets strtod check them
+  string text(1, first_character);
+  for (int character = Peek();
+       (character >= '0' && character <= '9') || character == '-' ||
+       character == '+' || character == '.' || character == 'e' ||
+       character == 'E';
+       character = Peek()) {
+    text += Next();
+  }
+
+  // JSON numbers start with a minus or a digit and have no leading zeros,
+  // which strtod doesn't check
+  size_t digits_start = first_character == '-' ? 1 : 0;
+  if (digits_start == text.size() ||
+      !std::isdigit(static_cast<unsigned char>(text[digits_start])) ||
+      (text[digits_start] == '0' && digits_start + 1 < text.size() &&
+       std::isdigit(static_cast<unsigned char>(text[digits_start + 1])))) {
+    Fail();
+  }
+
+  char* number_end = nullptr;
+  double value = std::strtod(text.c_str(), &number_end);
+  if (number_end != text.c_str() + text.size()) {
+    Fail();
+  }
+
+  return value;
+}
+
+void JsonReader::ReadLiteral(const char* literal) {
+  for (size_t index = 1; literal[index] != '\0'; index++) {
+    if (Next() != literal[index]) {
+      Fail();
+    }
+  }
+}
+
+void JsonReader::ReadKey(JsonHandler& handler) {
+  SkipWhitespace();
+  if (Next() != '"') {
+    Fail();
+  }
+  string key = ReadString();
+
+  SkipWhitespace();
+  if (Next() != ':') {
+    Fail();
+  }
+
+  handler.Key(key);
+}
+
+void JsonReader::Fail() const {
+  throw std::invalid_argument("Bad JSON on line " +
+                              std::to_string(line_number_) + "!");
+}
+
+}  // namespace passwordcontainer
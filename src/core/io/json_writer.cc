@@ -0,0 +1,151 @@
+#include "core/io/json_writer.h"
+
+using std::string;
+
+namespace passwordcontainer {
+
+namespace {
+
+// The number of spaces every level of nesting is indented by
+const size_t kIndentLength = 2;
+
+// The character written after a backslash for every byte, 'u' for bytes that
+// are written as \u00XX, or 0 for bytes that are written as they are
+class EscapeTable {
+ public:
+  EscapeTable() {
+    for (size_t byte = 0; byte < 256; byte++) {
+      escapes_[byte] = byte < 0x20 ? 'u' : 0;
+    }
+
+    escapes_[static_cast<unsigned char>('\b')] = 'b';
+    escapes_[static_cast<unsigned char>('\f')] = 'f';
+    escapes_[static_cast<unsigned char>('\n')] = 'n';
+    escapes_[static_cast<unsigned char>('\r')] = 'r';
+    escapes_[static_cast<unsigned char>('\t')] = 't';
+    escapes_[static_cast<unsigned char>('"')] = '"';
+    escapes_[static_cast<unsigned char>('\\')] = '\\';
+  }
+
+  char Get(char character) const {
+    return escapes_[static_cast<unsigned char>(character)];
+  }
+
+ private:
+  char escapes_[256];
+};
+
+const EscapeTable kEscapeTable;
+
+const char kHexDigits[] = "0123456789abcdef";
+
+}  // namespace
+
+JsonWriter::JsonWriter(std::ostream& output) : output_(output) {
+}
+
+void JsonWriter::BeginObject() {
+  BeginValue();
+  output_.put('{');
+  has_values_.push_back(false);
+}
+
+void JsonWriter::EndObject() {
+  EndContainer('}');
+}
+
+void JsonWriter::BeginArray() {
+  BeginValue();
+  output_.put('[');
+  has_values_.push_back(false);
+}
+
+void JsonWriter::EndArray() {
+  EndContainer(']');
+}
+
+void JsonWriter::Key(const string& key) {
+  BeginValue();
+  WriteEscapedString(output_, key);
+  output_.write(": ", 2);
+  is_after_key_ = true;
+}
+
+void JsonWriter::String(const string& value) {
+  BeginValue();
+  WriteEscapedString(output_, value);
+}
+
+void JsonWriter::Number(size_t value) {
+  BeginValue();
+  output_ << value;
+}
+
+void JsonWriter::WriteEscapedString(std::ostream& output, const string& text) {
+  output.put('"');
+
+  // Writes every run of characters that don't need escaping in one call
+  size_t run_start = 0;
+  for (size_t index = 0; index < text.size(); index++) {
+    char escape = kEscapeTable.Get(text[index]);
+    if (escape == 0) {
+      continue;
+    }
+
+    output.write(text.data() + run_start, index - run_start);
+    output.put('\\');
+    output.put(escape);
+    if (escape == 'u') {
+      unsigned char byte = static_cast<unsigned char>(text[index]);
+      output.write("00", 2);
+      output.put(kHexDigits[byte >> 4]);
+      output.put(kHexDigits[byte & 0xF]);
+    }
+    run_start = index + 1;
+  }
+
+  output.write(text.data() + run_start, text.size() - run_start);
+  output.put('"');
+}
+
+void JsonWriter::BeginValue() {
+  // Values after keys go right after the colon
+  if (is_after_key_) {
+    is_after_key_ = false;
+    return;
+  }
+
+  if (has_values_.empty()) {
+    return;
+  }
+
+  if (has_values_.back()) {
+    output_.put(',');
+  }
+  has_values_.back() = true;
+  WriteIndentation();
+}
+
+void JsonWriter::EndContainer(char bracket) {
+  bool has_values = has_values_.back();
+  has_values_.pop_back();
+
+  // Empty containers are closed on the same line
+  if (has_values) {
+    WriteIndentation();
+  }
+  output_.put(bracket);
+
+  if (has_values_.empty()) {
+    output_.put('\n');
+  }
+}
+
+void JsonWriter::WriteIndentation() {
+  output_.put('\n');
+  for (size_t index = 0; index < has_values_.size() * kIndentLength; index++) {
+    output_.put(' ');
+  }
+}
+
+}  // namespace passwordcontainer
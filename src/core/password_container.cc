@@ -1,8 +1,18 @@
 #include "core/password_container.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <set>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
+#include "core/thread_pool.h"
 #include "core/util.h"
+#include "core/vault_header.h"
+#include "core/encryption/key_cache.h"
+#include "core/encryption/key_derivation.h"
 #include "core/encryption/sha256.h"
 
 using std::string;
@@ -10,27 +20,361 @@ using std::vector;
 
 namespace passwordcontainer {
 
+namespace {
+
+// The characters the save file separates details and accounts with, which
+// can't be in any detail
+const char* const kDetailSeparators = "\t\r\n";
+
+// Returns the username in username_table at the index written in table_index.
+// Throws an invalid_argument exception if table_index isn't a valid index.
+const string& LookUpUsername(const vector<string>& username_table,
+                             const string& table_index) {
+  if (table_index.empty() ||
+      table_index.find_first_not_of("0123456789") != string::npos) {
+    throw std::invalid_argument("Bad data passed in!");
+  }
+
+  size_t index;
+  try {
+    index = static_cast<size_t>(std::stoull(table_index));
+  } catch (...) {
+    throw std::invalid_argument("Bad data passed in!");
+  }
+
+  if (index >= username_table.size()) {
+    throw std::invalid_argument("Bad data passed in!");
+  }
+
+  return username_table[index];
+}
+
+}  // namespace
+
 PasswordContainer::PasswordContainer(size_t offset, const string& key)
-    : cryptographer_(offset, sha256(key)) {
+    : cryptographer_(offset, sha256(key)),
+      hashed_key_(sha256(key)),
+      kdf_iterations_(kDefaultKdfIterations),
+      kdf_salt_(keyderivation::GenerateSalt(kKdfSaltLength)),
+      password_arena_(kPasswordBlockSize) {
+  if (key.empty()) {
+    throw std::invalid_argument("Invalid parameters passed in to constructor!");
+  }
+}
+
+const size_t PasswordContainer::kNoAccountIndex;
+
+bool PasswordContainer::AccountHandle::operator==(
+    const AccountHandle& other) const {
+  return id == other.id && generation == other.generation;
+}
+
+bool PasswordContainer::AccountHandle::operator!=(
+    const AccountHandle& other) const {
+  return !(*this == other);
 }
 
 vector<PasswordContainer::AccountDetails> PasswordContainer::GetAccounts()
     const {
-  return accounts_;
+  vector<AccountDetails> accounts;
+  accounts.reserve(account_names_.size());
+
+  // Puts the details at every index of the columns back together
+  for (size_t index = 0; index < account_names_.size(); index++) {
+    accounts.push_back(GetAccount(index));
+  }
+
+  return accounts;
+}
+
+const vector<string>& PasswordContainer::GetAccountNames() const {
+  return account_names_;
+}
+
+void PasswordContainer::SetUsernamePooling(bool is_enabled) {
+  is_username_pooling_enabled_ = is_enabled;
+}
+
+bool PasswordContainer::IsUsernamePoolingEnabled() const {
+  return is_username_pooling_enabled_;
+}
+
+size_t PasswordContainer::GetUniqueUsernameCount() const {
+  return usernames_.GetSize();
+}
+
+size_t PasswordContainer::GetAccountCount() const {
+  return account_names_.size();
+}
+
+size_t PasswordContainer::GetRevision() const {
+  return revision_;
+}
+
+PasswordContainer::AccountDetails PasswordContainer::GetAccount(
+    size_t index) const {
+  if (index >= account_names_.size()) {
+    throw std::invalid_argument("Invalid index passed in!");
+  }
+
+  return GetAccountInSlot(index);
+}
+
+PasswordContainer::AccountDetails PasswordContainer::GetAccount(
+    const AccountHandle& handle) const {
+  return GetAccountInSlot(GetSlot(handle));
+}
+
+const string& PasswordContainer::GetAccountName(
+    const AccountHandle& handle) const {
+  return account_names_[GetSlot(handle)];
+}
+
+PasswordContainer::AccountHandle PasswordContainer::GetAccountHandle(
+    size_t index) const {
+  if (index >= account_names_.size()) {
+    throw std::invalid_argument("Invalid index passed in!");
+  }
+
+  AccountHandle handle;
+  handle.id = handle_ids_[index];
+  handle.generation = handle_entries_[handle.id].generation;
+  return handle;
+}
+
+PasswordContainer::AccountHandle PasswordContainer::FindAccountHandle(
+    const string& account_name) const {
+  auto id = handle_ids_by_name_.find(account_name);
+  if (id == handle_ids_by_name_.end()) {
+    return AccountHandle();
+  }
+
+  AccountHandle handle;
+  handle.id = id->second;
+  handle.generation = handle_entries_[handle.id].generation;
+  return handle;
+}
+
+bool PasswordContainer::IsValidHandle(const AccountHandle& handle) const {
+  // Generations start at 1, so default constructed handles are never valid
+  return handle.id < handle_entries_.size() &&
+         handle_entries_[handle.id].generation == handle.generation &&
+         handle.generation != 0;
+}
+
+size_t PasswordContainer::GetAccountIndex(const AccountHandle& handle) const {
+  if (!IsValidHandle(handle)) {
+    throw std::invalid_argument("Invalid handle passed in!");
+  }
+
+  return handle_entries_[handle.id].slot;
 }
 
 void PasswordContainer::SetCryptographerKey(const std::string& new_key) {
-  cryptographer_.SetKey(sha256(new_key));
+  if (new_key.empty()) {
+    throw std::invalid_argument("Invalid parameter passed in to SetKey!");
+  }
+
+  // Uses a new salt for the new key so it is derived differently
+  hashed_key_ = sha256(new_key);
+  kdf_salt_ = keyderivation::GenerateSalt(kKdfSaltLength);
+  is_key_derived_ = false;
 }
 
 string PasswordContainer::GetCryptographerKey() const {
-  return cryptographer_.GetKey();
+  return GetCryptographer().GetKey();
 }
 
 void PasswordContainer::SetCryptographerOffset(size_t offset) {
   cryptographer_.SetOffset(offset);
 }
 
+void PasswordContainer::SetCryptographerParallelism(size_t thread_count,
+                                                    size_t serial_threshold) {
+  cryptographer_.SetParallelism(thread_count, serial_threshold);
+  thread_count_ = thread_count;
+}
+
+void PasswordContainer::SetKdfIterations(size_t iterations) {
+  if (iterations < keyderivation::kMinimumIterations) {
+    throw std::invalid_argument("The passed in iterations are too few.");
+  } else if (iterations > keyderivation::kMaximumIterations) {
+    throw std::invalid_argument("The passed in iterations are too many.");
+  }
+
+  kdf_iterations_ = iterations;
+  is_key_derived_ = false;
+}
+
+size_t PasswordContainer::GetKdfIterations() const {
+  return kdf_iterations_;
+}
+
+size_t PasswordContainer::CalibrateKdfIterations(
+    std::chrono::milliseconds target_latency) {
+  SetKdfIterations(keyderivation::CalibrateIterations(target_latency));
+  return kdf_iterations_;
+}
+
+const Cryptographer& PasswordContainer::GetCryptographer() const {
+  if (!is_key_derived_) {
+    DeriveCipherKey(hashed_key_, kdf_salt_, kdf_iterations_, cryptographer_);
+    is_key_derived_ = true;
+  }
+
+  return cryptographer_;
+}
+
+void PasswordContainer::DeriveCipherKey(const string& hashed_key,
+                                        const string& salt, size_t iterations,
+                                        Cryptographer& cryptographer) {
+  // Keys that aren't stretched use the hash of the key directly
+  if (iterations == 0) {
+    cryptographer.SetKey(hashed_key);
+    return;
+  }
+
+  // Only runs the slow derivation if this key hasn't been derived with the
+  // same salt and iterations earlier in the process
+  KeyCache& key_cache = KeyCache::GetInstance();
+  string derived_key;
+  if (!key_cache.Find(hashed_key, salt, iterations, derived_key)) {
+    derived_key = keyderivation::Pbkdf2HmacSha256(
+        hashed_key, salt, iterations, keyderivation::kDerivedKeyLength);
+    key_cache.Insert(hashed_key, salt, iterations, derived_key);
+  }
+
+  string cipher_key = keyderivation::ConvertToHex(derived_key);
+  keyderivation::WipeString(derived_key);
+  cryptographer.SetKey(cipher_key);
+  keyderivation::WipeString(cipher_key);
+}
+
+void PasswordContainer::RekeyFile(
+    const string& file_path, const string& new_key,
+    const VaultRekeyer::ProgressCallback& progress) {
+  if (new_key.empty()) {
+    throw std::invalid_argument("Invalid parameter passed in to RekeyFile!");
+  }
+
+  std::ifstream file_input(file_path, std::ios::binary);
+  if (!file_input.is_open()) {
+    throw std::invalid_argument("There is no file in the passed in location!");
+  }
+
+  // The cryptographers used for the chunks can't use the container's thread
+  // pool since the chunks are already split across threads
+  Cryptographer old_cryptographer(cryptographer_);
+  old_cryptographer.SetParallelism(1, 0);
+  Cryptographer new_cryptographer(old_cryptographer);
+
+  // Derives the old key the same way it was derived when the file was saved.
+  // The data is only re-encrypted, so its layout is kept from the old header.
+  VaultHeader old_header;
+  if (VaultHeader::IsPresent(file_input)) {
+    file_input >> old_header;
+    DeriveCipherKey(hashed_key_,
+                    keyderivation::ConvertFromHex(old_header.kdf_salt),
+                    old_header.kdf_iterations, old_cryptographer);
+
+    if (!old_cryptographer.MatchesKeyCheck(old_header.key_check)) {
+      throw std::invalid_argument("Wrong key passed in!");
+    }
+  } else {
+    old_cryptographer.SetKey(hashed_key_);
+  }
+
+  // Finds how much encrypted data is left after the header
+  std::streampos data_start = file_input.tellg();
+  file_input.seekg(0, std::ios::end);
+  size_t total_length = static_cast<size_t>(file_input.tellg() - data_start);
+  file_input.seekg(data_start);
+
+  // Files that weren't stretched are stretched with the default iterations
+  string new_hashed_key = sha256(new_key);
+  string new_salt = keyderivation::GenerateSalt(kKdfSaltLength);
+  size_t new_iterations =
+      kdf_iterations_ == 0 ? kDefaultKdfIterations : kdf_iterations_;
+  DeriveCipherKey(new_hashed_key, new_salt, new_iterations, new_cryptographer);
+
+  VaultHeader new_header;
+  new_header.key_check = new_cryptographer.CalculateKeyCheck();
+  new_header.kdf_iterations = new_iterations;
+  new_header.kdf_salt = keyderivation::ConvertToHex(new_salt);
+  new_header.has_username_table = old_header.has_username_table;
+
+  // Writes the rekeyed file next to the original so it can replace it at once
+  string temporary_path = file_path + ".rekey";
+  try {
+    std::ofstream file_output(temporary_path, std::ios::binary);
+    if (!file_output.is_open()) {
+      throw std::invalid_argument("The passed location doesn't exist!");
+    }
+
+    file_output << new_header;
+
+    VaultRekeyer rekeyer(thread_count_, kRekeyChunkLength);
+    rekeyer.Reencrypt(file_input, file_output, old_cryptographer,
+                      new_cryptographer, total_length, progress);
+
+    file_output.close();
+    file_input.close();
+    if (!file_output) {
+      throw std::invalid_argument("The rekeyed data couldn't be written!");
+    }
+
+    VaultRekeyer::OverwriteFile(temporary_path, file_path);
+  } catch (...) {
+    std::remove(temporary_path.c_str());
+    throw;
+  }
+
+  // Uses the same key as the file from now on
+  hashed_key_ = new_hashed_key;
+  kdf_salt_ = new_salt;
+  kdf_iterations_ = new_iterations;
+  is_key_derived_ = false;
+}
+
+bool PasswordContainer::LoadFile(const string& file_path,
+                                 const LoadProgressCallback& progress) {
+  std::ifstream file_input(file_path, std::ios::binary);
+  if (!file_input.is_open()) {
+    throw std::invalid_argument("There is no file in the passed in location!");
+  }
+
+  file_input.seekg(0, std::ios::end);
+  size_t file_length = static_cast<size_t>(file_input.tellg());
+  file_input.seekg(0);
+
+  ReadHeader(file_input);
+
+  // Decrypts the file a chunk at a time so progress can be shown and loading
+  // can be stopped between chunks. Every chunk is a whole number of encrypted
+  // characters, which are decrypted on their own.
+  string decrypted_string;
+  string chunk(kLoadChunkLength, '\0');
+  while (file_input) {
+    file_input.read(&chunk[0], chunk.size());
+    size_t read_length = static_cast<size_t>(file_input.gcount());
+    if (read_length == 0) {
+      break;
+    }
+
+    chunk.resize(read_length);
+    decrypted_string += GetCryptographer().DecryptString(chunk);
+
+    size_t read_total = file_input ? static_cast<size_t>(file_input.tellg())
+                                   : file_length;
+    if (progress && !progress(read_total, file_length)) {
+      return false;
+    }
+  }
+
+  FinishReading(decrypted_string);
+  return true;
+}
+
 void PasswordContainer::AddAccount(const string& account_name,
                                    const string& username,
                                    const string& password) {
@@ -38,26 +382,104 @@ void PasswordContainer::AddAccount(const string& account_name,
     throw std::invalid_argument("Account already in container!");
   }
 
-  if (account_name.empty() || username.empty() || password.empty()) {
+  AccountDetails account;
+  account.account_name = account_name;
+  account.username = username;
+  account.password = password;
+  ValidateAccountDetails(account);
+
+  AppendAccount(account);
+}
+
+void PasswordContainer::AddAccounts(const vector<AccountDetails>& accounts) {
+  AccountBatch batch;
+  for (const AccountDetails& account : accounts) {
+    batch.AddAccount(account.account_name, account.username, account.password);
+  }
+
+  CommitBatch(batch);
+}
+
+void PasswordContainer::CommitBatch(const AccountBatch& batch) {
+  const vector<AccountBatch::Operation>& operations = batch.GetOperations();
+
+  // Checks every change before anything is changed. Names the batch adds or
+  // deletes are tracked here since they are no longer in the same state as
+  // the container.
+  std::unordered_map<string, bool> is_name_taken;
+  for (const AccountBatch::Operation& operation : operations) {
+    auto taken = is_name_taken.find(operation.account_name);
+    bool has_account = taken != is_name_taken.end()
+                           ? taken->second
+                           : HasAccount(operation.account_name);
+
+    if (operation.type != AccountBatch::kDelete) {
+      AccountDetails account;
+      account.account_name = operation.account_name;
+      account.username = operation.username;
+      account.password = operation.password;
+      ValidateAccountDetails(account);
+    }
+
+    if (operation.type == AccountBatch::kAdd) {
+      if (has_account) {
+        throw std::invalid_argument("Account already in container!");
+      }
+      is_name_taken[operation.account_name] = true;
+    } else if (!has_account) {
+      throw std::invalid_argument(
+          "No account with passed in name in container!");
+    } else if (operation.type == AccountBatch::kDelete) {
+      is_name_taken[operation.account_name] = false;
+    }
+  }
+
+  // Nothing can throw from here on since every change was checked
+  for (const AccountBatch::Operation& operation : operations) {
+    if (operation.type == AccountBatch::kAdd) {
+      AccountDetails account;
+      account.account_name = operation.account_name;
+      account.username = operation.username;
+      account.password = operation.password;
+      AppendAccount(account);
+    } else if (operation.type == AccountBatch::kModify) {
+      ReplaceAccountDetails(FindSlot(operation.account_name),
+                            operation.username, operation.password);
+    } else {
+      RemoveAccount(FindSlot(operation.account_name));
+    }
+  }
+
+  CompactAccounts();
+}
+
+void PasswordContainer::ValidateAccountDetails(const AccountDetails& account) {
+  if (account.account_name.empty() || account.username.empty() ||
+      account.password.empty()) {
     throw std::invalid_argument("Please pass in valid account information!");
   }
 
-  // Creates and adds the new account to the rest of the accounts
-  AccountDetails new_account;
-  new_account.account_name = account_name;
-  new_account.username = username;
-  new_account.password = password;
-  accounts_.push_back(new_account);
+  if (account.account_name.find_first_of(kDetailSeparators) != string::npos ||
+      account.username.find_first_of(kDetailSeparators) != string::npos ||
+      account.password.find_first_of(kDetailSeparators) != string::npos) {
+    throw std::invalid_argument(
+        "Account details can't contain tabs or line breaks!");
+  }
 }
 
 void PasswordContainer::DeleteAccount(const string& account_name) {
-  if (!HasAccount(account_name)) {
+  size_t slot = FindSlot(account_name);
+  if (slot == kNoAccountIndex) {
     throw std::invalid_argument("No account with passed in name in container!");
   }
 
-  // Erases the object with the passed in account_name
-  auto account_iterator = FindAccount(account_name);
-  accounts_.erase(account_iterator);
+  RemoveAccount(slot);
+  CompactAccounts();
+}
+
+void PasswordContainer::DeleteAccount(const AccountHandle& handle) {
+  RemoveAccount(GetSlot(handle));
+  CompactAccounts();
 }
 
 void PasswordContainer::ModifyAccount(const std::string& account_name,
@@ -67,43 +489,169 @@ void PasswordContainer::ModifyAccount(const std::string& account_name,
     throw std::invalid_argument("No account with passed in name in container!");
   }
 
-  if (account_name.empty() || username.empty() || password.empty()) {
-    throw std::invalid_argument("Please pass in valid account information!");
-  }
+  AccountDetails account;
+  account.account_name = account_name;
+  account.username = username;
+  account.password = password;
+  ValidateAccountDetails(account);
+
+  ReplaceAccountDetails(FindSlot(account_name), username, password);
+}
 
-  // Changes the username and password of the account with account_name
-  auto account = FindAccount(account_name);
-  account->username = username;
-  account->password = password;
+void PasswordContainer::ModifyAccount(const AccountHandle& handle,
+                                      const string& username,
+                                      const string& password) {
+  ModifyAccount(GetAccountName(handle), username, password);
 }
 
 std::istream& operator>>(std::istream& input, PasswordContainer& container) {
+  container.ReadHeader(input);
+
   // Code to get all data from the input file found here:
   // https://stackoverflow.com/questions/3203452/how-to-read-entire-stream-into-a-stdstring
   string encrypted_string(std::istreambuf_iterator<char>(input), {});
-  string decrypted_string =
-      container.cryptographer_.DecryptString(encrypted_string);
-
-  container.AddAllData(decrypted_string);
+  container.FinishReading(
+      container.GetCryptographer().DecryptString(encrypted_string));
 
   return input;
 }
 
 std::ostream& operator<<(std::ostream& output,
                          const PasswordContainer& container) {
-  string data_representation = container.GenerateStringRepresentation();
-  output << container.cryptographer_.EncryptString(data_representation);
+  // Derives the key for the container so later saves don't derive it again
+  container.GetCryptographer();
+  return output << container.CreateSnapshot();
+}
+
+PasswordContainer::Snapshot PasswordContainer::CreateSnapshot() const {
+  Snapshot snapshot(cryptographer_);
+  snapshot.plain_text_ = GenerateStringRepresentation();
+  snapshot.hashed_key_ = hashed_key_;
+  snapshot.kdf_iterations_ = kdf_iterations_;
+  snapshot.kdf_salt_ = kdf_salt_;
+  snapshot.is_key_derived_ = is_key_derived_;
+  snapshot.has_username_table_ = is_username_pooling_enabled_;
+  return snapshot;
+}
+
+PasswordContainer::Snapshot::Snapshot(const Cryptographer& cryptographer)
+    : cryptographer_(cryptographer) {
+}
+
+const Cryptographer& PasswordContainer::Snapshot::GetCryptographer() const {
+  if (!is_key_derived_) {
+    DeriveCipherKey(hashed_key_, kdf_salt_, kdf_iterations_, cryptographer_);
+    is_key_derived_ = true;
+  }
+
+  return cryptographer_;
+}
+
+std::ostream& operator<<(std::ostream& output,
+                         const PasswordContainer::Snapshot& snapshot) {
+  const Cryptographer& cryptographer = snapshot.GetCryptographer();
+
+  // Writes the header so the key can be derived and checked when the data is
+  // read back
+  VaultHeader header;
+  header.key_check = cryptographer.CalculateKeyCheck();
+  header.kdf_iterations = snapshot.kdf_iterations_;
+  header.kdf_salt = keyderivation::ConvertToHex(snapshot.kdf_salt_);
+  header.has_username_table = snapshot.has_username_table_;
+  output << header;
+
+  output << cryptographer.EncryptString(snapshot.plain_text_);
 
   return output;
 }
 
+void swap(PasswordContainer& first, PasswordContainer& second) {
+  using std::swap;
+  swap(first.cryptographer_, second.cryptographer_);
+  swap(first.thread_count_, second.thread_count_);
+  swap(first.hashed_key_, second.hashed_key_);
+  swap(first.kdf_iterations_, second.kdf_iterations_);
+  swap(first.kdf_salt_, second.kdf_salt_);
+  swap(first.is_key_derived_, second.is_key_derived_);
+  swap(first.account_names_, second.account_names_);
+  swap(first.username_ids_, second.username_ids_);
+  swap(first.password_handles_, second.password_handles_);
+  swap(first.password_arena_, second.password_arena_);
+  swap(first.wasted_password_bytes_, second.wasted_password_bytes_);
+  swap(first.handle_ids_, second.handle_ids_);
+  swap(first.deleted_slot_count_, second.deleted_slot_count_);
+  swap(first.handle_entries_, second.handle_entries_);
+  swap(first.free_handle_ids_, second.free_handle_ids_);
+  swap(first.handle_ids_by_name_, second.handle_ids_by_name_);
+  swap(first.usernames_, second.usernames_);
+  swap(first.account_names_by_username_, second.account_names_by_username_);
+  swap(first.is_username_pooling_enabled_,
+       second.is_username_pooling_enabled_);
+  swap(first.reuse_index_, second.reuse_index_);
+  swap(first.is_reuse_index_built_, second.is_reuse_index_built_);
+  swap(first.strength_scorer_, second.strength_scorer_);
+  swap(first.password_strengths_, second.password_strengths_);
+  swap(first.is_strength_scored_, second.is_strength_scored_);
+  swap(first.search_index_, second.search_index_);
+  swap(first.unindexed_name_changes_, second.unindexed_name_changes_);
+
+  // Anything that cached either container's accounts by revision has to see
+  // a revision it hasn't seen before
+  size_t revision = std::max(first.revision_, second.revision_) + 1;
+  first.revision_ = revision;
+  second.revision_ = revision;
+}
+
 string PasswordContainer::GenerateStringRepresentation() const {
   string string_representation;
+  string username_table;
+
+  // Gives every distinct username an index in the table in the order the
+  // usernames are first used
+  std::unordered_map<StringPool::Id, size_t> table_indices;
+
+  // Reserves room for every detail and separator up front so the string is
+  // never copied while it grows. Pooled usernames only make it shorter.
+  size_t representation_length = 0;
+  for (size_t index = 0; index < account_names_.size(); index++) {
+    representation_length += account_names_[index].size() +
+                             usernames_.Get(username_ids_[index]).size() +
+                             password_handles_[index].length + kNumDetails;
+  }
+  string_representation.reserve(representation_length);
+
+  // Loops through all accounts and adds their details to the final string.
+  // Every detail is appended on its own so no temporary strings are built.
+  for (size_t index = 0; index < account_names_.size(); index++) {
+    const string& username = usernames_.Get(username_ids_[index]);
+    string_representation += account_names_[index];
+    string_representation += '\t';
+
+    if (is_username_pooling_enabled_) {
+      auto table_index = table_indices.find(username_ids_[index]);
+      if (table_index == table_indices.end()) {
+        table_index = table_indices
+                          .insert(std::make_pair(username_ids_[index],
+                                                 table_indices.size()))
+                          .first;
+        username_table += username + '\t';
+      }
 
-  // Loops through all accounts and adds their details to the final string
-  for (const AccountDetails& account : accounts_) {
-    string_representation += account.account_name + '\t' + account.username +
-                             '\t' + account.password + '\n';
+      string_representation += std::to_string(table_index->second);
+    } else {
+      string_representation += username;
+    }
+
+    string_representation += '\t';
+    StringRef password = password_arena_.Get(password_handles_[index]);
+    string_representation.append(password.data, password.size);
+    string_representation += '\n';
+  }
+
+  // Puts the username table on the first line, without its trailing \t
+  if (!username_table.empty()) {
+    username_table.back() = '\n';
+    string_representation = username_table + string_representation;
   }
 
   // Removes the trailing \n character from the string
@@ -114,17 +662,262 @@ string PasswordContainer::GenerateStringRepresentation() const {
   return string_representation;
 }
 
-void PasswordContainer::AddAllData(const string& decrypted_string) {
+void PasswordContainer::AppendAccount(const AccountDetails& account) {
+  // Reuses the id of a deleted account before making the ids any longer
+  uint32_t handle_id;
+  if (!free_handle_ids_.empty()) {
+    handle_id = free_handle_ids_.back();
+    free_handle_ids_.pop_back();
+  } else {
+    handle_id = static_cast<uint32_t>(handle_entries_.size());
+    handle_entries_.push_back({0, 1});
+  }
+  handle_entries_[handle_id].slot = account_names_.size();
+  handle_ids_by_name_.emplace(account.account_name, handle_id);
+  handle_ids_.push_back(handle_id);
+
+  unindexed_name_changes_.push_back({account.account_name, true});
+  revision_++;
+  account_names_.push_back(account.account_name);
+  username_ids_.push_back(
+      InternUsername(account.username, account.account_name));
+  password_handles_.push_back(AppendPassword(account.password));
+  if (is_reuse_index_built_) {
+    reuse_index_.Add(account.account_name, account.password);
+  }
+  password_strengths_.push_back(PasswordStrength());
+  is_strength_scored_.push_back(false);
+}
+
+void PasswordContainer::ReplaceAccountDetails(size_t slot,
+                                              const string& username,
+                                              const string& password) {
+  const string& account_name = account_names_[slot];
+
+  // A username that doesn't change keeps its pool entry and its place in
+  // the username index
+  StringPool::Id old_username_id = username_ids_[slot];
+  if (usernames_.Get(old_username_id) != username) {
+    ReleaseUsername(old_username_id, account_name);
+    username_ids_[slot] = InternUsername(username, account_name);
+  }
+  if (is_reuse_index_built_) {
+    reuse_index_.Remove(account_name, GetPasswordInSlot(slot));
+    reuse_index_.Add(account_name, password);
+  }
+  if (password_arena_.Get(password_handles_[slot]) != password) {
+    is_strength_scored_[slot] = false;
+  }
+  // Empties the slot first so compacting the arena doesn't keep the old
+  // password
+  wasted_password_bytes_ += password_handles_[slot].length;
+  password_handles_[slot] = StringArena::Handle();
+  password_handles_[slot] = AppendPassword(password);
+  revision_++;
+}
+
+void PasswordContainer::RemoveAccount(size_t slot) {
+  // Takes the name out of its slot first since the name passed to
+  // DeleteAccount might be a reference to it
+  string account_name = std::move(account_names_[slot]);
+  account_names_[slot].clear();
+
+  if (is_reuse_index_built_) {
+    reuse_index_.Remove(account_name, GetPasswordInSlot(slot));
+  }
+  ReleaseUsername(username_ids_[slot], account_name);
+  handle_ids_by_name_.erase(account_name);
+
+  // Makes every handle to the account invalid before its id is reused
+  uint32_t handle_id = handle_ids_[slot];
+  handle_entries_[handle_id].generation++;
+  free_handle_ids_.push_back(handle_id);
+  wasted_password_bytes_ += password_handles_[slot].length;
+  password_handles_[slot] = StringArena::Handle();
+  unindexed_name_changes_.push_back({std::move(account_name), false});
+  deleted_slot_count_++;
+  revision_++;
+}
+
+void PasswordContainer::CompactAccounts() {
+  if (deleted_slot_count_ == 0) {
+    return;
+  }
+
+  // Moves every account down over the empty slots before it, which only
+  // changes the slots of the accounts after the first deleted one
+  size_t kept_count = 0;
+  for (size_t slot = 0; slot < account_names_.size(); slot++) {
+    if (account_names_[slot].empty()) {
+      continue;
+    }
+
+    if (kept_count != slot) {
+      account_names_[kept_count] = std::move(account_names_[slot]);
+      username_ids_[kept_count] = username_ids_[slot];
+      password_handles_[kept_count] = password_handles_[slot];
+      password_strengths_[kept_count] = password_strengths_[slot];
+      is_strength_scored_[kept_count] = is_strength_scored_[slot];
+      handle_ids_[kept_count] = handle_ids_[slot];
+      handle_entries_[handle_ids_[kept_count]].slot = kept_count;
+    }
+    kept_count++;
+  }
+
+  account_names_.resize(kept_count);
+  username_ids_.resize(kept_count);
+  password_handles_.resize(kept_count);
+  password_strengths_.resize(kept_count);
+  is_strength_scored_.resize(kept_count);
+  handle_ids_.resize(kept_count);
+  deleted_slot_count_ = 0;
+}
+
+string PasswordContainer::GetPasswordInSlot(size_t slot) const {
+  return password_arena_.Get(password_handles_[slot]).ToString();
+}
+
+vector<string> PasswordContainer::CopyPasswords() const {
+  vector<string> passwords;
+  passwords.reserve(password_handles_.size());
+  for (size_t slot = 0; slot < password_handles_.size(); slot++) {
+    passwords.push_back(GetPasswordInSlot(slot));
+  }
+
+  return passwords;
+}
+
+StringArena::Handle PasswordContainer::AppendPassword(const string& password) {
+  // Only compacts once most of the arena is wasted, so every byte is copied a
+  // constant number of times on average
+  if (wasted_password_bytes_ > kPasswordBlockSize &&
+      wasted_password_bytes_ * 2 > password_arena_.GetUsedBytes()) {
+    CompactPasswords();
+  }
+
+  return password_arena_.Append(password);
+}
+
+void PasswordContainer::CompactPasswords() {
+  StringArena compacted_arena(kPasswordBlockSize);
+  compacted_arena.Reserve(password_arena_.GetUsedBytes() -
+                          wasted_password_bytes_);
+
+  // Deleted slots have an empty handle, which stays empty
+  for (StringArena::Handle& handle : password_handles_) {
+    StringRef password = password_arena_.Get(handle);
+    handle = compacted_arena.Append(password.data, password.size);
+  }
+
+  swap(password_arena_, compacted_arena);
+  wasted_password_bytes_ = 0;
+}
+
+void PasswordContainer::IndexChangedNames() const {
+  if (unindexed_name_changes_.empty()) {
+    return;
+  }
+
+  // Updating the index costs about as much per name as rebuilding it costs
+  // per account, so many changes rebuild it
+  if (unindexed_name_changes_.size() * kSearchIndexRebuildRatio >
+      account_names_.size()) {
+    search_index_.Rebuild(account_names_);
+  } else {
+    for (const NameChange& change : unindexed_name_changes_) {
+      if (change.is_added) {
+        search_index_.Insert(change.account_name);
+      } else {
+        search_index_.Remove(change.account_name);
+      }
+    }
+  }
+
+  unindexed_name_changes_.clear();
+}
+
+void PasswordContainer::ReadHeader(std::istream& input) {
+  if (VaultHeader::IsPresent(input)) {
+    VaultHeader header;
+    input >> header;
+
+    // Derives the key the same way it was derived when the data was saved
+    string salt = keyderivation::ConvertFromHex(header.kdf_salt);
+    Cryptographer header_cryptographer(cryptographer_);
+    DeriveCipherKey(hashed_key_, salt, header.kdf_iterations,
+                    header_cryptographer);
+
+    // Checks the key against the header before decrypting anything. The key
+    // settings are only kept once the key is known to be right.
+    if (!header_cryptographer.MatchesKeyCheck(header.key_check)) {
+      throw std::invalid_argument("Wrong key passed in!");
+    }
+
+    kdf_iterations_ = header.kdf_iterations;
+    kdf_salt_ = salt;
+    // The old key is wiped along with header_cryptographer
+    swap(cryptographer_, header_cryptographer);
+    is_key_derived_ = true;
+    is_username_pooling_enabled_ = header.has_username_table;
+  } else {
+    // Save files from before the header existed used the hash of the key and
+    // are only checked while decrypting
+    kdf_iterations_ = 0;
+    is_key_derived_ = false;
+    is_username_pooling_enabled_ = false;
+  }
+}
+
+void PasswordContainer::FinishReading(const string& decrypted_string) {
+  AddAllData(decrypted_string, is_username_pooling_enabled_);
+
+  // Stretches the key of older save files from the next save on
+  if (kdf_iterations_ == 0) {
+    kdf_iterations_ = kDefaultKdfIterations;
+    kdf_salt_ = keyderivation::GenerateSalt(kKdfSaltLength);
+    is_key_derived_ = false;
+  }
+}
+
+void PasswordContainer::AddAllData(const string& decrypted_string,
+                                   bool has_username_table) {
   std::stringstream decrypted_stream(decrypted_string);
   string current_line;
+  vector<string> username_table;
+
+  // Reads every username in the table on the first line
+  if (has_username_table && getline(decrypted_stream, current_line, '\n')) {
+    std::stringstream table_stream(current_line);
+    string username;
+    while (getline(table_stream, username, '\t')) {
+      username_table.push_back(username);
+    }
+
+    if (username_table.empty()) {
+      throw std::invalid_argument("Bad data passed in!");
+    }
+  }
 
   // Loops through all lines and adds the data from all of them
   while (getline(decrypted_stream, current_line, '\n')) {
-    AddOneAccountData(current_line);
+    AddOneAccountData(current_line, username_table);
   }
+
+  // Indexes all the names at once, which is much faster than one at a time
+  search_index_.Rebuild(account_names_);
+  unindexed_name_changes_.clear();
+
+  // The reuse index is rebuilt with all the passwords the next time it is used
+  reuse_index_.Clear();
+  is_reuse_index_built_ = false;
+
+  // Every password is scored in one batch the next time strengths are needed
+  password_strengths_.assign(account_names_.size(), PasswordStrength());
+  is_strength_scored_.assign(account_names_.size(), false);
 }
 
-void PasswordContainer::AddOneAccountData(const string& line_data) {
+void PasswordContainer::AddOneAccountData(
+    const string& line_data, const vector<string>& username_table) {
   string current_detail;
   std::stringstream line_stream(line_data);
   AccountDetails current_account;  // Creates a new AccountDetails object
@@ -143,7 +936,10 @@ void PasswordContainer::AddOneAccountData(const string& line_data) {
         current_account.account_name = current_detail;
         break;
       case kUsernameIndex:
-        current_account.username = current_detail;
+        current_account.username =
+            username_table.empty()
+                ? current_detail
+                : LookUpUsername(username_table, current_detail);
         break;
       case kPasswordIndex:
         current_account.password = current_detail;
@@ -151,30 +947,175 @@ void PasswordContainer::AddOneAccountData(const string& line_data) {
     }
   }
 
-  accounts_.push_back(current_account);
+  // Empty or repeated names would break the tombstones and the name lookups
+  if (current_account.account_name.empty() ||
+      current_account.username.empty() || current_account.password.empty() ||
+      HasAccount(current_account.account_name)) {
+    throw std::invalid_argument("Bad data passed in!");
+  }
+
+  AppendAccount(current_account);
+}
+
+vector<string> PasswordContainer::SearchAccounts(const string& query,
+                                                size_t max_results) const {
+  IndexChangedNames();
+  return search_index_.Search(query, max_results);
+}
+
+vector<string> PasswordContainer::FindClosestAccounts(
+    const string& name, size_t max_results, size_t max_distance) const {
+  IndexChangedNames();
+  return search_index_.FindClosest(name, max_results, max_distance);
+}
+
+vector<string> PasswordContainer::GetAccountsForUsername(
+    const string& username) const {
+  StringPool::Id id = usernames_.Find(username);
+  if (id == StringPool::kNoId) {
+    return vector<string>();
+  }
+
+  const std::set<string>& account_names = account_names_by_username_[id];
+  return vector<string>(account_names.begin(), account_names.end());
+}
+
+vector<vector<string>> PasswordContainer::FindReusedPasswords() const {
+  if (!is_reuse_index_built_) {
+    reuse_index_.Build(account_names_, CopyPasswords(), thread_count_);
+    is_reuse_index_built_ = true;
+  }
+
+  return reuse_index_.GetReuseGroups();
 }
 
-bool PasswordContainer::HasAccount(const std::string& account_name) {
-  // Loops through all accounts and check if the name is equal to account_name
-  for (const AccountDetails& account : accounts_) {
-    if (account.account_name == account_name) {
-      return true;
+vector<string> PasswordContainer::FindBreachedAccounts(
+    const BreachedPasswordChecker& checker) const {
+  // Every password is checked on its own, so the checks are split across the
+  // threads. Each one mostly waits on pages of the list being read in.
+  vector<char> is_breached(password_handles_.size(), false);
+  auto check_range = [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; index++) {
+      is_breached[index] = checker.IsBreached(GetPasswordInSlot(index));
+    }
+  };
+
+  if (thread_count_ == 1 || password_handles_.size() <= kBreachCheckBatchSize) {
+    check_range(0, password_handles_.size());
+  } else {
+    ThreadPool thread_pool(thread_count_);
+    thread_pool.ParallelFor(password_handles_.size(), kBreachCheckBatchSize,
+                            check_range);
+  }
+
+  vector<string> breached_accounts;
+  for (size_t index = 0; index < password_handles_.size(); index++) {
+    if (is_breached[index]) {
+      breached_accounts.push_back(account_names_[index]);
     }
   }
 
-  return false;
+  return breached_accounts;
 }
 
-std::vector<PasswordContainer::AccountDetails>::iterator
-PasswordContainer::FindAccount(const std::string& account_name) {
-  for (auto iterator = accounts_.begin(); iterator != accounts_.end();
-       iterator++) {
-    if (iterator->account_name == account_name) {
-      return iterator;
+PasswordStrength PasswordContainer::GetPasswordStrength(size_t index) const {
+  if (index >= password_handles_.size()) {
+    throw std::invalid_argument("Invalid index passed in!");
+  }
+
+  return GetStrengthInSlot(index);
+}
+
+PasswordStrength PasswordContainer::GetPasswordStrength(
+    const AccountHandle& handle) const {
+  return GetStrengthInSlot(GetSlot(handle));
+}
+
+vector<PasswordStrength> PasswordContainer::ScorePasswords() const {
+  size_t unscored_count = static_cast<size_t>(std::count(
+      is_strength_scored_.begin(), is_strength_scored_.end(), false));
+
+  // Scores everything in one parallel batch after a load, and otherwise just
+  // the few passwords that changed since the last call
+  if (unscored_count == password_handles_.size()) {
+    password_strengths_ =
+        strength_scorer_.ScoreAll(CopyPasswords(), thread_count_);
+    is_strength_scored_.assign(password_handles_.size(), true);
+  } else if (unscored_count > 0) {
+    for (size_t index = 0; index < password_handles_.size(); index++) {
+      GetStrengthInSlot(index);
     }
   }
 
-  return accounts_.end();
+  return password_strengths_;
+}
+
+void PasswordContainer::LoadStrengthWordList(const string& file_path) {
+  strength_scorer_.LoadWordList(file_path);
+  is_strength_scored_.assign(password_handles_.size(), false);
+}
+
+bool PasswordContainer::HasAccount(const std::string& account_name) const {
+  return handle_ids_by_name_.count(account_name) > 0;
+}
+
+size_t PasswordContainer::FindAccount(const std::string& account_name) const {
+  return FindSlot(account_name);
+}
+
+size_t PasswordContainer::FindSlot(const string& account_name) const {
+  auto id = handle_ids_by_name_.find(account_name);
+  if (id == handle_ids_by_name_.end()) {
+    return kNoAccountIndex;
+  }
+
+  return handle_entries_[id->second].slot;
+}
+
+size_t PasswordContainer::GetSlot(const AccountHandle& handle) const {
+  if (!IsValidHandle(handle)) {
+    throw std::invalid_argument("Invalid handle passed in!");
+  }
+
+  return handle_entries_[handle.id].slot;
+}
+
+PasswordContainer::AccountDetails PasswordContainer::GetAccountInSlot(
+    size_t slot) const {
+  AccountDetails account;
+  account.account_name = account_names_[slot];
+  account.username = usernames_.Get(username_ids_[slot]);
+  account.password = GetPasswordInSlot(slot);
+
+  return account;
+}
+
+PasswordStrength PasswordContainer::GetStrengthInSlot(size_t slot) const {
+  if (!is_strength_scored_[slot]) {
+    password_strengths_[slot] = strength_scorer_.Score(GetPasswordInSlot(slot));
+    is_strength_scored_[slot] = true;
+  }
+
+  return password_strengths_[slot];
+}
+
+StringPool::Id PasswordContainer::InternUsername(const string& username,
+                                                 const string& account_name) {
+  StringPool::Id id = usernames_.Intern(username);
+
+  // Ids are handed out densely, so the sets can be looked up by id
+  if (id >= account_names_by_username_.size()) {
+    account_names_by_username_.resize(id + 1);
+  }
+  account_names_by_username_[id].insert(account_name);
+
+  return id;
+}
+
+void PasswordContainer::ReleaseUsername(StringPool::Id id,
+                                        const string& account_name) {
+  account_names_by_username_[id].erase(account_name);
+  usernames_.Release(id);
 }
 
 }  // namespace passwordcontainer
\ No newline at end of file
@@ -0,0 +1,350 @@
+#include "core/search/account_search_index.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "core/search/edit_distance_matcher.h"
+#include "core/util.h"
+
+using std::string;
+
+namespace passwordcontainer {
+
+const size_t AccountSearchIndex::kGramLength;
+
+void AccountSearchIndex::Insert(const string& account_name) {
+  string folded_name = util::ConvertToLowerCase(account_name);
+
+  // Finds where the name goes in the sorted order, which is also where it
+  // would already be if it was in the index
+  size_t position = FindNamePosition(account_name, folded_name);
+  if (position < sorted_ids_.size() &&
+      entries_[sorted_ids_[position]].name == account_name) {
+    throw std::invalid_argument("Name is already in the index!");
+  }
+
+  // Reuses a removed id before making the ids any longer
+  NameId id;
+  if (!free_ids_.empty()) {
+    id = free_ids_.back();
+    free_ids_.pop_back();
+  } else {
+    id = static_cast<NameId>(entries_.size());
+    entries_.emplace_back();
+  }
+
+  Entry& entry = entries_[id];
+  entry.name = account_name;
+  entry.folded_name = folded_name;
+  entry.is_used = true;
+
+  sorted_ids_.insert(sorted_ids_.begin() + position, id);
+
+  // A reused id can be lower than ids already in the posting lists, so it is
+  // inserted in order instead of appended
+  for (uint32_t trigram : GetTrigrams(folded_name)) {
+    std::vector<NameId>& posting = postings_[trigram];
+    posting.insert(std::lower_bound(posting.begin(), posting.end(), id), id);
+  }
+}
+
+void AccountSearchIndex::Remove(const string& account_name) {
+  string folded_name = util::ConvertToLowerCase(account_name);
+
+  size_t position = FindNamePosition(account_name, folded_name);
+  if (position >= sorted_ids_.size() ||
+      entries_[sorted_ids_[position]].name != account_name) {
+    throw std::invalid_argument("Name is not in the index!");
+  }
+
+  NameId id = sorted_ids_[position];
+  sorted_ids_.erase(sorted_ids_.begin() + position);
+
+  for (uint32_t trigram : GetTrigrams(folded_name)) {
+    auto posting = postings_.find(trigram);
+    std::vector<NameId>& ids = posting->second;
+    ids.erase(std::lower_bound(ids.begin(), ids.end(), id));
+
+    // Drops lists that are empty so the map only holds trigrams in use
+    if (ids.empty()) {
+      postings_.erase(posting);
+    }
+  }
+
+  Entry& entry = entries_[id];
+  entry.name.clear();
+  entry.folded_name.clear();
+  entry.is_used = false;
+  free_ids_.push_back(id);
+}
+
+void AccountSearchIndex::Rebuild(const std::vector<string>& account_names) {
+  entries_.clear();
+  free_ids_.clear();
+  sorted_ids_.clear();
+  postings_.clear();
+
+  entries_.resize(account_names.size());
+  sorted_ids_.reserve(account_names.size());
+
+  // Ids are handed out in order, so appending keeps every posting list sorted
+  for (size_t index = 0; index < account_names.size(); index++) {
+    NameId id = static_cast<NameId>(index);
+    Entry& entry = entries_[id];
+    entry.name = account_names[index];
+    entry.folded_name = util::ConvertToLowerCase(entry.name);
+    entry.is_used = true;
+
+    sorted_ids_.push_back(id);
+    for (uint32_t trigram : GetTrigrams(entry.folded_name)) {
+      postings_[trigram].push_back(id);
+    }
+  }
+
+  // Sorts all the names once instead of inserting each one in order
+  std::sort(sorted_ids_.begin(), sorted_ids_.end(),
+            [this](NameId first, NameId second) {
+              return IsOrderedBefore(first, second);
+            });
+}
+
+std::vector<string> AccountSearchIndex::FindByPrefix(const string& prefix,
+                                                     size_t max_results) const {
+  string folded_prefix = util::ConvertToLowerCase(prefix);
+  std::vector<string> matches;
+
+  // Every name with the prefix comes right after the first one in sorted order
+  for (size_t position = FindFirstPosition(folded_prefix);
+       position < sorted_ids_.size(); position++) {
+    const Entry& entry = entries_[sorted_ids_[position]];
+    bool has_prefix = entry.folded_name.compare(0, folded_prefix.size(),
+                                                folded_prefix) == 0;
+    if (!has_prefix || (max_results != 0 && matches.size() >= max_results)) {
+      break;
+    }
+
+    matches.push_back(entry.name);
+  }
+
+  return matches;
+}
+
+std::vector<string> AccountSearchIndex::FindBySubstring(
+    const string& substring, size_t max_results) const {
+  string folded_substring = util::ConvertToLowerCase(substring);
+  std::vector<string> matches;
+
+  // Queries too short to have a trigram check every name in sorted order, so
+  // they can stop as soon as there are enough matches
+  if (folded_substring.size() < kGramLength) {
+    for (NameId id : sorted_ids_) {
+      if (max_results != 0 && matches.size() >= max_results) {
+        break;
+      }
+
+      const Entry& entry = entries_[id];
+      if (entry.folded_name.find(folded_substring) != string::npos) {
+        matches.push_back(entry.name);
+      }
+    }
+
+    return matches;
+  }
+
+  // Gets the posting list of every trigram in the query. No name can match if
+  // one of the trigrams isn't in any name.
+  std::vector<const std::vector<NameId>*> postings;
+  for (uint32_t trigram : GetTrigrams(folded_substring)) {
+    auto posting = postings_.find(trigram);
+    if (posting == postings_.end()) {
+      return matches;
+    }
+
+    postings.push_back(&posting->second);
+  }
+
+  // Starts from the shortest list so every step has the fewest ids to check
+  std::sort(postings.begin(), postings.end(),
+            [](const std::vector<NameId>* first,
+               const std::vector<NameId>* second) {
+              return first->size() < second->size();
+            });
+
+  std::vector<NameId> candidates = *postings.front();
+  for (size_t list = 1; list < postings.size() && !candidates.empty(); list++) {
+    const std::vector<NameId>& ids = *postings[list];
+    auto remaining = std::remove_if(
+        candidates.begin(), candidates.end(), [&ids](NameId id) {
+          return !std::binary_search(ids.begin(), ids.end(), id);
+        });
+    candidates.erase(remaining, candidates.end());
+  }
+
+  // Having every trigram doesn't mean the trigrams are next to each other, so
+  // the candidates that are left are checked
+  auto remaining = std::remove_if(
+      candidates.begin(), candidates.end(), [&](NameId id) {
+        return entries_[id].folded_name.find(folded_substring) == string::npos;
+      });
+  candidates.erase(remaining, candidates.end());
+
+  std::sort(candidates.begin(), candidates.end(),
+            [this](NameId first, NameId second) {
+              return IsOrderedBefore(first, second);
+            });
+
+  if (max_results != 0 && candidates.size() > max_results) {
+    candidates.resize(max_results);
+  }
+
+  for (NameId id : candidates) {
+    matches.push_back(entries_[id].name);
+  }
+
+  return matches;
+}
+
+std::vector<string> AccountSearchIndex::Search(const string& query,
+                                               size_t max_results) const {
+  std::vector<string> matches = FindByPrefix(query, max_results);
+  if (max_results != 0 && matches.size() >= max_results) {
+    return matches;
+  }
+
+  // Adds the names that contain the query anywhere but the start, since the
+  // names that start with it were already added
+  string folded_query = util::ConvertToLowerCase(query);
+  for (const string& name : FindBySubstring(query, 0)) {
+    if (max_results != 0 && matches.size() >= max_results) {
+      break;
+    }
+
+    if (util::ConvertToLowerCase(name).compare(0, folded_query.size(),
+                                               folded_query) != 0) {
+      matches.push_back(name);
+    }
+  }
+
+  return matches;
+}
+
+std::vector<string> AccountSearchIndex::FindClosest(const string& name,
+                                                    size_t max_results,
+                                                    size_t max_distance) const {
+  EditDistanceMatcher matcher(util::ConvertToLowerCase(name));
+
+  // The closest names so far with their distances, closest first
+  std::vector<std::pair<size_t, NameId>> closest;
+  auto is_closer = [this](const std::pair<size_t, NameId>& first,
+                          const std::pair<size_t, NameId>& second) {
+    if (first.first != second.first) {
+      return first.first < second.first;
+    }
+
+    return IsOrderedBefore(first.second, second.second);
+  };
+  size_t bound = max_distance;
+
+  // Goes through the names in the order they are stored instead of sorted
+  // order, which is much kinder to the cache
+  for (NameId id = 0; id < entries_.size(); id++) {
+    if (!entries_[id].is_used) {
+      continue;
+    }
+
+    size_t distance = matcher.GetDistance(entries_[id].folded_name, bound);
+    if (distance > bound) {
+      continue;
+    }
+
+    std::pair<size_t, NameId> match(distance, id);
+    closest.insert(
+        std::upper_bound(closest.begin(), closest.end(), match, is_closer),
+        match);
+
+    // Once there are enough names only names at least as close can replace
+    // them, which makes the bound tighter and lets more names be skipped early
+    if (max_results != 0 && closest.size() >= max_results) {
+      closest.resize(max_results);
+      bound = closest.back().first;
+    }
+  }
+
+  std::vector<string> names;
+  for (const std::pair<size_t, NameId>& match : closest) {
+    names.push_back(entries_[match.second].name);
+  }
+
+  return names;
+}
+
+size_t AccountSearchIndex::GetSize() const {
+  return sorted_ids_.size();
+}
+
+bool AccountSearchIndex::IsOrderedBefore(NameId first, NameId second) const {
+  const Entry& first_entry = entries_[first];
+  const Entry& second_entry = entries_[second];
+
+  // Names that only differ by case are ordered by the names themselves
+  if (first_entry.folded_name != second_entry.folded_name) {
+    return first_entry.folded_name < second_entry.folded_name;
+  }
+
+  return first_entry.name < second_entry.name;
+}
+
+size_t AccountSearchIndex::FindNamePosition(const string& account_name,
+                                            const string& folded_name) const {
+  auto position = std::lower_bound(
+      sorted_ids_.begin(), sorted_ids_.end(), account_name,
+      [&](NameId id, const string& name) {
+        const Entry& entry = entries_[id];
+        if (entry.folded_name != folded_name) {
+          return entry.folded_name < folded_name;
+        }
+
+        return entry.name < name;
+      });
+
+  return static_cast<size_t>(position - sorted_ids_.begin());
+}
+
+size_t AccountSearchIndex::FindFirstPosition(
+    const string& folded_prefix) const {
+  auto position = std::lower_bound(
+      sorted_ids_.begin(), sorted_ids_.end(), folded_prefix,
+      [this](NameId id, const string& prefix) {
+        return entries_[id].folded_name < prefix;
+      });
+
+  return static_cast<size_t>(position - sorted_ids_.begin());
+}
+
+std::vector<uint32_t> AccountSearchIndex::GetTrigrams(
+    const string& folded_name) {
+  std::vector<uint32_t> trigrams;
+  if (folded_name.size() < kGramLength) {
+    return trigrams;
+  }
+
+  // Packs the three bytes of every trigram into one int
+  for (size_t start = 0; start + kGramLength <= folded_name.size(); start++) {
+    uint32_t trigram = 0;
+    for (size_t offset = 0; offset < kGramLength; offset++) {
+      trigram = (trigram << 8) |
+                static_cast<unsigned char>(folded_name[start + offset]);
+    }
+
+    trigrams.push_back(trigram);
+  }
+
+  // A name only belongs in each posting list once
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                 trigrams.end());
+
+  return trigrams;
+}
+
+}  // namespace passwordcontainer
@@ -0,0 +1,136 @@
+#include "core/search/edit_distance_matcher.h"
+
+#include <algorithm>
+
+using std::string;
+
+namespace passwordcontainer {
+
+const size_t EditDistanceMatcher::kMaxBitParallelLength;
+
+namespace {
+
+// The number of different byte values
+const size_t kAlphabetSize = 256;
+
+// Returns the larger of the two lengths minus the smaller one.
+size_t GetLengthDifference(size_t first, size_t second) {
+  return first > second ? first - second : second - first;
+}
+
+}  // namespace
+
+EditDistanceMatcher::EditDistanceMatcher(const string& pattern)
+    : pattern_(pattern) {
+  if (pattern_.size() > kMaxBitParallelLength) {
+    return;
+  }
+
+  // Sets the bit of every position in the pattern for the byte at it
+  pattern_masks_.assign(kAlphabetSize, 0);
+  for (size_t position = 0; position < pattern_.size(); position++) {
+    pattern_masks_[static_cast<unsigned char>(pattern_[position])] |=
+        uint64_t(1) << position;
+  }
+}
+
+size_t EditDistanceMatcher::GetDistance(const string& text,
+                                        size_t max_distance) const {
+  // Every extra character needs an insertion or deletion, so texts with a
+  // length too different from the pattern can be skipped
+  if (GetLengthDifference(text.size(), pattern_.size()) > max_distance) {
+    return max_distance + 1;
+  }
+
+  if (pattern_.empty()) {
+    return text.size();
+  }
+
+  if (pattern_.size() <= kMaxBitParallelLength) {
+    return GetBitParallelDistance(text, max_distance);
+  }
+
+  return GetTableDistance(text, max_distance);
+}
+
+size_t EditDistanceMatcher::GetBitParallelDistance(const string& text,
+                                                   size_t max_distance) const {
+  // The vertical differences between the cells of the current column of the
+  // table, split into the positions where they are +1 and where they are -1.
+  // The first column is 0, 1, 2, ... so every difference starts out as +1.
+  uint64_t positive_vertical = ~uint64_t(0);
+  uint64_t negative_vertical = 0;
+
+  // The bit of the last row, which is where the distance is read from
+  uint64_t last_row = uint64_t(1) << (pattern_.size() - 1);
+  size_t distance = pattern_.size();
+
+  for (size_t column = 0; column < text.size(); column++) {
+    uint64_t matches =
+        pattern_masks_[static_cast<unsigned char>(text[column])];
+    uint64_t vertical = matches | negative_vertical;
+    uint64_t horizontal =
+        (((matches & positive_vertical) + positive_vertical) ^
+         positive_vertical) |
+        matches;
+    uint64_t positive_horizontal =
+        negative_vertical | ~(horizontal | positive_vertical);
+    uint64_t negative_horizontal = positive_vertical & horizontal;
+
+    if (positive_horizontal & last_row) {
+      distance++;
+    } else if (negative_horizontal & last_row) {
+      distance--;
+    }
+
+    // The first row is 0, 1, 2, ... so the difference above the first row is
+    // always +1
+    positive_horizontal = (positive_horizontal << 1) | 1;
+    negative_horizontal <<= 1;
+    positive_vertical =
+        negative_horizontal | ~(vertical | positive_horizontal);
+    negative_vertical = positive_horizontal & vertical;
+
+    // Every character left can lower the distance by at most one
+    size_t characters_left = text.size() - column - 1;
+    if (distance > max_distance + characters_left) {
+      return max_distance + 1;
+    }
+  }
+
+  return std::min(distance, max_distance + 1);
+}
+
+size_t EditDistanceMatcher::GetTableDistance(const string& text,
+                                             size_t max_distance) const {
+  // Keeps only the previous and current column of the table
+  std::vector<size_t> previous(pattern_.size() + 1);
+  std::vector<size_t> current(pattern_.size() + 1);
+  for (size_t row = 0; row <= pattern_.size(); row++) {
+    previous[row] = row;
+  }
+
+  for (size_t column = 1; column <= text.size(); column++) {
+    current[0] = column;
+    size_t column_minimum = current[0];
+
+    for (size_t row = 1; row <= pattern_.size(); row++) {
+      size_t replace_cost =
+          previous[row - 1] + (pattern_[row - 1] == text[column - 1] ? 0 : 1);
+      current[row] = std::min(
+          std::min(previous[row] + 1, current[row - 1] + 1), replace_cost);
+      column_minimum = std::min(column_minimum, current[row]);
+    }
+
+    // The distances never go below the smallest one in a column
+    if (column_minimum > max_distance) {
+      return max_distance + 1;
+    }
+
+    previous.swap(current);
+  }
+
+  return std::min(previous[pattern_.size()], max_distance + 1);
+}
+
+}  // namespace passwordcontainer
@@ -0,0 +1,114 @@
+#include "core/storage/memory_mapped_file.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace passwordcontainer {
+
+MemoryMappedFile::MemoryMappedFile(const std::string& file_path) {
+#ifdef _WIN32
+  HANDLE file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::invalid_argument("Could not open the file!");
+  }
+  file_handle_ = file;
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size)) {
+    Close();
+    throw std::invalid_argument("Could not open the file!");
+  }
+  size_ = static_cast<size_t>(file_size.QuadPart);
+
+  // Empty files can't be mapped, but there is nothing to read in them anyway
+  if (size_ == 0) {
+    return;
+  }
+
+  mapping_handle_ =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping_handle_ == nullptr) {
+    Close();
+    throw std::invalid_argument("Could not map the file!");
+  }
+
+  data_ = static_cast<const char*>(
+      MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+  if (data_ == nullptr) {
+    Close();
+    throw std::invalid_argument("Could not map the file!");
+  }
+#else
+  int file = open(file_path.c_str(), O_RDONLY);
+  if (file < 0) {
+    throw std::invalid_argument("Could not open the file!");
+  }
+
+  struct stat file_status;
+  if (fstat(file, &file_status) != 0) {
+    close(file);
+    throw std::invalid_argument("Could not open the file!");
+  }
+  size_ = static_cast<size_t>(file_status.st_size);
+
+  // Empty files can't be mapped, but there is nothing to read in them anyway
+  if (size_ != 0) {
+    void* memory = mmap(nullptr, size_, PROT_READ, MAP_SHARED, file, 0);
+    if (memory == MAP_FAILED) {
+      close(file);
+      throw std::invalid_argument("Could not map the file!");
+    }
+    data_ = static_cast<const char*>(memory);
+  }
+
+  // The mapping stays valid after the file is closed
+  close(file);
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+  Close();
+}
+
+const char* MemoryMappedFile::GetData() const {
+  return data_;
+}
+
+size_t MemoryMappedFile::GetSize() const {
+  return size_;
+}
+
+void MemoryMappedFile::Close() {
+#ifdef _WIN32
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_handle_ != nullptr) {
+    CloseHandle(mapping_handle_);
+  }
+  if (file_handle_ != nullptr) {
+    CloseHandle(file_handle_);
+  }
+  mapping_handle_ = nullptr;
+  file_handle_ = nullptr;
+#else
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+
+  data_ = nullptr;
+  size_ = 0;
+}
+
+}  // namespace passwordcontainer
@@ -0,0 +1,161 @@
+#include "core/storage/string_arena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+using std::string;
+
+namespace passwordcontainer {
+
+StringRef::StringRef(const char* data, size_t size) : data(data), size(size) {
+}
+
+string StringRef::ToString() const {
+  return string(data, size);
+}
+
+bool StringRef::operator==(const StringRef& other) const {
+  return size == other.size &&
+         (size == 0 || std::memcmp(data, other.data, size) == 0);
+}
+
+bool StringRef::operator!=(const StringRef& other) const {
+  return !(*this == other);
+}
+
+bool StringRef::operator==(const string& other) const {
+  return *this == StringRef(other.data(), other.size());
+}
+
+bool StringRef::operator!=(const string& other) const {
+  return !(*this == other);
+}
+
+const size_t StringArena::kDefaultBlockSize;
+
+StringArena::StringArena(size_t block_size) : block_size_(block_size) {
+  if (block_size == 0) {
+    throw std::invalid_argument("Invalid parameters passed in to constructor!");
+  }
+}
+
+StringArena::StringArena(const StringArena& other)
+    : block_size_(other.block_size_),
+      used_bytes_(other.used_bytes_),
+      allocated_bytes_(0) {
+  blocks_.reserve(other.blocks_.size());
+
+  // Copies every block at the same index so the handles stay the same
+  for (const Block& other_block : other.blocks_) {
+    Block block;
+    block.capacity = other_block.used;
+    block.used = other_block.used;
+    block.data.reset(new char[std::max<size_t>(block.capacity, 1)]);
+    std::memcpy(block.data.get(), other_block.data.get(), block.used);
+
+    allocated_bytes_ += block.capacity;
+    blocks_.push_back(std::move(block));
+  }
+}
+
+StringArena::StringArena(StringArena&& other)
+    : StringArena(other.block_size_) {
+  swap(*this, other);
+}
+
+StringArena& StringArena::operator=(StringArena other) {
+  swap(*this, other);
+  return *this;
+}
+
+void swap(StringArena& first, StringArena& second) {
+  using std::swap;
+  swap(first.blocks_, second.blocks_);
+  swap(first.block_size_, second.block_size_);
+  swap(first.used_bytes_, second.used_bytes_);
+  swap(first.allocated_bytes_, second.allocated_bytes_);
+}
+
+StringArena::Handle StringArena::Append(const string& str) {
+  return Append(str.data(), str.size());
+}
+
+StringArena::Handle StringArena::Append(const char* data, size_t length) {
+  if (length > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument("The passed in string is too long!");
+  }
+
+  Handle handle;
+  handle.length = static_cast<uint32_t>(length);
+  if (length == 0) {
+    return handle;
+  }
+
+  // Starts a new block if the string doesn't fit in the current one
+  if (blocks_.empty() ||
+      blocks_.back().capacity - blocks_.back().used < length) {
+    AddBlock(length);
+  }
+
+  Block& block = blocks_.back();
+  std::memcpy(block.data.get() + block.used, data, length);
+
+  handle.block = static_cast<uint32_t>(blocks_.size() - 1);
+  handle.offset = static_cast<uint32_t>(block.used);
+  block.used += length;
+  used_bytes_ += length;
+
+  return handle;
+}
+
+StringRef StringArena::Get(const Handle& handle) const {
+  if (handle.length == 0) {
+    return StringRef();
+  }
+
+  return StringRef(blocks_[handle.block].data.get() + handle.offset,
+                   handle.length);
+}
+
+void StringArena::Reserve(size_t byte_count) {
+  if (blocks_.empty() ||
+      blocks_.back().capacity - blocks_.back().used < byte_count) {
+    AddBlock(byte_count);
+  }
+}
+
+void StringArena::Clear() {
+  blocks_.clear();
+  used_bytes_ = 0;
+  allocated_bytes_ = 0;
+}
+
+size_t StringArena::GetUsedBytes() const {
+  return used_bytes_;
+}
+
+size_t StringArena::GetAllocatedBytes() const {
+  return allocated_bytes_;
+}
+
+size_t StringArena::GetBlockCount() const {
+  return blocks_.size();
+}
+
+void StringArena::AddBlock(size_t capacity) {
+  // Offsets have to fit in a handle, so a block can't be bigger than that
+  capacity = std::max(capacity, block_size_);
+  capacity = std::min<size_t>(capacity, std::numeric_limits<uint32_t>::max());
+
+  Block block;
+  block.data.reset(new char[capacity]);
+  block.capacity = capacity;
+  block.used = 0;
+
+  allocated_bytes_ += capacity;
+  blocks_.push_back(std::move(block));
+}
+
+}  // namespace passwordcontainer
@@ -0,0 +1,115 @@
+#include "core/storage/string_pool.h"
+
+#include <stdexcept>
+
+using std::string;
+
+namespace passwordcontainer {
+
+const StringPool::Id StringPool::kNoId;
+
+StringPool::StringPool(const StringPool& other)
+    : entries_(other.entries_),
+      strings_(other.strings_.size(), nullptr),
+      free_ids_(other.free_ids_) {
+  // Points the ids at the keys of the copied entries
+  for (const auto& entry : entries_) {
+    strings_[entry.second.id] = &entry.first;
+  }
+}
+
+StringPool& StringPool::operator=(StringPool other) {
+  swap(*this, other);
+  return *this;
+}
+
+void swap(StringPool& first, StringPool& second) {
+  // Swapping the maps doesn't move their keys, so the pointers stay valid
+  using std::swap;
+  swap(first.entries_, second.entries_);
+  swap(first.strings_, second.strings_);
+  swap(first.free_ids_, second.free_ids_);
+}
+
+StringPool::Id StringPool::Intern(const string& str) {
+  auto iterator = entries_.find(str);
+
+  // Only needs to count the use if the string is already in the pool
+  if (iterator != entries_.end()) {
+    iterator->second.use_count++;
+    return iterator->second.id;
+  }
+
+  // Reuses a freed id before making the ids any longer
+  Id id;
+  if (!free_ids_.empty()) {
+    id = free_ids_.back();
+    free_ids_.pop_back();
+  } else {
+    if (strings_.size() >= kNoId) {
+      throw std::invalid_argument("The pool is full!");
+    }
+
+    id = static_cast<Id>(strings_.size());
+    strings_.push_back(nullptr);
+  }
+
+  Entry entry;
+  entry.id = id;
+  entry.use_count = 1;
+  iterator = entries_.insert(std::make_pair(str, entry)).first;
+  strings_[id] = &iterator->first;
+
+  return id;
+}
+
+void StringPool::Release(Id id) {
+  CheckId(id);
+
+  auto iterator = entries_.find(*strings_[id]);
+  iterator->second.use_count--;
+
+  // Frees the string once nothing uses it
+  if (iterator->second.use_count == 0) {
+    strings_[id] = nullptr;
+    free_ids_.push_back(id);
+    entries_.erase(iterator);
+  }
+}
+
+const string& StringPool::Get(Id id) const {
+  CheckId(id);
+  return *strings_[id];
+}
+
+StringPool::Id StringPool::Find(const string& str) const {
+  auto iterator = entries_.find(str);
+  if (iterator == entries_.end()) {
+    return kNoId;
+  }
+
+  return iterator->second.id;
+}
+
+size_t StringPool::GetUseCount(Id id) const {
+  CheckId(id);
+  return entries_.find(*strings_[id])->second.use_count;
+}
+
+size_t StringPool::GetSize() const {
+  return entries_.size();
+}
+
+void StringPool::Clear() {
+  entries_.clear();
+  strings_.clear();
+  free_ids_.clear();
+}
+
+void StringPool::CheckId(Id id) const {
+  if (id >= strings_.size() || strings_[id] == nullptr) {
+    throw std::invalid_argument("Invalid id passed in!");
+  }
+}
+
+}  // namespace passwordcontainer
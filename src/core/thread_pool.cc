@@ -0,0 +1,119 @@
+#include "core/thread_pool.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace passwordcontainer {
+
+ThreadPool::ThreadPool(size_t thread_count) {
+  // Uses every hardware thread if no thread count was specified
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (size_t index = 0; index < thread_count; index++) {
+    workers_.emplace_back(&ThreadPool::RunWorker, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    is_stopping_ = true;
+  }
+
+  // Wakes up every worker so they can finish the queue and exit
+  tasks_available_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::future<void> ThreadPool::Submit(const std::function<void()>& task) {
+  std::packaged_task<void()> packaged_task(task);
+  std::future<void> result = packaged_task.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    tasks_.push(std::move(packaged_task));
+  }
+
+  tasks_available_.notify_one();
+  return result;
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t granularity,
+                             const std::function<void(size_t, size_t)>& body) {
+  if (count == 0) {
+    return;
+  }
+
+  if (granularity == 0) {
+    throw std::invalid_argument("Granularity must be at least 1!");
+  }
+
+  // Splits the range into one piece per worker plus one for this thread,
+  // keeping every boundary on a multiple of granularity
+  size_t total_units = (count + granularity - 1) / granularity;
+  size_t piece_count = std::min(total_units, workers_.size() + 1);
+  size_t piece_size =
+      ((total_units + piece_count - 1) / piece_count) * granularity;
+
+  // Queues every piece except the first one
+  std::vector<std::future<void>> pieces;
+  for (size_t begin = piece_size; begin < count; begin += piece_size) {
+    size_t end = std::min(begin + piece_size, count);
+    pieces.push_back(Submit([&body, begin, end]() { body(begin, end); }));
+  }
+
+  // Runs the first piece on this thread while the workers run the rest
+  std::exception_ptr first_error;
+  try {
+    body(0, std::min(piece_size, count));
+  } catch (...) {
+    first_error = std::current_exception();
+  }
+
+  // Waits for all pieces before rethrowing so body is never used after return
+  for (std::future<void>& piece : pieces) {
+    try {
+      piece.get();
+    } catch (...) {
+      if (!first_error) {
+        first_error = std::current_exception();
+      }
+    }
+  }
+
+  if (first_error) {
+    std::rethrow_exception(first_error);
+  }
+}
+
+size_t ThreadPool::GetThreadCount() const {
+  return workers_.size();
+}
+
+void ThreadPool::RunWorker() {
+  while (true) {
+    std::packaged_task<void()> task;
+
+    {
+      // Waits until there is a task to run or the pool is shutting down
+      std::unique_lock<std::mutex> lock(tasks_mutex_);
+      tasks_available_.wait(
+          lock, [this]() { return is_stopping_ || !tasks_.empty(); });
+
+      if (tasks_.empty()) {
+        return;  // Only reached when the pool is stopping
+      }
+
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+
+    task();
+  }
+}
+
+}  // namespace passwordcontainer
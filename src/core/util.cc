@@ -1,6 +1,8 @@
 #include "core/util.h"
 
+#ifdef _WIN32
 #include <rpc.h>
+#endif
 
 #include <algorithm>
 #include <iterator>
@@ -65,21 +67,23 @@ std::string GenerateRandomPassword(size_t password_length) {
 
 // Code from:
 // https://stackoverflow.com/questions/26032039/convert-vectorstring-into-char-c
-std::vector<char*> ConvertStringVecToCharVec(std::vector<std::string>& input) {
-  std::vector<char*> result;
+std::vector<const char*> ConvertStringVecToCharVec(
+    const std::vector<std::string>& input) {
+  std::vector<const char*> result;
 
   // remember the nullptr terminator
   result.reserve(input.size() + 1);
 
   // Adds the data for each string into the result vector
-  for (std::string& data : input) {
-    result.push_back(&data[0]);
+  for (const std::string& data : input) {
+    result.push_back(data.c_str());
   }
 
   result.push_back(nullptr);
   return result;
 }
 
+#ifdef _WIN32
 // Code from:
 // http://www.cplusplus.com/forum/beginner/14349/
 void CopyToClipboard(const std::string& s) {
@@ -96,5 +100,6 @@ void CopyToClipboard(const std::string& s) {
   CloseClipboard();
   GlobalFree(hg);
 }
+#endif
 
 }  // namespace util
\ No newline at end of file
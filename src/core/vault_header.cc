@@ -0,0 +1,113 @@
+#include "core/vault_header.h"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "core/encryption/key_derivation.h"
+
+using std::string;
+
+namespace passwordcontainer {
+
+const string VaultHeader::kMagic = "PWC1";
+
+namespace {
+
+// The names of the fields in the header line
+const string kKeyCheckField = "check";
+const string kIterationsField = "iterations";
+const string kSaltField = "salt";
+const string kLayoutField = "layout";
+
+// The value of the layout field for data with a username table
+const string kPooledLayout = "pooled";
+
+}  // namespace
+
+bool VaultHeader::IsPresent(std::istream& input) {
+  // Encrypted data only has digits, so any file starting with the first
+  // character of the magic token has a header
+  return input.peek() == kMagic[0];
+}
+
+std::istream& operator>>(std::istream& input, VaultHeader& header) {
+  string header_line;
+  if (!getline(input, header_line, '\n')) {
+    throw std::invalid_argument("Bad header passed in!");
+  }
+
+  std::stringstream header_stream(header_line);
+  string token;
+
+  // Makes sure the line is actually a header
+  if (!(header_stream >> token) || token != VaultHeader::kMagic) {
+    throw std::invalid_argument("Bad header passed in!");
+  }
+
+  header = VaultHeader();
+
+  // Reads every name=value field in the line
+  while (header_stream >> token) {
+    size_t separator = token.find('=');
+    if (separator == string::npos) {
+      throw std::invalid_argument("Bad header passed in!");
+    }
+
+    string name = token.substr(0, separator);
+    string value = token.substr(separator + 1);
+    if (name == kKeyCheckField) {
+      header.key_check = value;
+    } else if (name == kIterationsField) {
+      try {
+        header.kdf_iterations = static_cast<size_t>(std::stoull(value));
+      } catch (...) {
+        throw std::invalid_argument("Bad header passed in!");
+      }
+
+      // Too few iterations would turn the key stretching off and too many
+      // would take too long to unlock
+      if (header.kdf_iterations < keyderivation::kMinimumIterations ||
+          header.kdf_iterations > keyderivation::kMaximumIterations) {
+        throw std::invalid_argument("Bad header passed in!");
+      }
+    } else if (name == kSaltField) {
+      header.kdf_salt = value;
+    } else if (name == kLayoutField) {
+      // Data in a layout that isn't known can't be read correctly
+      if (value != kPooledLayout) {
+        throw std::invalid_argument("Bad header passed in!");
+      }
+
+      header.has_username_table = true;
+    }
+  }
+
+  // Every header needs a key check since that is what it is used for
+  if (header.key_check.empty()) {
+    throw std::invalid_argument("Bad header passed in!");
+  }
+
+  return input;
+}
+
+std::ostream& operator<<(std::ostream& output, const VaultHeader& header) {
+  output << VaultHeader::kMagic << ' ' << kKeyCheckField << '='
+         << header.key_check;
+
+  // Only writes the key stretching parameters if the key was stretched
+  if (header.kdf_iterations != 0) {
+    output << ' ' << kIterationsField << '=' << header.kdf_iterations << ' '
+           << kSaltField << '=' << header.kdf_salt;
+  }
+
+  // Only writes the layout if it isn't the default one
+  if (header.has_username_table) {
+    output << ' ' << kLayoutField << '=' << kPooledLayout;
+  }
+
+  output << '\n';
+
+  return output;
+}
+
+}  // namespace passwordcontainer
@@ -0,0 +1,108 @@
+#include "core/vault_loader.h"
+
+#include <stdexcept>
+
+namespace passwordcontainer {
+
+VaultLoader::VaultLoader(size_t offset, size_t thread_count,
+                         size_t serial_threshold)
+    : offset_(offset),
+      thread_count_(thread_count),
+      serial_threshold_(serial_threshold),
+      is_loading_(false),
+      is_cancel_requested_(false),
+      read_bytes_(0),
+      total_bytes_(0) {
+}
+
+VaultLoader::~VaultLoader() {
+  Cancel();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void VaultLoader::Start(const std::string& file_path, const std::string& key) {
+  if (is_loading_) {
+    throw std::invalid_argument("A save file is already being loaded!");
+  }
+
+  // Drops the last load if it was never taken
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+
+  loaded_container_.reset();
+  has_error_ = false;
+  is_cancel_requested_ = false;
+  read_bytes_ = 0;
+  total_bytes_ = 0;
+
+  is_loading_ = true;
+  worker_ = std::thread(&VaultLoader::Load, this, file_path, key);
+}
+
+void VaultLoader::Cancel() {
+  is_cancel_requested_ = true;
+}
+
+bool VaultLoader::IsLoading() const {
+  return is_loading_;
+}
+
+size_t VaultLoader::GetReadBytes() const {
+  return read_bytes_;
+}
+
+size_t VaultLoader::GetTotalBytes() const {
+  return total_bytes_;
+}
+
+bool VaultLoader::TakeLoadedContainer(PasswordContainer& container) {
+  if (is_loading_ || !worker_.joinable()) {
+    return false;
+  }
+
+  worker_.join();
+
+  if (has_error_) {
+    has_error_ = false;
+    throw std::invalid_argument(error_message_);
+  }
+
+  // A canceled load has no container
+  if (!loaded_container_) {
+    return false;
+  }
+
+  swap(container, *loaded_container_);
+  loaded_container_.reset();
+  return true;
+}
+
+void VaultLoader::Load(const std::string& file_path, const std::string& key) {
+  try {
+    std::shared_ptr<PasswordContainer> container =
+        std::make_shared<PasswordContainer>(offset_, key);
+    container->SetCryptographerParallelism(thread_count_, serial_threshold_);
+
+    bool is_loaded = container->LoadFile(
+        file_path, [this](size_t read_bytes, size_t total_bytes) {
+          read_bytes_ = read_bytes;
+          total_bytes_ = total_bytes;
+          return !is_cancel_requested_;
+        });
+
+    if (is_loaded) {
+      loaded_container_ = container;
+    }
+  } catch (const std::exception& exception) {
+    error_message_ = exception.what();
+    has_error_ = true;
+  }
+
+  // Everything the load wrote is visible to whoever sees it finish
+  is_loading_ = false;
+}
+
+}  // namespace passwordcontainer
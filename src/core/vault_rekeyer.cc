@@ -0,0 +1,166 @@
+#include "core/vault_rekeyer.h"
+
+#include <cstdio>
+#include <deque>
+#include <future>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+
+namespace passwordcontainer {
+
+namespace {
+
+// Makes sure everything written to the file at the passed in path is on the
+// disk. Throws an invalid_argument exception if it can't be flushed.
+void FlushFile(const string& file_path) {
+#ifdef _WIN32
+  HANDLE file = CreateFileA(file_path.c_str(), GENERIC_WRITE, 0, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  bool is_flushed =
+      file != INVALID_HANDLE_VALUE && FlushFileBuffers(file) != 0;
+  if (file != INVALID_HANDLE_VALUE) {
+    CloseHandle(file);
+  }
+#else
+  int file = open(file_path.c_str(), O_RDONLY);
+  bool is_flushed = file != -1 && fsync(file) == 0;
+  if (file != -1) {
+    close(file);
+  }
+#endif
+
+  if (!is_flushed) {
+    throw std::invalid_argument("The passed location couldn't be flushed!");
+  }
+}
+
+}  // namespace
+
+VaultRekeyer::VaultRekeyer(size_t thread_count, size_t chunk_length)
+    : thread_pool_(std::make_shared<ThreadPool>(thread_count)),
+      chunk_length_(chunk_length) {
+  if (chunk_length == 0 || chunk_length % kEncryptedCharacterLength != 0) {
+    throw std::invalid_argument("Invalid parameters passed in to constructor!");
+  }
+}
+
+void VaultRekeyer::Reencrypt(std::istream& input, std::ostream& output,
+                             const Cryptographer& old_cryptographer,
+                             const Cryptographer& new_cryptographer,
+                             size_t total_length,
+                             const ProgressCallback& progress) const {
+  // A chunk that is being re-encrypted and the future for its task
+  struct PendingChunk {
+    std::shared_ptr<string> data;
+    std::future<void> result;
+  };
+
+  std::deque<PendingChunk> pending_chunks;
+  size_t max_pending_chunks =
+      thread_pool_->GetThreadCount() * kChunksInFlightPerThread;
+  size_t written_length = 0;
+
+  // Waits for the oldest chunk and writes it, so chunks are written in order
+  auto write_oldest_chunk = [&]() {
+    PendingChunk chunk = std::move(pending_chunks.front());
+    pending_chunks.pop_front();
+    chunk.result.get();
+
+    output.write(chunk.data->data(), chunk.data->size());
+    if (!output) {
+      throw std::invalid_argument("The rekeyed data couldn't be written!");
+    }
+
+    written_length += chunk.data->size();
+
+    if (progress) {
+      progress(written_length, total_length);
+    }
+  };
+
+  try {
+    // Keeps reading chunks until all the data has been read
+    while (true) {
+      std::shared_ptr<string> data =
+          std::make_shared<string>(chunk_length_, '\0');
+      input.read(&(*data)[0], chunk_length_);
+      data->resize(static_cast<size_t>(input.gcount()));
+
+      if (data->empty()) {
+        break;
+      }
+
+      PendingChunk chunk;
+      chunk.data = data;
+      chunk.result = thread_pool_->Submit(
+          [data, &old_cryptographer, &new_cryptographer]() {
+            *data = new_cryptographer.EncryptString(
+                old_cryptographer.DecryptString(*data));
+          });
+      pending_chunks.push_back(std::move(chunk));
+
+      // Limits how much data is in memory at once
+      if (pending_chunks.size() >= max_pending_chunks) {
+        write_oldest_chunk();
+      }
+    }
+
+    while (!pending_chunks.empty()) {
+      write_oldest_chunk();
+    }
+  } catch (...) {
+    // The tasks use the cryptographers, so they have to finish before the
+    // exception leaves this function
+    for (PendingChunk& chunk : pending_chunks) {
+      chunk.result.wait();
+    }
+
+    throw;
+  }
+
+  if (written_length != total_length) {
+    throw std::invalid_argument("Bad data passed in!");
+  }
+}
+
+void VaultRekeyer::OverwriteFile(const string& source_path,
+                                 const string& target_path) {
+#ifdef _WIN32
+  // ReplaceFileA keeps the permissions and attributes of the replaced file.
+  // It fails if there is no file to replace, which MoveFileEx handles.
+  FlushFile(source_path);
+  bool is_replaced =
+      ReplaceFileA(target_path.c_str(), source_path.c_str(), nullptr, 0,
+                   nullptr, nullptr) != 0 ||
+      MoveFileExA(source_path.c_str(), target_path.c_str(),
+                  MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+  // Gives the new file the permissions of the file it replaces
+  struct stat target_status;
+  if (stat(target_path.c_str(), &target_status) == 0 &&
+      chmod(source_path.c_str(), target_status.st_mode & 07777) != 0) {
+    throw std::invalid_argument("The passed location couldn't be replaced!");
+  }
+
+  // The data has to be on the disk before the rename is, or a crash could
+  // leave target_path with an empty file. rename replaces the file in one
+  // step.
+  FlushFile(source_path);
+  bool is_replaced = std::rename(source_path.c_str(), target_path.c_str()) == 0;
+#endif
+
+  if (!is_replaced) {
+    throw std::invalid_argument("The passed location couldn't be replaced!");
+  }
+}
+
+}  // namespace passwordcontainer
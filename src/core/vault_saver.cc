@@ -0,0 +1,86 @@
+#include "core/vault_saver.h"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "core/vault_rekeyer.h"
+
+namespace passwordcontainer {
+
+VaultSaver::VaultSaver() : is_saving_(false) {
+}
+
+VaultSaver::~VaultSaver() {
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void VaultSaver::Start(const PasswordContainer& container,
+                       const std::string& file_path) {
+  if (is_saving_) {
+    throw std::invalid_argument("The container is already being saved!");
+  }
+
+  // Drops the result of the last save if it was never checked
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+
+  has_error_ = false;
+
+  // Only the snapshot is taken on this thread
+  std::shared_ptr<PasswordContainer::Snapshot> snapshot =
+      std::make_shared<PasswordContainer::Snapshot>(container.CreateSnapshot());
+
+  is_saving_ = true;
+  worker_ = std::thread(&VaultSaver::Save, this, snapshot, file_path);
+}
+
+bool VaultSaver::IsSaving() const {
+  return is_saving_;
+}
+
+bool VaultSaver::FinishSave() {
+  if (is_saving_ || !worker_.joinable()) {
+    return false;
+  }
+
+  worker_.join();
+
+  if (has_error_) {
+    has_error_ = false;
+    throw std::invalid_argument(error_message_);
+  }
+
+  return true;
+}
+
+void VaultSaver::Save(std::shared_ptr<PasswordContainer::Snapshot> snapshot,
+                      const std::string& file_path) {
+  std::string temporary_path = file_path + kTemporaryExtension;
+  try {
+    std::ofstream file_output(temporary_path, std::ios::binary);
+    if (!file_output.is_open()) {
+      throw std::invalid_argument("The passed location doesn't exist!");
+    }
+
+    file_output << *snapshot;
+    file_output.close();
+    if (!file_output) {
+      throw std::invalid_argument("The saved data couldn't be written!");
+    }
+
+    VaultRekeyer::OverwriteFile(temporary_path, file_path);
+  } catch (const std::exception& exception) {
+    std::remove(temporary_path.c_str());
+    error_message_ = exception.what();
+    has_error_ = true;
+  }
+
+  // Everything the save wrote is visible to whoever sees it finish
+  is_saving_ = false;
+}
+
+}  // namespace passwordcontainer
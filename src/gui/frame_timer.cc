@@ -0,0 +1,63 @@
+#include "gui/frame_timer.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace passwordcontainer {
+
+namespace gui {
+
+FrameTimer::FrameTimer(size_t frame_count) : frame_count_(frame_count) {
+  if (frame_count == 0) {
+    throw std::invalid_argument("Invalid parameters passed in to constructor!");
+  }
+
+  frame_milliseconds_.reserve(frame_count);
+}
+
+void FrameTimer::StartFrame() {
+  frame_start_ = std::chrono::steady_clock::now();
+}
+
+void FrameTimer::EndFrame() {
+  std::chrono::duration<double, std::milli> elapsed_time =
+      std::chrono::steady_clock::now() - frame_start_;
+  RecordFrame(elapsed_time.count());
+}
+
+void FrameTimer::RecordFrame(double milliseconds) {
+  if (frame_milliseconds_.size() < frame_count_) {
+    frame_milliseconds_.push_back(milliseconds);
+  } else {
+    frame_milliseconds_[next_frame_] = milliseconds;
+  }
+  next_frame_ = (next_frame_ + 1) % frame_count_;
+}
+
+double FrameTimer::GetAverageMilliseconds() const {
+  if (frame_milliseconds_.empty()) {
+    return 0;
+  }
+
+  return std::accumulate(frame_milliseconds_.begin(),
+                         frame_milliseconds_.end(), 0.0) /
+         frame_milliseconds_.size();
+}
+
+double FrameTimer::GetMaxMilliseconds() const {
+  if (frame_milliseconds_.empty()) {
+    return 0;
+  }
+
+  return *std::max_element(frame_milliseconds_.begin(),
+                           frame_milliseconds_.end());
+}
+
+size_t FrameTimer::GetFrameCount() const {
+  return frame_milliseconds_.size();
+}
+
+}  // namespace gui
+
+}  // namespace passwordcontainer
@@ -10,14 +10,22 @@ PasswordContainerApp::PasswordContainerApp()
     : container_(kDefaultOffset, kDefaultKey),
       account_list_(container_, is_file_decrypted_, is_modification_requested_,
                     is_addition_requested_, is_key_change_requested_,
-                    selected_item_, kSaveFileLocation),
+                    selected_account_, kSaveFileLocation, vault_saver_),
       modify_account_window_(container_, is_modification_requested_,
-                             selected_item_),
-      account_details_window_(container_, selected_item_),
+                             selected_account_),
+      account_details_window_(container_, selected_account_),
       add_account_window_(container_, is_addition_requested_),
       change_key_window_(container_, is_key_change_requested_),
-      enter_key_window_(container_, is_file_decrypted_, kSaveFileLocation) {
+      vault_loader_(kDefaultOffset, kEncryptionThreadCount,
+                    kParallelEncryptionThreshold),
+      enter_key_window_(container_, is_file_decrypted_, kSaveFileLocation,
+                        vault_loader_),
+      frame_timer_(kTimedFrameCount),
+      frame_time_window_(container_, frame_timer_, redraw_scheduler_),
+      redraw_scheduler_(kSettleFrameCount) {
   ci::app::setWindowSize((int)kWindowSize, (int)kWindowSize);
+  container_.SetCryptographerParallelism(kEncryptionThreadCount,
+                                         kParallelEncryptionThreshold);
 }
 
 void PasswordContainerApp::setup() {
@@ -47,9 +55,28 @@ void PasswordContainerApp::draw() {
   account_details_window_.DrawWindow();
   add_account_window_.DrawWindow();
   change_key_window_.DrawWindow();
+  frame_time_window_.DrawWindow();
+
+  frame_timer_.EndFrame();
+  redraw_scheduler_.EndFrame();
 }
 
 void PasswordContainerApp::update() {
+  frame_timer_.StartFrame();
+
+  // Changes to the accounts and jobs running in the background change what
+  // the windows show without any input
+  redraw_scheduler_.CheckRevision(container_.GetRevision());
+  if (vault_loader_.IsLoading() || vault_saver_.IsSaving()) {
+    redraw_scheduler_.Invalidate();
+  }
+  UpdateFrameRate();
+
+  // Nothing the windows update from has changed, so they are only drawn
+  if (redraw_scheduler_.IsIdle()) {
+    return;
+  }
+
   // Updates the state of all windows
   enter_key_window_.UpdateWindow();
   account_list_.UpdateWindow();
@@ -57,6 +84,52 @@ void PasswordContainerApp::update() {
   account_details_window_.UpdateWindow();
   add_account_window_.UpdateWindow();
   change_key_window_.UpdateWindow();
+  frame_time_window_.UpdateWindow();
+}
+
+void PasswordContainerApp::mouseDown(ci::app::MouseEvent /*event*/) {
+  InvalidateFrame();
+}
+
+void PasswordContainerApp::mouseUp(ci::app::MouseEvent /*event*/) {
+  InvalidateFrame();
+}
+
+void PasswordContainerApp::mouseMove(ci::app::MouseEvent /*event*/) {
+  InvalidateFrame();
+}
+
+void PasswordContainerApp::mouseDrag(ci::app::MouseEvent /*event*/) {
+  InvalidateFrame();
+}
+
+void PasswordContainerApp::mouseWheel(ci::app::MouseEvent /*event*/) {
+  InvalidateFrame();
+}
+
+void PasswordContainerApp::keyDown(ci::app::KeyEvent /*event*/) {
+  InvalidateFrame();
+}
+
+void PasswordContainerApp::keyUp(ci::app::KeyEvent /*event*/) {
+  InvalidateFrame();
+}
+
+void PasswordContainerApp::resize() {
+  InvalidateFrame();
+}
+
+void PasswordContainerApp::InvalidateFrame() {
+  redraw_scheduler_.Invalidate();
+  UpdateFrameRate();
+}
+
+void PasswordContainerApp::UpdateFrameRate() {
+  bool is_idle = redraw_scheduler_.IsIdle();
+  if (is_idle != is_idle_frame_rate_used_) {
+    setFrameRate(is_idle ? kIdleFrameRate : kActiveFrameRate);
+    is_idle_frame_rate_used_ = is_idle;
+  }
 }
 
 }  // namespace gui
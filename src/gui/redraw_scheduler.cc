@@ -0,0 +1,50 @@
+#include "gui/redraw_scheduler.h"
+
+#include <stdexcept>
+
+namespace passwordcontainer {
+
+namespace gui {
+
+RedrawScheduler::RedrawScheduler(size_t settle_frame_count)
+    : settle_frame_count_(settle_frame_count) {
+  if (settle_frame_count == 0) {
+    throw std::invalid_argument("Invalid parameters passed in to constructor!");
+  }
+}
+
+void RedrawScheduler::Invalidate() {
+  frames_since_invalidation_ = 0;
+}
+
+void RedrawScheduler::CheckRevision(size_t revision) {
+  if (revision != last_revision_) {
+    last_revision_ = revision;
+    Invalidate();
+  }
+}
+
+void RedrawScheduler::EndFrame() {
+  if (IsIdle()) {
+    idle_frame_count_++;
+  } else {
+    frames_since_invalidation_++;
+  }
+  frame_count_++;
+}
+
+bool RedrawScheduler::IsIdle() const {
+  return frames_since_invalidation_ >= settle_frame_count_;
+}
+
+size_t RedrawScheduler::GetIdleFrameCount() const {
+  return idle_frame_count_;
+}
+
+size_t RedrawScheduler::GetFrameCount() const {
+  return frame_count_;
+}
+
+}  // namespace gui
+
+}  // namespace passwordcontainer
@@ -0,0 +1,46 @@
+#include "gui/viewmodel/account_details_view_model.h"
+
+namespace passwordcontainer {
+
+namespace gui {
+
+namespace viewmodel {
+
+AccountDetailsViewModel::AccountDetailsViewModel(
+    const PasswordContainer& container,
+    const PasswordContainer::AccountHandle& account)
+    : container_(container), account_(account) {
+}
+
+bool AccountDetailsViewModel::Update() {
+  if (!container_.IsValidHandle(account_)) {
+    shown_account_ = PasswordContainer::AccountHandle();
+    return false;
+  }
+
+  if (account_ != shown_account_ ||
+      container_.GetRevision() != shown_revision_) {
+    details_ = container_.GetAccount(account_);
+    strength_ = PasswordStrengthScorer::Describe(
+        container_.GetPasswordStrength(account_));
+    shown_account_ = account_;
+    shown_revision_ = container_.GetRevision();
+  }
+
+  return true;
+}
+
+const PasswordContainer::AccountDetails& AccountDetailsViewModel::GetAccount()
+    const {
+  return details_;
+}
+
+const std::string& AccountDetailsViewModel::GetStrength() const {
+  return strength_;
+}
+
+}  // namespace viewmodel
+
+}  // namespace gui
+
+}  // namespace passwordcontainer
@@ -0,0 +1,117 @@
+#include "gui/viewmodel/account_list_view_model.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace passwordcontainer {
+
+namespace gui {
+
+namespace viewmodel {
+
+const int AccountListViewModel::kNoRow;
+
+AccountListViewModel::AccountListViewModel(
+    PasswordContainer& container,
+    PasswordContainer::AccountHandle& selected_account)
+    : container_(container), selected_account_(selected_account) {
+}
+
+void AccountListViewModel::SetSearchQuery(const std::string& search_query) {
+  search_query_ = search_query;
+}
+
+const std::vector<std::string>& AccountListViewModel::GetListedNames() {
+  if (search_query_.empty()) {
+    return container_.GetAccountNames();
+  }
+
+  // Only searches again when the search or the accounts change, since finding
+  // the closest names checks every name
+  if (has_search_results_ && search_query_ == searched_query_ &&
+      container_.GetRevision() == searched_revision_) {
+    return search_results_;
+  }
+
+  searched_query_ = search_query_;
+  searched_revision_ = container_.GetRevision();
+  has_search_results_ = true;
+  search_results_ = container_.SearchAccounts(search_query_, kMaxSearchResults);
+
+  // Ranks the names that are only close to the search after the ones that
+  // contain it, so mistyped searches still find the account
+  for (const std::string& account_name : container_.FindClosestAccounts(
+           search_query_, kMaxFuzzyResults, kMaxFuzzyDistance)) {
+    if (std::find(search_results_.begin(), search_results_.end(),
+                  account_name) == search_results_.end()) {
+      search_results_.push_back(account_name);
+    }
+  }
+
+  return search_results_;
+}
+
+int AccountListViewModel::GetSelectedRow() {
+  if (!container_.IsValidHandle(selected_account_)) {
+    return kNoRow;
+  }
+
+  if (search_query_.empty()) {
+    return static_cast<int>(container_.GetAccountIndex(selected_account_));
+  }
+
+  // A search might not list the selected account at all
+  const std::vector<std::string>& listed_names = GetListedNames();
+  auto position = std::find(listed_names.begin(), listed_names.end(),
+                            container_.GetAccountName(selected_account_));
+  if (position == listed_names.end()) {
+    return kNoRow;
+  }
+
+  return static_cast<int>(position - listed_names.begin());
+}
+
+bool AccountListViewModel::SelectRow(int row) {
+  const std::vector<std::string>& listed_names = GetListedNames();
+  if (row < 0 || static_cast<size_t>(row) >= listed_names.size()) {
+    throw std::invalid_argument("Invalid row passed in!");
+  }
+
+  // Maps the listed name back to a handle to its account
+  PasswordContainer::AccountHandle original_account = selected_account_;
+  selected_account_ =
+      search_query_.empty()
+          ? container_.GetAccountHandle(static_cast<size_t>(row))
+          : container_.FindAccountHandle(listed_names[row]);
+
+  if (original_account == selected_account_) {
+    return false;
+  }
+
+  // A delete requested for the previous account shouldn't apply to this one
+  is_delete_requested_ = false;
+  return true;
+}
+
+void AccountListViewModel::RequestDelete() {
+  is_delete_requested_ = true;
+}
+
+bool AccountListViewModel::IsDeleteRequested() const {
+  return is_delete_requested_;
+}
+
+void AccountListViewModel::Update() {
+  // Waits for an account to be selected before deleting anything
+  if (is_delete_requested_ && container_.IsValidHandle(selected_account_)) {
+    container_.DeleteAccount(selected_account_);
+    selected_account_ = PasswordContainer::AccountHandle();
+    is_delete_requested_ = false;
+  }
+}
+
+}  // namespace viewmodel
+
+}  // namespace gui
+
+}  // namespace passwordcontainer
@@ -10,9 +10,10 @@ namespace gui {
 
 namespace window {
 
-AccountDetailsWindow::AccountDetailsWindow(const PasswordContainer& container,
-                                           int& account_index)
-    : container_(container), account_index_(account_index) {
+AccountDetailsWindow::AccountDetailsWindow(
+    const PasswordContainer& container,
+    const PasswordContainer::AccountHandle& account)
+    : view_model_(container, account) {
 }
 
 void AccountDetailsWindow::DrawWindow() {
@@ -26,6 +27,7 @@ void AccountDetailsWindow::DrawWindow() {
     // Creates two un-editable text boxes so users can copy data
     ui::InputText("Username", &username_, ImGuiInputTextFlags_ReadOnly);
     ui::InputText("Password", &password_, ImGuiInputTextFlags_ReadOnly);
+    ui::Text(("Strength: " + strength_).c_str());
 
     // Adds a space
     ui::Text("");
@@ -39,14 +41,16 @@ void AccountDetailsWindow::DrawWindow() {
 }
 
 void AccountDetailsWindow::UpdateWindow() {
-  // Makes sure that the current index is a valid account in the container
-  if (account_index_ >= 0 || account_index_ < container_.GetAccounts().size()) {
+  // Makes sure that the current handle refers to an account in the container
+  if (view_model_.Update()) {
     window_open_ = true;
 
     // Updates all the variables to hold the correct data
-    account_name_ = container_.GetAccounts()[account_index_].account_name;
-    username_ = container_.GetAccounts()[account_index_].username;
-    password_ = container_.GetAccounts()[account_index_].password;
+    const PasswordContainer::AccountDetails& account = view_model_.GetAccount();
+    account_name_ = account.account_name;
+    username_ = account.username;
+    password_ = account.password;
+    strength_ = view_model_.GetStrength();
 
     // Copies the password to the clipboard if the button is pressed
     if (copy_password_pressed_) {
@@ -1,8 +1,6 @@
 #include "gui/window/account_list_window.h"
 
-#include <fstream>
-
-#include "core/util.h"
+#include <stdexcept>
 
 namespace passwordcontainer {
 
@@ -13,15 +11,18 @@ namespace window {
 AccountListWindow::AccountListWindow(PasswordContainer& container,
                                      bool& window_open, bool& modify_bool,
                                      bool& add_bool, bool& key_change_bool,
-                                     int& selected_acc_ind,
-                                     const std::string& save_location)
+                                     PasswordContainer::AccountHandle&
+                                         selected_account,
+                                     const std::string& save_location,
+                                     VaultSaver& vault_saver)
     : container_(container),
       modify_account_pressed_(modify_bool),
       add_account_pressed_(add_bool),
       change_key_pressed_(key_change_bool),
-      selected_account_(selected_acc_ind),
       window_open_(window_open),
-      save_file_location_(save_location) {
+      save_file_location_(save_location),
+      vault_saver_(vault_saver),
+      view_model_(container, selected_account) {
 }
 
 void AccountListWindow::DrawWindow() {
@@ -31,6 +32,12 @@ void AccountListWindow::DrawWindow() {
     ui::Begin("Accounts:", false, ImGuiWindowFlags_MenuBar);
 
     DrawMenuBar();
+
+    // Shows whether the last save is still running, finished, or failed
+    if (!save_status_.empty()) {
+      ui::Text(save_status_.c_str());
+    }
+
     DrawAccountList();
 
     // Finishes creating the new window
@@ -40,30 +47,23 @@ void AccountListWindow::DrawWindow() {
 
 void AccountListWindow::UpdateWindow() {
   if (window_open_) {
-    if (delete_account_pressed_) {
-      // Makes sure that a valid account is selected
-      if (selected_account_ >= 0 &&
-          selected_account_ < container_.GetAccounts().size()) {
-        // Deletes the account
-        container_.DeleteAccount(
-            container_.GetAccounts()[selected_account_].account_name);
-
-        // Makes sure no account is selected if the index is invalid after
-        // deletion
-        if (selected_account_ >= container_.GetAccounts().size()) {
-          selected_account_ = kNoAccountSelectedIndex;
-        }
-
-        // resets the boolean to check if the delete button is pressed
-        delete_account_pressed_ = false;
-      }
+    // Deletes the selected account if deleting it was requested
+    view_model_.Update();
+
+    // Starts saving a snapshot of the container, or waits for the running
+    // save to finish before starting another
+    if (save_pressed_ && !vault_saver_.IsSaving()) {
+      vault_saver_.Start(container_, save_file_location_);
+      save_pressed_ = false;
+      save_status_ = "Saving...";
     }
 
-    if (save_pressed_) {
-      // Writes the data in the container to the file
-      std::ofstream file_output(save_file_location_);
-      file_output << container_;
-      file_output.close();
+    try {
+      if (vault_saver_.FinishSave()) {
+        save_status_ = "Saved!";
+      }
+    } catch (const std::invalid_argument& exception) {
+      save_status_ = std::string("ERROR: ") + exception.what();
     }
   }
 }
@@ -72,7 +72,11 @@ void AccountListWindow::DrawMenuBar() {
   if (ImGui::BeginMenuBar()) {
     // Draws sub options if the user clicked on the modify list item
     if (ImGui::BeginMenu("Modify List")) {
-      DrawMenuSubOption(delete_account_pressed_, "Delete Account");
+      bool delete_account_pressed = view_model_.IsDeleteRequested();
+      DrawMenuSubOption(delete_account_pressed, "Delete Account");
+      if (delete_account_pressed) {
+        view_model_.RequestDelete();
+      }
       DrawMenuSubOption(add_account_pressed_, "Add Account");
       DrawMenuSubOption(modify_account_pressed_, "Edit Account");
 
@@ -103,29 +107,35 @@ void AccountListWindow::DrawMenuSubOption(bool& is_clicked,
 }
 
 void AccountListWindow::DrawAccountList() {
-  // Vector for all the account names in the container
-  std::vector<std::string> account_names(container_.GetAccounts().size());
-
-  // Populates the account_names array with the account names
-  for (auto index = 0; index < container_.GetAccounts().size(); index++) {
-    account_names[index] = (container_.GetAccounts().at(index).account_name);
+  ui::InputText("Search", &search_query_);
+  view_model_.SetSearchQuery(search_query_);
+
+  // Lists the name column of the container, or only the names that match the
+  // search, without copying either
+  const std::vector<std::string>& account_names = view_model_.GetListedNames();
+  int selected_row = view_model_.GetSelectedRow();
+
+  // Draws a list of accounts that shows which one is selected and notes the
+  // row the user clicks. Only the rows that are visible are drawn, so the list
+  // takes as long to draw for a million accounts as for ten.
+  int clicked_row = kNoAccountSelectedIndex;
+  if (ui::ListBoxHeader("Accounts")) {
+    ImGuiListClipper clipper(static_cast<int>(account_names.size()));
+    while (clipper.Step()) {
+      for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+        if (ui::Selectable(account_names[row].c_str(), row == selected_row)) {
+          clicked_row = row;
+        }
+      }
+    }
+    ui::ListBoxFooter();
   }
 
-  // Stores the selected index before the user makes any changes
-  int original_index = selected_account_;
-
-  // Draws a list of accounts that shows that selected_account_ account is
-  // selected (the function also updates selected_account_ if the user selects
-  // another value).
-  ui::ListBox("Accounts", &selected_account_,
-              util::ConvertStringVecToCharVec(account_names).data(),
-              account_names.size());
-
   // If the account selected changes, close all windows that relate to the
   // previously selected account.
-  if (original_index != selected_account_) {
+  if (clicked_row != kNoAccountSelectedIndex &&
+      view_model_.SelectRow(clicked_row)) {
     modify_account_pressed_ = false;
-    delete_account_pressed_ = false;
   }
 }
 
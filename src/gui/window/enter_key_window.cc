@@ -1,6 +1,6 @@
 #include "gui/window/enter_key_window.h"
 
-#include <fstream>
+#include <stdexcept>
 
 namespace passwordcontainer {
 
@@ -10,9 +10,11 @@ namespace window {
 
 EnterKeyWindow::EnterKeyWindow(PasswordContainer &container,
                                bool &correct_key_entered,
-                               const std::string &save_location)
+                               const std::string &save_location,
+                               VaultLoader &vault_loader)
     : container_(container),
       correct_key_entered_(correct_key_entered),
+      vault_loader_(vault_loader),
       save_file_location_(save_location) {
 }
 
@@ -21,20 +23,36 @@ void EnterKeyWindow::DrawWindow() {
     // Starts creating the window
     ui::Begin("Enter Key:");
 
-    // Input text for the key
-    ui::InputText("Key", &entered_key_);
-
-    // Space between button and input text
-    ui::Text("");
+    if (vault_loader_.IsLoading()) {
+      // Shows how much of the save file was decrypted so far
+      size_t total_bytes = vault_loader_.GetTotalBytes();
+      float fraction =
+          total_bytes == 0 ? 0.0f
+                           : static_cast<float>(vault_loader_.GetReadBytes()) /
+                                 static_cast<float>(total_bytes);
+      ui::Text("Opening the save file...");
+      ui::ProgressBar(fraction);
+
+      // Button to stop loading
+      cancel_pressed_ = ui::Button("Cancel");
+      continue_pressed_ = false;
+    } else {
+      // Input text for the key
+      ui::InputText("Key", &entered_key_);
+
+      // Space between button and input text
+      ui::Text("");
+
+      // Shows error message if the wrong key was entered
+      if (wrong_key_entered_) {
+        ui::Text("ERROR: THE WRONG KEY HAS BEEN ENTERED!");
+      }
 
-    // Shows error message if the wrong key was entered
-    if (wrong_key_entered_) {
-      ui::Text("ERROR: THE WRONG KEY HAS BEEN ENTERED!");
+      // Button to submit key
+      continue_pressed_ = ui::Button("Continue");
+      cancel_pressed_ = false;
     }
 
-    // Button to submit key
-    continue_pressed_ = ui::Button("Continue");
-
     // Finishes creating the window
     ui::End();
   }
@@ -42,21 +60,25 @@ void EnterKeyWindow::DrawWindow() {
 
 void EnterKeyWindow::UpdateWindow() {
   if (!correct_key_entered_) {
-    // Checks if the continue button is pressed
-    if (continue_pressed_) {
-      try {
-        // Tries to change the key
-        container_.SetCryptographerKey(entered_key_);
-        // Tries to load the save file into the container
-        std::ifstream save_file(save_file_location_);
-        save_file >> container_;
-
-        // Sets boolean to true if there were no errors thrown when loading
+    // Starts loading the save file with the key on the loader's thread
+    if (continue_pressed_ && !vault_loader_.IsLoading()) {
+      wrong_key_entered_ = false;
+      vault_loader_.Start(save_file_location_, entered_key_);
+    }
+
+    if (cancel_pressed_) {
+      vault_loader_.Cancel();
+    }
+
+    try {
+      // Swaps the loaded data into the container once it is ready, so the
+      // other windows never see a partly loaded container
+      if (vault_loader_.TakeLoadedContainer(container_)) {
         correct_key_entered_ = true;
-      } catch (...) {
-        // If an error was thrown, a wrong key was entered
-        wrong_key_entered_ = true;
       }
+    } catch (const std::invalid_argument&) {
+      // If an error was thrown, a wrong key was entered
+      wrong_key_entered_ = true;
     }
   }
 }
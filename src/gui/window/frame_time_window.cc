@@ -0,0 +1,52 @@
+#include "gui/window/frame_time_window.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace passwordcontainer {
+
+namespace gui {
+
+namespace window {
+
+FrameTimeWindow::FrameTimeWindow(const PasswordContainer& container,
+                                 const FrameTimer& frame_timer,
+                                 const RedrawScheduler& redraw_scheduler)
+    : container_(container),
+      frame_timer_(frame_timer),
+      redraw_scheduler_(redraw_scheduler) {
+}
+
+void FrameTimeWindow::DrawWindow() {
+  ui::Begin("Frame Time:");
+
+  ui::Text(frame_time_text_.c_str());
+  ui::Text(account_count_text_.c_str());
+  ui::Text(idle_frame_text_.c_str());
+
+  ui::End();
+}
+
+void FrameTimeWindow::UpdateWindow() {
+  std::ostringstream frame_time;
+  frame_time << std::fixed << std::setprecision(3)
+             << frame_timer_.GetAverageMilliseconds() << " ms average, "
+             << frame_timer_.GetMaxMilliseconds() << " ms max ("
+             << frame_timer_.GetFrameCount() << " frames)";
+  frame_time_text_ = frame_time.str();
+  account_count_text_ =
+      std::to_string(container_.GetAccountCount()) + " accounts";
+
+  // Only updated while the app isn't idle, so this shows the idle frames up
+  // to the last time the app woke up
+  idle_frame_text_ =
+      std::to_string(redraw_scheduler_.GetIdleFrameCount()) + " of " +
+      std::to_string(redraw_scheduler_.GetFrameCount()) +
+      " frames drawn while idle";
+}
+
+}  // namespace window
+
+}  // namespace gui
+
+}  // namespace passwordcontainer
@@ -9,9 +9,10 @@ namespace window {
 
 ModifyAccountWindow::ModifyAccountWindow(PasswordContainer& container,
                                          bool& window_active,
-                                         int& account_index)
+                                         const PasswordContainer::AccountHandle&
+                                             account)
     : container_(container), modify_window_active_(window_active),
-      account_index_(account_index) {}
+      account_(account) {}
 
 void ModifyAccountWindow::DrawWindow() {
   // Makes sure the modify window is supposed to be active
@@ -52,9 +53,7 @@ void ModifyAccountWindow::UpdateWindow() {
   if (modify_window_active_) {
     // Makes sure the account being edited doesn't exist or if
     // the cancel button is pressed.
-    if (account_index_ < 0 ||
-        account_index_ >= container_.GetAccounts().size() ||
-        cancel_button_pressed_) {
+    if (!container_.IsValidHandle(account_) || cancel_button_pressed_) {
       ResetValuesToDefault();
 
     } else if (confirm_button_pressed_) {
@@ -68,8 +67,10 @@ void ModifyAccountWindow::UpdateWindow() {
     } else if (window_newly_opened_) {
       // Sets the current username and password as the values in the text inputs
       // when the window is newly opened
-      new_username_ = container_.GetAccounts()[account_index_].username;
-      new_password_ = container_.GetAccounts()[account_index_].password;
+      PasswordContainer::AccountDetails account =
+          container_.GetAccount(account_);
+      new_username_ = account.username;
+      new_password_ = account.password;
       window_newly_opened_ = false;
     }
 
@@ -84,8 +85,7 @@ void ModifyAccountWindow::TryChangingDetails() {
   if (!new_username_.empty() && !new_password_.empty()) {
     // Changes the details of the account being edited if the new details
     // are valid
-    std::string account_name = container_.GetAccounts()[account_index_].account_name;
-    container_.ModifyAccount(account_name, new_username_, new_password_);
+    container_.ModifyAccount(account_, new_username_, new_password_);
 
     ResetValuesToDefault();
   } else {
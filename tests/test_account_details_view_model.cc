@@ -0,0 +1,42 @@
+#include <catch2/catch.hpp>
+
+#include "core/password_container.h"
+#include "gui/viewmodel/account_details_view_model.h"
+
+using passwordcontainer::PasswordContainer;
+using passwordcontainer::gui::viewmodel::AccountDetailsViewModel;
+
+TEST_CASE("Tests for AccountDetailsViewModel") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Github", "Username1", "password");
+  container.AddAccount("Netflix", "Username2", "Password2");
+  PasswordContainer::AccountHandle account;
+  AccountDetailsViewModel view_model(container, account);
+
+  SECTION("Shows nothing without a selected account") {
+    REQUIRE_FALSE(view_model.Update());
+  }
+
+  SECTION("Shows the details of the selected account") {
+    account = container.FindAccountHandle("Github");
+    REQUIRE(view_model.Update());
+    REQUIRE(view_model.GetAccount().account_name == "Github");
+    REQUIRE(view_model.GetAccount().username == "Username1");
+    REQUIRE(view_model.GetStrength() == "Very weak, 5 bits");
+
+    account = container.FindAccountHandle("Netflix");
+    REQUIRE(view_model.Update());
+    REQUIRE(view_model.GetAccount().password == "Password2");
+  }
+
+  SECTION("Shows changes to the selected account") {
+    account = container.FindAccountHandle("Github");
+    view_model.Update();
+    container.ModifyAccount("Github", "NewUsername", "password");
+    REQUIRE(view_model.Update());
+    REQUIRE(view_model.GetAccount().username == "NewUsername");
+
+    container.DeleteAccount("Github");
+    REQUIRE_FALSE(view_model.Update());
+  }
+}
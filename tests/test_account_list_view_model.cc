@@ -0,0 +1,88 @@
+#include <catch2/catch.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/password_container.h"
+#include "gui/viewmodel/account_list_view_model.h"
+
+using passwordcontainer::PasswordContainer;
+using passwordcontainer::gui::viewmodel::AccountListViewModel;
+using std::string;
+using std::vector;
+
+TEST_CASE("Tests for AccountListViewModel") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Github", "Username1", "Password1");
+  container.AddAccount("Gitlab", "Username2", "Password2");
+  container.AddAccount("Netflix", "Username3", "Password3");
+  PasswordContainer::AccountHandle selected_account;
+  AccountListViewModel view_model(container, selected_account);
+
+  SECTION("Lists every account without a search") {
+    REQUIRE(view_model.GetListedNames() ==
+            vector<string>({"Github", "Gitlab", "Netflix"}));
+    REQUIRE(view_model.GetSelectedRow() == AccountListViewModel::kNoRow);
+  }
+
+  SECTION("Selecting a row selects its account") {
+    REQUIRE(view_model.SelectRow(2));
+    REQUIRE(container.GetAccountName(selected_account) == "Netflix");
+    REQUIRE(view_model.GetSelectedRow() == 2);
+    REQUIRE_FALSE(view_model.SelectRow(2));
+    REQUIRE_THROWS_AS(view_model.SelectRow(3), std::invalid_argument);
+  }
+
+  SECTION("Searches only list matching accounts") {
+    view_model.SelectRow(1);
+    view_model.SetSearchQuery("lab");
+    REQUIRE(view_model.GetListedNames() == vector<string>({"Gitlab"}));
+    REQUIRE(view_model.GetSelectedRow() == 0);
+
+    view_model.SetSearchQuery("flix");
+    REQUIRE(view_model.GetSelectedRow() == AccountListViewModel::kNoRow);
+    REQUIRE(view_model.SelectRow(0));
+    REQUIRE(container.GetAccountName(selected_account) == "Netflix");
+  }
+
+  SECTION("Search results are updated when the accounts change") {
+    view_model.SetSearchQuery("git");
+    REQUIRE(view_model.GetListedNames().size() == 2);
+    container.DeleteAccount("Gitlab");
+    container.AddAccount("Gitea", "Username4", "Password4");
+    REQUIRE(view_model.GetListedNames() ==
+            vector<string>({"Gitea", "Github"}));
+  }
+
+  SECTION("Requested deletes apply to the selected account") {
+    view_model.RequestDelete();
+    view_model.Update();
+    REQUIRE(container.GetAccountCount() == 3);
+
+    view_model.SelectRow(0);
+    REQUIRE_FALSE(view_model.IsDeleteRequested());
+    view_model.RequestDelete();
+    view_model.Update();
+    REQUIRE(view_model.GetListedNames() ==
+            vector<string>({"Gitlab", "Netflix"}));
+    REQUIRE_FALSE(container.IsValidHandle(selected_account));
+    REQUIRE_FALSE(view_model.IsDeleteRequested());
+  }
+
+  SECTION("Selecting another account drops a requested delete") {
+    view_model.SelectRow(0);
+    view_model.RequestDelete();
+    view_model.SelectRow(1);
+    view_model.Update();
+    REQUIRE(container.GetAccountCount() == 3);
+  }
+
+  SECTION("Stale selections are detected after another delete") {
+    view_model.SelectRow(2);
+    container.DeleteAccount("Github");
+    REQUIRE(view_model.GetSelectedRow() == 1);
+
+    container.DeleteAccount("Netflix");
+    REQUIRE(view_model.GetSelectedRow() == AccountListViewModel::kNoRow);
+  }
+}
@@ -0,0 +1,113 @@
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+#include "core/search/account_search_index.h"
+
+using passwordcontainer::AccountSearchIndex;
+using std::string;
+using std::vector;
+
+TEST_CASE("Tests for AccountSearchIndex") {
+  AccountSearchIndex index;
+  index.Rebuild({"Github", "gmail", "Google Drive", "Amazon", "my google"});
+
+  SECTION("Finds names by prefix in sorted order ignoring case") {
+    REQUIRE(index.FindByPrefix("G", 0) ==
+            vector<string>({"Github", "gmail", "Google Drive"}));
+    REQUIRE(index.FindByPrefix("goo", 0) == vector<string>({"Google Drive"}));
+    REQUIRE(index.FindByPrefix("Yahoo", 0).empty());
+  }
+
+  SECTION("An empty prefix matches every name") {
+    REQUIRE(index.FindByPrefix("", 0).size() == 5);
+  }
+
+  SECTION("Finds names by substring ignoring case") {
+    REQUIRE(index.FindBySubstring("OOGLE", 0) ==
+            vector<string>({"Google Drive", "my google"}));
+    REQUIRE(index.FindBySubstring("ma", 0) ==
+            vector<string>({"Amazon", "gmail"}));
+    REQUIRE(index.FindBySubstring("google drive!", 0).empty());
+  }
+
+  SECTION("Checks that the trigrams of a query are next to each other") {
+    index.Insert("abcxbcd");
+    REQUIRE(index.FindBySubstring("abcd", 0).empty());
+    REQUIRE(index.FindBySubstring("xbcd", 0) == vector<string>({"abcxbcd"}));
+  }
+
+  SECTION("Search lists prefix matches before other matches") {
+    REQUIRE(index.Search("g", 0) ==
+            vector<string>({"Github", "gmail", "Google Drive", "my google"}));
+  }
+
+  SECTION("Limits the number of results") {
+    REQUIRE(index.FindByPrefix("g", 2) == vector<string>({"Github", "gmail"}));
+    REQUIRE(index.FindBySubstring("o", 1) == vector<string>({"Amazon"}));
+    REQUIRE(index.Search("goog", 1) == vector<string>({"Google Drive"}));
+  }
+
+  SECTION("Inserted names can be found") {
+    index.Insert("Google Photos");
+    REQUIRE(index.GetSize() == 6);
+    REQUIRE(index.FindByPrefix("google", 0) ==
+            vector<string>({"Google Drive", "Google Photos"}));
+    REQUIRE(index.FindBySubstring("photo", 0) ==
+            vector<string>({"Google Photos"}));
+  }
+
+  SECTION("Names that only differ by case are different names") {
+    index.Insert("GMAIL");
+    REQUIRE(index.FindByPrefix("gmail", 0) ==
+            vector<string>({"GMAIL", "gmail"}));
+  }
+
+  SECTION("Removed names can't be found") {
+    index.Remove("Google Drive");
+    REQUIRE(index.GetSize() == 4);
+    REQUIRE(index.FindByPrefix("goo", 0).empty());
+    REQUIRE(index.FindBySubstring("drive", 0).empty());
+    REQUIRE(index.FindBySubstring("google", 0) ==
+            vector<string>({"my google"}));
+  }
+
+  SECTION("Reuses the ids of removed names") {
+    index.Remove("Github");
+    index.Insert("Bitbucket");
+    REQUIRE(index.FindBySubstring("bucket", 0) ==
+            vector<string>({"Bitbucket"}));
+    REQUIRE(index.FindBySubstring("hub", 0).empty());
+  }
+
+  SECTION("Rebuilding replaces every name") {
+    index.Rebuild({"Netflix"});
+    REQUIRE(index.GetSize() == 1);
+    REQUIRE(index.FindBySubstring("flix", 0) == vector<string>({"Netflix"}));
+    REQUIRE(index.FindByPrefix("g", 0).empty());
+  }
+
+  SECTION("Finds the closest names to a mistyped name") {
+    REQUIRE(index.FindClosest("gitbub", 0, 2) == vector<string>({"Github"}));
+    REQUIRE(index.FindClosest("GMIAL", 0, 2) == vector<string>({"gmail"}));
+    REQUIRE(index.FindClosest("Yahoo", 0, 2).empty());
+  }
+
+  SECTION("Ranks the closest names first") {
+    index.Insert("gmal");
+    index.Insert("email");
+    REQUIRE(index.FindClosest("gmai", 0, 2) ==
+            vector<string>({"gmail", "gmal", "email"}));
+    REQUIRE(index.FindClosest("gmai", 2, 2) ==
+            vector<string>({"gmail", "gmal"}));
+  }
+
+  SECTION("Throws exception when inserting a name twice") {
+    REQUIRE_THROWS_AS(index.Insert("gmail"), std::invalid_argument);
+  }
+
+  SECTION("Throws exception when removing a missing name") {
+    REQUIRE_THROWS_AS(index.Remove("Yahoo"), std::invalid_argument);
+    REQUIRE_THROWS_AS(index.Remove("GMAIL"), std::invalid_argument);
+  }
+}
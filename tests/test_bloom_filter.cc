@@ -0,0 +1,70 @@
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <string>
+
+#include "core/audit/bloom_filter.h"
+#include "core/encryption/sha1.h"
+
+using passwordcontainer::BloomFilter;
+using passwordcontainer::Sha1;
+using std::string;
+
+TEST_CASE("Tests for BloomFilter") {
+  const size_t item_count = 1000;
+  size_t bit_count = BloomFilter::GetOptimalBitCount(item_count, 0.01);
+  BloomFilter filter(bit_count,
+                     BloomFilter::GetOptimalHashCount(bit_count, item_count));
+  for (size_t index = 0; index < item_count; index++) {
+    filter.Add(Sha1("added" + std::to_string(index)));
+  }
+
+  SECTION("Picks the standard size and number of hashes") {
+    REQUIRE(bit_count == 9586);
+    REQUIRE(filter.GetHashCount() == 7);
+  }
+
+  SECTION("Never misses an added digest") {
+    for (size_t index = 0; index < item_count; index++) {
+      REQUIRE(filter.MightContain(Sha1("added" + std::to_string(index))));
+    }
+  }
+
+  SECTION("Rarely contains digests that weren't added") {
+    size_t false_positives = 0;
+    for (size_t index = 0; index < 10000; index++) {
+      false_positives +=
+          filter.MightContain(Sha1("missing" + std::to_string(index)));
+    }
+
+    REQUIRE(false_positives < 300);
+  }
+
+  SECTION("Opens a saved filter") {
+    const string file_path = "../../../tests/resources/Filter.bloom";
+    filter.Save(file_path);
+
+    {
+      BloomFilter opened(file_path);
+      REQUIRE(opened.GetBitCount() == filter.GetBitCount());
+      REQUIRE(opened.MightContain(Sha1("added7")));
+      REQUIRE(opened.MightContain(Sha1("missing7")) ==
+              filter.MightContain(Sha1("missing7")));
+      REQUIRE_THROWS_AS(opened.Add(Sha1("other")), std::invalid_argument);
+    }
+
+    std::remove(file_path.c_str());
+  }
+
+  SECTION("Throws exception for bad parameters") {
+    REQUIRE_THROWS_AS(BloomFilter(0, 1), std::invalid_argument);
+    REQUIRE_THROWS_AS(BloomFilter(8, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(filter.Add("short"), std::invalid_argument);
+  }
+
+  SECTION("Throws exception for files that aren't filters") {
+    REQUIRE_THROWS_AS(BloomFilter("../../../tests/resources/Missing.bloom"),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(BloomFilter("../../../tests/resources/Data.pwords"),
+                      std::invalid_argument);
+  }
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/audit/breached_password_checker.h"
+#include "core/encryption/key_derivation.h"
+#include "core/encryption/sha1.h"
+#include "core/util.h"
+
+using passwordcontainer::BreachedPasswordChecker;
+using passwordcontainer::Sha1;
+using passwordcontainer::keyderivation::ConvertToHex;
+using std::string;
+
+namespace {
+
+// Writes a sorted list of the hashes of "breached0" to "breached<count - 1>"
+// in upper case with counts and Windows line endings, the format breached
+// password lists are downloaded in.
+void WriteCorpus(const string& file_path, size_t count) {
+  std::vector<std::pair<string, size_t>> lines;
+  for (size_t index = 0; index < count; index++) {
+    string hex = ConvertToHex(Sha1("breached" + std::to_string(index)));
+    std::transform(hex.begin(), hex.end(), hex.begin(), ::toupper);
+    lines.push_back(std::make_pair(hex, index + 1));
+  }
+  std::sort(lines.begin(), lines.end());
+
+  std::ofstream file(file_path, std::ios::binary);
+  for (const std::pair<string, size_t>& line : lines) {
+    file << line.first << ':' << line.second << "\r\n";
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Tests for BreachedPasswordChecker") {
+  const string corpus_path = "../../../tests/resources/Breaches.txt";
+  const string bloom_filter_path = corpus_path + ".bloom";
+  const size_t breached_count = 20000;
+  WriteCorpus(corpus_path, breached_count);
+
+  SECTION("Finds every breached password with its count") {
+    BreachedPasswordChecker checker(corpus_path);
+    for (size_t index = 0; index < breached_count; index += 7) {
+      REQUIRE(checker.GetBreachCount("breached" + std::to_string(index)) ==
+              index + 1);
+    }
+  }
+
+  SECTION("Doesn't find passwords that aren't in the list") {
+    BreachedPasswordChecker checker(corpus_path);
+    REQUIRE_FALSE(checker.IsBreached("correct horse battery staple"));
+    REQUIRE_FALSE(checker.IsBreached(""));
+    REQUIRE_FALSE(checker.IsBreached("breached" +
+                                     std::to_string(breached_count)));
+  }
+
+  SECTION("Gives the same answers with a Bloom filter") {
+    BreachedPasswordChecker::BuildBloomFilter(corpus_path, bloom_filter_path,
+                                              0.001);
+    BreachedPasswordChecker checker(corpus_path, bloom_filter_path);
+    REQUIRE(checker.HasBloomFilter());
+    REQUIRE(checker.GetBreachCount("breached1234") == 1235);
+    REQUIRE_FALSE(checker.IsBreached("not breached"));
+  }
+
+  SECTION("Reads small lists in lower case without counts") {
+    const string small_path = "../../../tests/resources/SmallBreaches.txt";
+    {
+      std::ofstream file(small_path, std::ios::binary);
+      file << ConvertToHex(Sha1("password")) << '\n'
+           << ConvertToHex(Sha1("123456"));
+    }
+
+    {
+      BreachedPasswordChecker checker(small_path);
+      REQUIRE(checker.GetBreachCount("password") == 1);
+      REQUIRE(checker.IsBreached("123456"));
+      REQUIRE_FALSE(checker.IsBreached("1234567"));
+    }
+
+    std::remove(small_path.c_str());
+  }
+
+  SECTION("Checks generated passwords") {
+    BreachedPasswordChecker checker(corpus_path);
+    REQUIRE_FALSE(checker.IsBreached(util::GenerateRandomPassword(16)));
+  }
+
+  SECTION("Throws exception for missing files and bad lines") {
+    REQUIRE_THROWS_AS(
+        BreachedPasswordChecker("../../../tests/resources/Missing.txt"),
+        std::invalid_argument);
+
+    BreachedPasswordChecker checker("../../../tests/resources/Data.pwords");
+    REQUIRE_THROWS_AS(checker.IsBreached("password"), std::invalid_argument);
+  }
+
+  std::remove(corpus_path.c_str());
+  std::remove(bloom_filter_path.c_str());
+}
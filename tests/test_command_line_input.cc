@@ -1,4 +1,5 @@
 #include <catch2/catch.hpp>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -143,7 +144,15 @@ TEST_CASE("Tests for HandleSingleCommand with an empty container") {
     // Code to get all data from the input file found here:
     // https://stackoverflow.com/questions/3203452/how-to-read-entire-stream-into-a-stdstring
     string file_data(std::istreambuf_iterator<char>(save_file), {});
-    REQUIRE(file_data == "");
+
+    // The file only has the header for the key when there is no data
+    REQUIRE(file_data.find("PWC1 ") == 0);
+    REQUIRE(file_data.find('\n') == file_data.size() - 1);
+
+    std::stringstream saved_data(file_data);
+    PasswordContainer saved_container(100, "CorrectKey");
+    saved_data >> saved_container;
+    REQUIRE(saved_container.GetAccounts().empty());
   }
 
   SECTION("Save command saves empty string to file") {
@@ -153,6 +162,274 @@ TEST_CASE("Tests for HandleSingleCommand with an empty container") {
     REQUIRE(cli.GetContainer().GetCryptographerKey() == "NewKey");
   }
 
+  SECTION("Calibrate command sets the key stretching iterations") {
+    input << "calibrate kdf\n"
+             "invalid\n"
+             "-5\n"
+             "10\n";
+    REQUIRE(cli.HandleSingleCommand());
+
+    size_t iterations = cli.GetContainer().GetKdfIterations();
+    REQUIRE(iterations >= 1000);
+    REQUIRE(output.str() ==
+            "> Please enter the target unlock time in ms: "
+            "Please enter the target unlock time in ms: "
+            "Please enter the target unlock time in ms: "
+            "Key stretching now uses " +
+                std::to_string(iterations) + " iterations!\n\n");
+  }
+
+  SECTION("Rekey command shows an error when the file can't be rekeyed") {
+    const string file_path = "../../../tests/resources/Rekeyed.pwords";
+    std::ofstream(file_path).close();
+    CommandLineInput rekey_cli(input, output, file_path, "CorrectKey");
+    std::remove(file_path.c_str());
+
+    input << "rekey\n"
+             "NewKey\n";
+    REQUIRE(rekey_cli.HandleSingleCommand());
+    REQUIRE(output.str() ==
+            "> Please enter the new key: "
+            "There is no file in the passed in location!\n\n");
+  }
+
+  SECTION("Pool usernames command toggles username pooling") {
+    input << "pool usernames\n"
+             "pool usernames\n";
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.GetContainer().IsUsernamePoolingEnabled());
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE_FALSE(cli.GetContainer().IsUsernamePoolingEnabled());
+    REQUIRE(output.str() ==
+            "> Username pooling is now on!\n\n"
+            "> Username pooling is now off!\n\n");
+  }
+
+  SECTION("Search command lists matching accounts") {
+    input << "add\n"
+             "My Gmail\nUsername1\nPassword1\n"
+             "add\n"
+             "Gmail\nUsername2\nPassword2\n"
+             "search\n"
+             "gmail\n"
+             "search\n"
+             "yahoo\n";
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.HandleSingleCommand());
+    output.str("");
+
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str() ==
+            "> Please enter the search text: Gmail\nMy Gmail\n\n"
+            "> Please enter the search text: No accounts found!\n\n");
+  }
+
+  SECTION("Accounts for user command lists the accounts of a username") {
+    input << "add\n"
+             "Github\nshared@example.com\nPassword1\n"
+             "add\n"
+             "Amazon\nshared@example.com\nPassword2\n"
+             "accounts for user\n"
+             "shared@example.com\n"
+             "accounts for user\n"
+             "other@example.com\n";
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.HandleSingleCommand());
+    output.str("");
+
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str() ==
+            "> Please enter the username: Amazon\nGithub\n\n"
+            "> Please enter the username: No accounts use that username!\n\n");
+  }
+
+  SECTION("Audit reuse command lists accounts that share a password") {
+    input << "add\n"
+             "Github\nUsername1\nShared1\n"
+             "add\n"
+             "Amazon\nUsername2\nShared1\n"
+             "add\n"
+             "Netflix\nUsername3\nUnique1\n"
+             "audit reuse\n";
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.HandleSingleCommand());
+    output.str("");
+
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str().find("> Accounts sharing a password: Amazon, Github\n"
+                              "Found 1 reused passwords in 3 accounts (") == 0);
+    REQUIRE(output.str().find(" ms)!\n\n") != string::npos);
+  }
+
+  SECTION("Audit breaches command lists accounts with breached passwords") {
+    const string corpus_path = "../../../tests/resources/Breaches.txt";
+    {
+      std::ofstream file(corpus_path);
+      // The SHA-1 hash of "password"
+      file << "5BAA61E4C9B93F3F0682250B6CF8331B7EE68FD8:3730471\n";
+    }
+
+    input << "add\n"
+             "Github\nUsername1\npassword\n"
+             "add\n"
+             "Amazon\nUsername2\nXq8!vR2#pL\n"
+             "audit breaches\n" +
+                 corpus_path + "\n";
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.HandleSingleCommand());
+    output.str("");
+
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str().find("> Please enter the breached password list "
+                              "location: Building a Bloom filter for the "
+                              "list...\n"
+                              "Breached password: Github\n"
+                              "Found 1 breached passwords in 2 accounts (") ==
+            0);
+    REQUIRE(std::ifstream(corpus_path + ".bloom").good());
+
+    std::remove(corpus_path.c_str());
+    std::remove((corpus_path + ".bloom").c_str());
+  }
+
+  SECTION("Audit breaches command shows an error for a missing list") {
+    input << "audit breaches\n"
+             "../../../tests/resources/MissingBreaches.txt\n";
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str() ==
+            "> Please enter the breached password list location: "
+            "There is no file in the passed in location!\n\n");
+  }
+
+  SECTION("Audit breaches command shows an error for a malformed list") {
+    const string corpus_path = "../../../tests/resources/BadBreaches.txt";
+    std::ofstream(corpus_path) << "not a hash\n";
+
+    input << "audit breaches\n" + corpus_path + "\n";
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str() ==
+            "> Please enter the breached password list location: "
+            "Building a Bloom filter for the list...\n"
+            "Bad breach file passed in!\n\n");
+
+    std::remove(corpus_path.c_str());
+    std::remove((corpus_path + ".bloom").c_str());
+  }
+
+  SECTION("Import csv command imports accounts and lists bad rows") {
+    const string csv_path = "../../../tests/resources/Import.csv";
+    {
+      std::ofstream file(csv_path);
+      file << "name,username,password\n"
+              "Github,Username1,Password1\n"
+              "Amazon,,Password2\n";
+    }
+
+    input << "import csv\n" << csv_path << "\n";
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str().find(
+                "> Please enter the CSV file location: "
+                "Line 3: Please pass in valid account information!\n"
+                "Imported 1 of 2 accounts (") == 0);
+    REQUIRE(output.str().find(" ms)!\n\n") != string::npos);
+    REQUIRE(cli.GetContainer().HasAccount("Github"));
+    std::remove(csv_path.c_str());
+  }
+
+  SECTION("Export and import json commands copy accounts through a file") {
+    const string json_path = "../../../tests/resources/Export.json";
+    input << "add\n"
+             "Github\nUsername1\nPassword1\n"
+             "export json\n" << json_path << "\n"
+             "delete\nGithub\n"
+             "import json\n" << json_path << "\n";
+    REQUIRE(cli.HandleSingleCommand());
+    output.str("");
+
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str() ==
+            "> Please enter the JSON file location: "
+            "Exported 1 accounts! The file is not encrypted.\n\n");
+    REQUIRE(cli.HandleSingleCommand());
+    output.str("");
+
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str().find("> Please enter the JSON file location: "
+                              "Imported 1 of 1 accounts (") == 0);
+    REQUIRE(cli.GetContainer().GetAccount(0).password == "Password1");
+    std::remove(json_path.c_str());
+  }
+
+  SECTION("Audit strength command lists accounts with weak passwords") {
+    input << "add\n"
+             "Github\nUsername1\npassword\n"
+             "add\n"
+             "Amazon\nUsername2\nk#9Tq%mZ2&vW8pLr\n"
+             "audit strength\n";
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.HandleSingleCommand());
+    output.str("");
+
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str().find("> Weak password: Github (Very weak, 5 bits)\n"
+                              "Found 1 weak passwords in 2 accounts (") == 0);
+    REQUIRE(output.str().find(" ms)!\n\n") != string::npos);
+  }
+
+  SECTION("Batch commands apply staged changes together or not at all") {
+    input << "begin batch\n"
+             "add\nGithub\nUsername1\nPassword1\n"
+             "modify\nGithub\nUsername2\nPassword2\n"
+             "commit batch\n"
+             "begin batch\n"
+             "delete\nGithub\n"
+             "delete\nAmazon\n"
+             "commit batch\n";
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.GetContainer().GetAccountCount() == 0);
+    output.str("");
+
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str().find("> Committed 2 changes (") == 0);
+    REQUIRE(cli.GetContainer().GetAccount(0).username == "Username2");
+
+    for (size_t command = 0; command < 3; command++) {
+      REQUIRE(cli.HandleSingleCommand());
+    }
+    output.str("");
+
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str() ==
+            "> No account with passed in name in container!\n"
+            "None of the 2 changes were committed!\n\n");
+    REQUIRE(cli.GetContainer().HasAccount("Github"));
+  }
+
+  SECTION("Mistyped account names get suggestions") {
+    input << "add\n"
+             "Github\nUsername1\nPassword1\n"
+             "show details\n"
+             "Githbu\n"
+             "delete\n"
+             "gitub\n";
+    REQUIRE(cli.HandleSingleCommand());
+    output.str("");
+
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(cli.HandleSingleCommand());
+    REQUIRE(output.str() ==
+            "> Please enter the account name: That account does not exist!\n"
+            "Did you mean: Github?\n\n"
+            "> Please enter the Account Name: That account does not exist!\n"
+            "Did you mean: Github?\n\n");
+    REQUIRE(cli.GetContainer().GetAccountCount() == 1);
+  }
+
   SECTION("Quit command returns false") {
     input << "quit\n";
     REQUIRE_FALSE(cli.HandleSingleCommand());
@@ -243,7 +520,8 @@ TEST_CASE("Tests for HandleSingleCommand with a populated container") {
     REQUIRE(output.str() ==
             "> Please enter the account name: "
             "Username: Username1\n"
-            "Password: Password1\n\n");
+            "Password: Password1\n"
+            "Strength: Very weak, 12 bits\n\n");
   }
 
   SECTION("Save command saves encrypted string to file") {
@@ -350,7 +628,8 @@ TEST_CASE("Tests for HandleSingleCommand with invalid commands") {
             "> Please enter the account name: "
             "Please enter the account name: "
             "Username: Username1\n"
-            "Password: Password1\n\n");
+            "Password: Password1\n"
+            "Strength: Very weak, 12 bits\n\n");
   }
 
   SECTION("Generate random password only accepts numerical input") {
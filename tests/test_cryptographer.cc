@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+#include <string>
+
+#include "core/encryption/cryptographer.h"
+#include "core/encryption/triplet_decoder.h"
+
+using passwordcontainer::Cryptographer;
+using passwordcontainer::tripletdecoder::DecodeTriplets;
+using passwordcontainer::tripletdecoder::DecodeTripletsScalar;
+using std::string;
+
+// Creates a string of the passed in length that has every valid character
+// repeated in it.
+string CreateLongPlainText(size_t length) {
+  string valid_chars = "\t\n";
+  for (char c = ' '; c <= '~'; c++) {
+    valid_chars += c;
+  }
+
+  string plain_text;
+  for (size_t index = 0; index < length; index++) {
+    plain_text += valid_chars[(index * 7) % valid_chars.size()];
+  }
+
+  return plain_text;
+}
+
+TEST_CASE("Tests for SetParallelism") {
+  Cryptographer serial(100, "key");
+  Cryptographer parallel(100, "key");
+  parallel.SetParallelism(4, 0);
+
+  string plain_text = CreateLongPlainText(10007);
+  string encrypted_text = serial.EncryptString(plain_text);
+
+  SECTION("Parallel encryption gives the same result as serial encryption") {
+    REQUIRE(parallel.EncryptString(plain_text) == encrypted_text);
+  }
+
+  SECTION("Parallel decryption gives the same result as serial decryption") {
+    REQUIRE(parallel.DecryptString(encrypted_text) == plain_text);
+  }
+
+  SECTION("Parallel decryption throws error for bad data") {
+    encrypted_text[encrypted_text.size() - 4] = 'x';
+    REQUIRE_THROWS_AS(parallel.DecryptString(encrypted_text),
+                      std::invalid_argument);
+  }
+
+  SECTION("Strings below the threshold give the same result") {
+    parallel.SetParallelism(4, 1 << 20);
+    REQUIRE(parallel.EncryptString(plain_text) == encrypted_text);
+    REQUIRE(parallel.DecryptString(encrypted_text) == plain_text);
+  }
+
+  SECTION("Handles empty and single character strings") {
+    REQUIRE(parallel.EncryptString("") == "");
+    REQUIRE(parallel.DecryptString("") == "");
+    REQUIRE(parallel.DecryptString(parallel.EncryptString("a")) == "a");
+  }
+
+  SECTION("Copies of the cryptographer can still run in parallel") {
+    Cryptographer copy = parallel;
+    REQUIRE(copy.DecryptString(encrypted_text) == plain_text);
+  }
+}
+
+TEST_CASE("Tests for DecodeTriplets") {
+  // Encrypts with offset 150, which is what DecodeTriplets gets passed below
+  string plain_text = CreateLongPlainText(1000);
+  string encrypted_text;
+  for (char c : plain_text) {
+    encrypted_text += std::to_string(static_cast<size_t>(c) + 150);
+  }
+
+  string output(plain_text.size(), '\0');
+
+  SECTION("Decodes the same characters as the scalar implementation") {
+    // Uses every length so all block sizes and leftovers get used
+    for (size_t length = 0; length <= 100; length++) {
+      string scalar_output(length, '\0');
+      REQUIRE(DecodeTriplets(encrypted_text.data(), length, 150, &output[0]));
+      REQUIRE(DecodeTripletsScalar(encrypted_text.data(), length, 150,
+                                   &scalar_output[0]));
+      REQUIRE(output.substr(0, length) == scalar_output);
+      REQUIRE(scalar_output == plain_text.substr(0, length));
+    }
+  }
+
+  SECTION("Rejects a non digit anywhere in the data") {
+    for (size_t index = 0; index < 300; index += 7) {
+      string bad_text = encrypted_text;
+      bad_text[index] = '/';
+      REQUIRE_FALSE(
+          DecodeTriplets(bad_text.data(), plain_text.size(), 150, &output[0]));
+    }
+  }
+
+  SECTION("Rejects groups that don't decode to valid characters") {
+    for (size_t index = 0; index < 300; index += 3) {
+      string bad_text = encrypted_text;
+      bad_text.replace(index, 3, "150");
+      REQUIRE_FALSE(
+          DecodeTriplets(bad_text.data(), plain_text.size(), 150, &output[0]));
+    }
+  }
+
+  SECTION("Rejects everything when decoded with the wrong offset") {
+    REQUIRE_FALSE(DecodeTriplets(encrypted_text.data(), plain_text.size(), 200,
+                                 &output[0]));
+    REQUIRE_FALSE(DecodeTriplets(encrypted_text.data(), plain_text.size(), 1000,
+                                 &output[0]));
+  }
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/io/csv_importer.h"
+
+using passwordcontainer::CsvImporter;
+using passwordcontainer::ImportReport;
+using passwordcontainer::PasswordContainer;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+TEST_CASE("Tests for CsvImporter") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Github", "Username1", "Password1");
+  CsvImporter importer(1);
+
+  SECTION("Imports the columns of a Chrome export") {
+    stringstream input(
+        "name,url,username,password\n"
+        "Amazon,https://amazon.com,User2,\"Pass,2\"\n"
+        "Netflix,https://netflix.com,User3,Pass3\n");
+    ImportReport report = importer.Import(input, container);
+
+    REQUIRE(report.row_count == 2);
+    REQUIRE(report.imported_count == 2);
+    REQUIRE(report.errors.empty());
+    REQUIRE(container.GetAccountNames() ==
+            vector<string>({"Github", "Amazon", "Netflix"}));
+    REQUIRE(container.GetAccount(1).password == "Pass,2");
+  }
+
+  SECTION("Finds columns by other names ignoring case") {
+    stringstream input(
+        "\xEF\xBB\xBF" "URL,Login_Username,Login_Password,notes\r\n"
+        "https://amazon.com,User2,Pass2,\r\n");
+    ImportReport report = importer.Import(input, container);
+
+    REQUIRE(report.imported_count == 1);
+    REQUIRE(container.GetAccount(1).account_name == "https://amazon.com");
+    REQUIRE(container.GetAccount(1).username == "User2");
+  }
+
+  SECTION("Reports bad rows with their line numbers") {
+    stringstream input(
+        "name,username,password\n"
+        "Amazon,User2,Pass2\n"
+        "Github,User3,Pass3\n"
+        "Amazon,User4,Pass4\n"
+        "Empty,,Pass5\n"
+        "\"Two\nLines\",User6,Pass6\n"
+        "Short,User7\n"
+        "Netflix,User8,Pass8\n");
+    ImportReport report = importer.Import(input, container);
+
+    REQUIRE(report.row_count == 7);
+    REQUIRE(report.imported_count == 2);
+    REQUIRE(report.errors.size() == 5);
+    REQUIRE(report.errors[0].line_number == 3);
+    REQUIRE(report.errors[1].line_number == 4);
+    REQUIRE(report.errors[2].line_number == 5);
+    REQUIRE(report.errors[3].line_number == 6);
+    REQUIRE(report.errors[3].message ==
+            "Account details can't contain tabs or line breaks!");
+    REQUIRE(report.errors[4].line_number == 8);
+    REQUIRE(report.errors[4].message == "Missing a column!");
+    REQUIRE(container.GetAccountNames() ==
+            vector<string>({"Github", "Amazon", "Netflix"}));
+  }
+
+  SECTION("Imports large files in parallel") {
+    string text = "name,username,password\n";
+    for (size_t index = 0; index < 20000; index++) {
+      text += "Account" + std::to_string(index) + ",User,Pass" +
+              std::to_string(index) + "\n";
+    }
+    stringstream input(text);
+    ImportReport report = CsvImporter(4, 4096).Import(input, container);
+
+    REQUIRE(report.imported_count == 20000);
+    REQUIRE(container.GetAccountCount() == 20001);
+    REQUIRE(container.HasAccount("Account19999"));
+    REQUIRE(container.GetAccountsForUsername("User").size() == 20000);
+  }
+
+  SECTION("Throws exception without the needed columns") {
+    stringstream input("name,password\nAmazon,Pass2\n");
+    REQUIRE_THROWS_AS(importer.Import(input, container),
+                      std::invalid_argument);
+    stringstream empty_input("");
+    REQUIRE_THROWS_AS(importer.Import(empty_input, container),
+                      std::invalid_argument);
+    REQUIRE(container.GetAccountCount() == 1);
+  }
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/io/csv_reader.h"
+
+using passwordcontainer::CsvReader;
+using passwordcontainer::CsvRecord;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+namespace {
+
+// Reads every record in the passed in text with the passed in chunk length.
+vector<CsvRecord> ReadAllRecords(const string& text, size_t thread_count,
+                                 size_t chunk_length) {
+  stringstream input(text);
+  CsvReader reader(input, thread_count, chunk_length);
+
+  vector<CsvRecord> records;
+  for (vector<CsvRecord> chunk = reader.ReadRecords(); !chunk.empty();
+       chunk = reader.ReadRecords()) {
+    records.insert(records.end(), chunk.begin(), chunk.end());
+  }
+
+  return records;
+}
+
+}  // namespace
+
+TEST_CASE("Tests for CsvReader") {
+  SECTION("Splits records into fields") {
+    vector<CsvRecord> records = ReadAllRecords("a,b,c\n1,,3\n", 1, 1024);
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].fields == vector<string>({"a", "b", "c"}));
+    REQUIRE(records[1].fields == vector<string>({"1", "", "3"}));
+    REQUIRE(records[1].line_number == 2);
+  }
+
+  SECTION("Unquotes quoted fields") {
+    vector<CsvRecord> records =
+        ReadAllRecords("\"a,b\",\"say \"\"hi\"\"\",\"\"\r\n", 1, 1024);
+    REQUIRE(records.size() == 1);
+    REQUIRE(records[0].fields == vector<string>({"a,b", "say \"hi\"", ""}));
+  }
+
+  SECTION("Keeps line breaks in quoted fields and counts their lines") {
+    vector<CsvRecord> records =
+        ReadAllRecords("\"two\nlines\",x\r\n\nlast,y", 1, 1024);
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].fields == vector<string>({"two\nlines", "x"}));
+    REQUIRE(records[1].fields == vector<string>({"last", "y"}));
+    REQUIRE(records[1].line_number == 4);
+  }
+
+  SECTION("Reports malformed records") {
+    vector<CsvRecord> records =
+        ReadAllRecords("\"a\"b,c\ngood,row\n\"open,d\n", 1, 1024);
+    REQUIRE(records.size() == 3);
+    REQUIRE(records[0].error == "Unexpected character after a quoted field!");
+    REQUIRE(records[1].error.empty());
+    REQUIRE(records[2].error == "Unterminated quoted field!");
+    REQUIRE(records[2].line_number == 3);
+  }
+
+  SECTION("Reads the same records with any chunk length and thread count") {
+    string text;
+    for (size_t index = 0; index < 5000; index++) {
+      text += "name" + std::to_string(index) + ",\"user,\n" +
+              std::to_string(index) + "\",\"pass\"\"word\"\n";
+    }
+
+    vector<CsvRecord> expected = ReadAllRecords(text, 1, 1 << 20);
+    REQUIRE(expected.size() == 5000);
+    REQUIRE(expected[4999].line_number == 9999);
+    REQUIRE(expected[4999].fields ==
+            vector<string>({"name4999", "user,\n4999", "pass\"word"}));
+
+    vector<CsvRecord> records = ReadAllRecords(text, 4, 7);
+    REQUIRE(records.size() == expected.size());
+    for (size_t index = 0; index < records.size(); index++) {
+      REQUIRE(records[index].fields == expected[index].fields);
+      REQUIRE(records[index].line_number == expected[index].line_number);
+    }
+  }
+
+  SECTION("Throws exception for a chunk length of 0") {
+    stringstream input;
+    REQUIRE_THROWS_AS(CsvReader(input, 1, 0), std::invalid_argument);
+  }
+}
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/search/edit_distance_matcher.h"
+
+using passwordcontainer::EditDistanceMatcher;
+using std::string;
+
+namespace {
+
+// Calculates the edit distance with the full table and no bound to check the
+// matcher against.
+size_t GetExpectedDistance(const string& first, const string& second) {
+  std::vector<std::vector<size_t>> table(
+      first.size() + 1, std::vector<size_t>(second.size() + 1));
+  for (size_t row = 0; row <= first.size(); row++) {
+    for (size_t column = 0; column <= second.size(); column++) {
+      if (row == 0 || column == 0) {
+        table[row][column] = row + column;
+      } else {
+        size_t replace_cost = first[row - 1] == second[column - 1] ? 0 : 1;
+        table[row][column] =
+            std::min(std::min(table[row - 1][column] + 1,
+                              table[row][column - 1] + 1),
+                     table[row - 1][column - 1] + replace_cost);
+      }
+    }
+  }
+
+  return table[first.size()][second.size()];
+}
+
+}  // namespace
+
+TEST_CASE("Tests for EditDistanceMatcher") {
+  SECTION("Finds the distance of common typos") {
+    EditDistanceMatcher matcher("github");
+    REQUIRE(matcher.GetDistance("github", 3) == 0);
+    REQUIRE(matcher.GetDistance("githb", 3) == 1);
+    REQUIRE(matcher.GetDistance("gihtub", 3) == 2);
+    REQUIRE(matcher.GetDistance("githubb", 3) == 1);
+    REQUIRE(matcher.GetDistance("kitten", 10) == 4);
+  }
+
+  SECTION("Returns one more than the bound for distant texts") {
+    EditDistanceMatcher matcher("github");
+    REQUIRE(matcher.GetDistance("amazon", 2) == 3);
+    REQUIRE(matcher.GetDistance("github.example.com", 2) == 3);
+    REQUIRE(matcher.GetDistance("", 2) == 3);
+  }
+
+  SECTION("Handles empty patterns and texts") {
+    REQUIRE(EditDistanceMatcher("").GetDistance("abc", 5) == 3);
+    REQUIRE(EditDistanceMatcher("abc").GetDistance("", 5) == 3);
+    REQUIRE(EditDistanceMatcher("").GetDistance("", 0) == 0);
+  }
+
+  SECTION("Matches the full table for short and long patterns") {
+    std::mt19937 generator(36);
+    std::uniform_int_distribution<int> character('a', 'd');
+    std::uniform_int_distribution<size_t> length(0, 80);
+
+    for (size_t trial = 0; trial < 500; trial++) {
+      string pattern, text;
+      for (size_t index = length(generator); index > 0; index--) {
+        pattern += static_cast<char>(character(generator));
+      }
+      for (size_t index = length(generator); index > 0; index--) {
+        text += static_cast<char>(character(generator));
+      }
+
+      size_t expected = GetExpectedDistance(pattern, text);
+      EditDistanceMatcher matcher(pattern);
+      REQUIRE(matcher.GetDistance(text, 100) == expected);
+      REQUIRE(matcher.GetDistance(text, 5) == std::min<size_t>(expected, 6));
+    }
+  }
+}
@@ -0,0 +1,45 @@
+#include <catch2/catch.hpp>
+#include <stdexcept>
+
+#include "gui/frame_timer.h"
+
+using passwordcontainer::gui::FrameTimer;
+
+TEST_CASE("Tests for FrameTimer") {
+  FrameTimer frame_timer(3);
+
+  SECTION("Reports 0 before any frame is recorded") {
+    REQUIRE(frame_timer.GetFrameCount() == 0);
+    REQUIRE(frame_timer.GetAverageMilliseconds() == 0);
+    REQUIRE(frame_timer.GetMaxMilliseconds() == 0);
+  }
+
+  SECTION("Averages the recorded frames") {
+    frame_timer.RecordFrame(1);
+    frame_timer.RecordFrame(5);
+    REQUIRE(frame_timer.GetFrameCount() == 2);
+    REQUIRE(frame_timer.GetAverageMilliseconds() == Approx(3));
+    REQUIRE(frame_timer.GetMaxMilliseconds() == Approx(5));
+  }
+
+  SECTION("Only keeps the most recent frames") {
+    frame_timer.RecordFrame(9);
+    frame_timer.RecordFrame(1);
+    frame_timer.RecordFrame(2);
+    frame_timer.RecordFrame(3);
+    REQUIRE(frame_timer.GetFrameCount() == 3);
+    REQUIRE(frame_timer.GetAverageMilliseconds() == Approx(2));
+    REQUIRE(frame_timer.GetMaxMilliseconds() == Approx(3));
+  }
+
+  SECTION("Times frames between StartFrame and EndFrame") {
+    frame_timer.StartFrame();
+    frame_timer.EndFrame();
+    REQUIRE(frame_timer.GetFrameCount() == 1);
+    REQUIRE(frame_timer.GetMaxMilliseconds() >= 0);
+  }
+
+  SECTION("Throws error for a frame count of 0") {
+    REQUIRE_THROWS_AS(FrameTimer(0), std::invalid_argument);
+  }
+}
@@ -0,0 +1,100 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/io/json_exporter.h"
+#include "core/io/json_importer.h"
+
+using passwordcontainer::ImportReport;
+using passwordcontainer::JsonExporter;
+using passwordcontainer::JsonImporter;
+using passwordcontainer::PasswordContainer;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+TEST_CASE("Tests for JsonExporter and JsonImporter") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Github", "Username1", "Pass\"word\\1");
+  container.AddAccount("Amazon", "Username2", "P\xC3\xA4ss2");
+
+  SECTION("Exports every account") {
+    stringstream output;
+    JsonExporter::Export(container, output);
+    REQUIRE(output.str() ==
+            "{\n"
+            "  \"version\": 1,\n"
+            "  \"accounts\": [\n"
+            "    {\n"
+            "      \"name\": \"Github\",\n"
+            "      \"username\": \"Username1\",\n"
+            "      \"password\": \"Pass\\\"word\\\\1\"\n"
+            "    },\n"
+            "    {\n"
+            "      \"name\": \"Amazon\",\n"
+            "      \"username\": \"Username2\",\n"
+            "      \"password\": \"P\xC3\xA4ss2\"\n"
+            "    }\n"
+            "  ]\n"
+            "}\n");
+  }
+
+  SECTION("Imports exported accounts") {
+    stringstream json;
+    JsonExporter::Export(container, json);
+
+    PasswordContainer imported(100, "OtherKey");
+    ImportReport report = JsonImporter::Import(json, imported);
+    REQUIRE(report.imported_count == 2);
+    REQUIRE(report.errors.empty());
+    REQUIRE(imported.GetAccount(0).password == "Pass\"word\\1");
+    REQUIRE(imported.GetAccount(1).password == "P\xC3\xA4ss2");
+  }
+
+  SECTION("Reports bad accounts with the line they start on") {
+    stringstream json(
+        "{\"accounts\": [\n"
+        "  {\"name\": \"Netflix\", \"username\": \"U3\","
+        " \"password\": \"P3\",\n"
+        "   \"notes\": {\"name\": 1}},\n"
+        "  {\"name\": \"Github\", \"username\": \"U4\","
+        " \"password\": \"P4\"},\n"
+        "  {\"name\": \"Bank\", \"username\": \"U5\"},\n"
+        "  {\"name\": \"Shop\", \"username\": \"U6\", \"password\": 6},\n"
+        "  \"Store\",\n"
+        "  {\"name\": \"Tab\\tbed\", \"username\": \"U7\","
+        " \"password\": \"P7\"}\n"
+        "], \"extra\": [1, {\"accounts\": 2}]}");
+    ImportReport report = JsonImporter::Import(json, container);
+
+    REQUIRE(report.row_count == 6);
+    REQUIRE(report.imported_count == 1);
+    REQUIRE(report.errors.size() == 5);
+    REQUIRE(report.errors[0].line_number == 4);
+    REQUIRE(report.errors[0].message == "Account already in container!");
+    REQUIRE(report.errors[1].line_number == 5);
+    REQUIRE(report.errors[2].line_number == 6);
+    REQUIRE(report.errors[2].message == "Account details must be strings!");
+    REQUIRE(report.errors[3].line_number == 7);
+    REQUIRE(report.errors[4].line_number == 8);
+    REQUIRE(container.GetAccountNames() ==
+            vector<string>({"Github", "Amazon", "Netflix"}));
+  }
+
+  SECTION("Throws exception for JSON that isn't a vault") {
+    stringstream array_json("[]");
+    REQUIRE_THROWS_AS(JsonImporter::Import(array_json, container),
+                      std::invalid_argument);
+    stringstream missing_json("{\"version\": 1}");
+    REQUIRE_THROWS_AS(JsonImporter::Import(missing_json, container),
+                      std::invalid_argument);
+    stringstream newer_json("{\"version\": 2, \"accounts\": []}");
+    REQUIRE_THROWS_AS(JsonImporter::Import(newer_json, container),
+                      std::invalid_argument);
+    stringstream bad_json("{\"accounts\": [{\"name\": \"A\", }]}");
+    REQUIRE_THROWS_AS(JsonImporter::Import(bad_json, container),
+                      std::invalid_argument);
+    REQUIRE(container.GetAccountCount() == 2);
+  }
+}
@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+
+#include "core/io/json_reader.h"
+
+using passwordcontainer::JsonHandler;
+using passwordcontainer::JsonReader;
+using std::string;
+using std::stringstream;
+
+namespace {
+
+// Writes every part it is called with to a string in a short form.
+class RecordingHandler : public JsonHandler {
+ public:
+  string parts;
+
+  void StartObject() override { parts += "{"; }
+  void EndObject() override { parts += "}"; }
+  void StartArray() override { parts += "["; }
+  void EndArray() override { parts += "]"; }
+  void Key(const string& key) override { parts += key + ":"; }
+  void String(const string& value) override { parts += "'" + value + "' "; }
+  void Number(double value) override {
+    parts += std::to_string(static_cast<long>(value)) + " ";
+  }
+  void Bool(bool value) override { parts += value ? "T " : "F "; }
+  void Null() override { parts += "N "; }
+};
+
+// Parses the passed in text with a tiny buffer and returns the parts.
+string ParseParts(const string& text) {
+  stringstream input(text);
+  JsonReader reader(input, 3);
+  RecordingHandler handler;
+  reader.Parse(handler);
+  return handler.parts;
+}
+
+}  // namespace
+
+TEST_CASE("Tests for JsonReader") {
+  SECTION("Reports every part in order") {
+    REQUIRE(ParseParts(" {\"a\": [1, -20, true, false, null], \"b\": {}} ") ==
+            "{a:[1 -20 T F N ]b:{}}");
+    REQUIRE(ParseParts("[]") == "[]");
+    REQUIRE(ParseParts("\"top\"") == "'top' ");
+  }
+
+  SECTION("Unescapes strings") {
+    REQUIRE(ParseParts("\"a\\\"b\\\\c\\/\\n\\t\"") == "'a\"b\\c/\n\t' ");
+    REQUIRE(ParseParts("\"\\u00e9\\u20AC\"") == "'\xC3\xA9\xE2\x82\xAC' ");
+    REQUIRE(ParseParts("\"\\ud83d\\ude00\"") == "'\xF0\x9F\x98\x80' ");
+  }
+
+  SECTION("Reads numbers") {
+    REQUIRE(ParseParts("[0, 12, 1.5e1, -0]") == "[0 12 15 0 ]");
+  }
+
+  SECTION("Throws exception with the line of bad JSON") {
+    stringstream input("{\n\"a\": 1,\n\"b\" 2}");
+    JsonReader reader(input);
+    RecordingHandler handler;
+    try {
+      reader.Parse(handler);
+      FAIL("No exception was thrown");
+    } catch (const std::invalid_argument& exception) {
+      REQUIRE(string(exception.what()) == "Bad JSON on line 3!");
+    }
+  }
+
+  SECTION("Throws exception for invalid JSON") {
+    const char* const bad_inputs[] = {
+        "",          "{",         "[1,]",      "{\"a\"}",  "{\"a\":1,}",
+        "[1 2]",     "01",        "+1",        "tru",      "\"open",
+        "\"\x01\"",  "\"\\x\"",   "\"\\ud83d\"", "[1]]",   "{} {}",
+        "{'a': 1}",  "[1}",       "-"};
+    for (const char* bad_input : bad_inputs) {
+      INFO(bad_input);
+      REQUIRE_THROWS_AS(ParseParts(bad_input), std::invalid_argument);
+    }
+  }
+
+  SECTION("Throws exception for values nested too deeply") {
+    string text(JsonReader::kMaxDepth + 1, '[');
+    text += string(JsonReader::kMaxDepth + 1, ']');
+    REQUIRE_THROWS_AS(ParseParts(text), std::invalid_argument);
+    REQUIRE_NOTHROW(ParseParts(string(JsonReader::kMaxDepth, '[') +
+                               string(JsonReader::kMaxDepth, ']')));
+  }
+}
@@ -0,0 +1,50 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+
+#include "core/io/json_writer.h"
+
+using passwordcontainer::JsonWriter;
+using std::string;
+using std::stringstream;
+
+TEST_CASE("Tests for JsonWriter") {
+  stringstream output;
+  JsonWriter writer(output);
+
+  SECTION("Indents nested values") {
+    writer.BeginObject();
+    writer.Key("version");
+    writer.Number(1);
+    writer.Key("list");
+    writer.BeginArray();
+    writer.String("a");
+    writer.BeginObject();
+    writer.EndObject();
+    writer.EndArray();
+    writer.EndObject();
+
+    REQUIRE(output.str() ==
+            "{\n"
+            "  \"version\": 1,\n"
+            "  \"list\": [\n"
+            "    \"a\",\n"
+            "    {}\n"
+            "  ]\n"
+            "}\n");
+  }
+
+  SECTION("Escapes quotes, backslashes, and control characters") {
+    writer.String(string("a\"b\\c\n\t\x01\x1f", 9) + "\xC3\xA9/");
+    REQUIRE(output.str() ==
+            "\"a\\\"b\\\\c\\n\\t\\u0001\\u001f\xC3\xA9/\"");
+  }
+
+  SECTION("Escapes keys") {
+    writer.BeginObject();
+    writer.Key("a\"b");
+    writer.String("");
+    writer.EndObject();
+    REQUIRE(output.str() == "{\n  \"a\\\"b\": \"\"\n}\n");
+  }
+}
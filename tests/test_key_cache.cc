@@ -0,0 +1,84 @@
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <string>
+
+#include "core/encryption/key_cache.h"
+
+using passwordcontainer::KeyCache;
+using std::string;
+
+TEST_CASE("Tests for the KeyCache") {
+  KeyCache& key_cache = KeyCache::GetInstance();
+  key_cache.Clear();
+  key_cache.SetTimeToLive(std::chrono::seconds(60));
+
+  string derived_key(KeyCache::kKeyLength, 'k');
+
+  SECTION("Finds a key that was inserted") {
+    key_cache.Insert("hashed", "salt", 1000, derived_key);
+
+    string found_key;
+    REQUIRE(key_cache.Find("hashed", "salt", 1000, found_key));
+    REQUIRE(found_key == derived_key);
+  }
+
+  SECTION("Doesn't find a key with different parameters") {
+    key_cache.Insert("hashed", "salt", 1000, derived_key);
+
+    string found_key;
+    REQUIRE_FALSE(key_cache.Find("other", "salt", 1000, found_key));
+    REQUIRE_FALSE(key_cache.Find("hashed", "other", 1000, found_key));
+    REQUIRE_FALSE(key_cache.Find("hashed", "salt", 2000, found_key));
+    REQUIRE(found_key.empty());
+  }
+
+  SECTION("Inserting the same parameters replaces the old key") {
+    key_cache.Insert("hashed", "salt", 1000, derived_key);
+    key_cache.Insert("hashed", "salt", 1000, string(KeyCache::kKeyLength, 'n'));
+
+    string found_key;
+    REQUIRE(key_cache.Find("hashed", "salt", 1000, found_key));
+    REQUIRE(found_key == string(KeyCache::kKeyLength, 'n'));
+    REQUIRE(key_cache.GetSize() == 1);
+  }
+
+  SECTION("Evicts the least recently used key when full") {
+    // Fills the cache well past its capacity
+    for (size_t iterations = 1; iterations <= 100; iterations++) {
+      key_cache.Insert("hashed", "salt", iterations, derived_key);
+    }
+
+    string found_key;
+    REQUIRE(key_cache.GetSize() < 100);
+    REQUIRE(key_cache.Find("hashed", "salt", 100, found_key));
+    REQUIRE_FALSE(key_cache.Find("hashed", "salt", 1, found_key));
+  }
+
+  SECTION("Clearing removes every key") {
+    key_cache.Insert("hashed", "salt", 1000, derived_key);
+    key_cache.Clear();
+
+    string found_key;
+    REQUIRE(key_cache.GetSize() == 0);
+    REQUIRE_FALSE(key_cache.Find("hashed", "salt", 1000, found_key));
+  }
+
+  SECTION("A time to live of 0 turns caching off") {
+    key_cache.Insert("hashed", "salt", 1000, derived_key);
+    key_cache.SetTimeToLive(std::chrono::seconds(0));
+    key_cache.Insert("other", "salt", 1000, derived_key);
+
+    string found_key;
+    REQUIRE(key_cache.GetSize() == 0);
+    REQUIRE_FALSE(key_cache.Find("hashed", "salt", 1000, found_key));
+  }
+
+  SECTION("Throws error for a key with the wrong length") {
+    REQUIRE_THROWS_AS(key_cache.Insert("hashed", "salt", 1000, "short"),
+                      std::invalid_argument);
+  }
+
+  // Puts the cache back how the rest of the tests expect it
+  key_cache.Clear();
+  key_cache.SetTimeToLive(std::chrono::seconds(15 * 60));
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <stdexcept>
+#include <string>
+
+#include "core/encryption/key_derivation.h"
+
+using passwordcontainer::keyderivation::CalibrateIterations;
+using passwordcontainer::keyderivation::ConvertFromHex;
+using passwordcontainer::keyderivation::ConvertToHex;
+using passwordcontainer::keyderivation::GenerateSalt;
+using passwordcontainer::keyderivation::HmacSha256;
+using passwordcontainer::keyderivation::kMaximumIterations;
+using passwordcontainer::keyderivation::kMinimumIterations;
+using passwordcontainer::keyderivation::Pbkdf2HmacSha256;
+using passwordcontainer::keyderivation::WipeBytes;
+using passwordcontainer::keyderivation::WipeString;
+using std::string;
+
+TEST_CASE("Tests for HmacSha256") {
+  // Test case 2 from RFC 4231
+  SECTION("Calculates the correct HMAC for a short key") {
+    REQUIRE(ConvertToHex(HmacSha256("Jefe", "what do ya want for nothing?")) ==
+            "5bdcc146bf60754e6a042426089575c7"
+            "5a003f089d2739839dec58b964ec3843");
+  }
+
+  // Test case 6 from RFC 4231
+  SECTION("Calculates the correct HMAC for a key longer than a block") {
+    REQUIRE(ConvertToHex(HmacSha256(
+                string(131, '\xaa'),
+                "Test Using Larger Than Block-Size Key - Hash Key First")) ==
+            "60e431591ee0b67f0d8a26aacbf5b77f"
+            "8e0bc6213728c5140546040f0ee37f54");
+  }
+}
+
+TEST_CASE("Tests for Pbkdf2HmacSha256") {
+  SECTION("Derives the correct key with one iteration") {
+    REQUIRE(ConvertToHex(Pbkdf2HmacSha256("password", "salt", 1, 32)) ==
+            "120fb6cffcf8b32c43e7225256c4f837"
+            "a86548c92ccc35480805987cb70be17b");
+  }
+
+  SECTION("Derives the correct key with many iterations") {
+    REQUIRE(ConvertToHex(Pbkdf2HmacSha256("password", "salt", 4096, 32)) ==
+            "c5e478d59288c841aa530db6845c4c8d"
+            "962893a001ce4e11a4963873aa98134a");
+  }
+
+  // Test vector from RFC 7914
+  SECTION("Derives the correct key when more than one block is needed") {
+    REQUIRE(ConvertToHex(Pbkdf2HmacSha256("passwd", "salt", 1, 64)) ==
+            "55ac046e56e3089fec1691c22544b605"
+            "f94185216dde0465e68b9d57c20dacbc"
+            "49ca9cccf179b645991664b39d77ef31"
+            "7c71b845b1e30bd509112041d3a19783");
+  }
+
+  SECTION("Throws error for zero iterations or key length") {
+    REQUIRE_THROWS_AS(Pbkdf2HmacSha256("password", "salt", 0, 32),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(Pbkdf2HmacSha256("password", "salt", 1, 0),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Tests for CalibrateIterations") {
+  SECTION("Never returns less than the minimum") {
+    REQUIRE(CalibrateIterations(std::chrono::milliseconds(1)) >=
+            kMinimumIterations);
+  }
+
+  SECTION("Never returns more than the maximum") {
+    REQUIRE(CalibrateIterations(std::chrono::hours(24)) == kMaximumIterations);
+  }
+
+  SECTION("Throws error for a target that isn't positive") {
+    REQUIRE_THROWS_AS(CalibrateIterations(std::chrono::milliseconds(0)),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(CalibrateIterations(std::chrono::milliseconds(-5)),
+                      std::invalid_argument);
+  }
+
+  SECTION("Returns more iterations for a longer target") {
+    REQUIRE(CalibrateIterations(std::chrono::milliseconds(400)) >
+            CalibrateIterations(std::chrono::milliseconds(4)));
+  }
+}
+
+TEST_CASE("Tests for the hex and salt helpers") {
+  SECTION("Converting to hex and back gives the same bytes") {
+    string salt = GenerateSalt(16);
+    REQUIRE(salt.size() == 16);
+    REQUIRE(ConvertFromHex(ConvertToHex(salt)) == salt);
+  }
+
+  SECTION("Throws error for invalid hex") {
+    REQUIRE_THROWS_AS(ConvertFromHex("abc"), std::invalid_argument);
+    REQUIRE_THROWS_AS(ConvertFromHex("zz"), std::invalid_argument);
+  }
+
+  SECTION("Wiping overwrites the bytes with zeros") {
+    unsigned char bytes[4] = {1, 2, 3, 4};
+    WipeBytes(bytes, sizeof(bytes));
+    REQUIRE(std::count(bytes, bytes + 4, 0) == 4);
+
+    string key = "secret key";
+    const char* characters = key.data();
+    WipeString(key);
+    REQUIRE(key.empty());
+    REQUIRE(std::count(characters, characters + 10, '\0') == 10);
+  }
+}
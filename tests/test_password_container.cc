@@ -1,12 +1,29 @@
+#include <algorithm>
 #include <catch2/catch.hpp>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 
+#include "core/audit/breached_password_checker.h"
+#include "core/encryption/cryptographer.h"
+#include "core/encryption/key_cache.h"
+#include "core/encryption/key_derivation.h"
+#include "core/encryption/sha1.h"
+#include "core/encryption/sha256.h"
 #include "core/password_container.h"
 
+using passwordcontainer::AccountBatch;
+using passwordcontainer::BreachedPasswordChecker;
+using passwordcontainer::Cryptographer;
+using passwordcontainer::KeyCache;
 using passwordcontainer::PasswordContainer;
+using passwordcontainer::PasswordStrength;
+using passwordcontainer::Sha1;
+using passwordcontainer::keyderivation::ConvertToHex;
 using std::ifstream;
+using std::string;
 using std::stringstream;
+using std::vector;
 
 bool HasValidData(const PasswordContainer& container) {
   std::vector<PasswordContainer::AccountDetails> accounts =
@@ -73,11 +90,12 @@ TEST_CASE("Tests for overloaded >> operator") {
 TEST_CASE("Tests for overloaded << operator") {
   PasswordContainer container(100, "CorrectKey");
 
-  SECTION("Returns empty string when there is no data in the container") {
+  SECTION("Only writes the header when there is no data in the container") {
     stringstream stream;
     stream << container;
 
-    REQUIRE(stream.str() == "");
+    REQUIRE(stream.str().find("PWC1 check=") == 0);
+    REQUIRE(stream.str().find('\n') == stream.str().size() - 1);
   }
 
   ifstream file("../../../tests/resources/Data.pwords");
@@ -136,6 +154,417 @@ TEST_CASE("Tests for overloaded << operator") {
   }
 }
 
+TEST_CASE("Tests for the key check header") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Account1", "Username1", "Password1");
+  container.AddAccount("Account2", "Username2", "Password2");
+  container.AddAccount("Account3", "Username3", "Password3");
+
+  stringstream stream;
+  stream << container;
+
+  SECTION("Loads data with the correct key") {
+    PasswordContainer loaded(100, "CorrectKey");
+    stream >> loaded;
+
+    REQUIRE(HasValidData(loaded));
+  }
+
+  SECTION("Rejects the wrong key before decrypting") {
+    PasswordContainer loaded(100, "WrongKey");
+
+    REQUIRE_THROWS_WITH(stream >> loaded, "Wrong key passed in!");
+    REQUIRE(loaded.GetAccounts().empty());
+  }
+
+  SECTION("Rejects the wrong offset before decrypting") {
+    PasswordContainer loaded(200, "CorrectKey");
+
+    REQUIRE_THROWS_WITH(stream >> loaded, "Wrong key passed in!");
+  }
+
+  SECTION("Loads data without a header") {
+    // Data from before the header was encrypted with the hash of the key
+    Cryptographer legacy_cryptographer(100, sha256("CorrectKey"));
+    stringstream legacy_stream(legacy_cryptographer.EncryptString(
+        "Account1\tUsername1\tPassword1\n"
+        "Account2\tUsername2\tPassword2\n"
+        "Account3\tUsername3\tPassword3"));
+    PasswordContainer loaded(100, "CorrectKey");
+    legacy_stream >> loaded;
+
+    REQUIRE(HasValidData(loaded));
+  }
+
+  SECTION("Throws error for data with an empty detail") {
+    Cryptographer legacy_cryptographer(100, sha256("CorrectKey"));
+    stringstream legacy_stream(legacy_cryptographer.EncryptString(
+        "\tUsername1\tPassword1\n"
+        "Account2\tUsername2\tPassword2"));
+    PasswordContainer loaded(100, "CorrectKey");
+
+    REQUIRE_THROWS_WITH(legacy_stream >> loaded, "Bad data passed in!");
+  }
+
+  SECTION("Throws error for data with a repeated account name") {
+    Cryptographer legacy_cryptographer(100, sha256("CorrectKey"));
+    stringstream legacy_stream(legacy_cryptographer.EncryptString(
+        "Account1\tUsername1\tPassword1\n"
+        "Account1\tUsername2\tPassword2"));
+    PasswordContainer loaded(100, "CorrectKey");
+
+    REQUIRE_THROWS_WITH(legacy_stream >> loaded, "Bad data passed in!");
+  }
+
+  SECTION("Throws error for a malformed header") {
+    stringstream bad_stream("PWC1 check\n123");
+    PasswordContainer loaded(100, "CorrectKey");
+
+    REQUIRE_THROWS_AS(bad_stream >> loaded, std::invalid_argument);
+  }
+}
+
+TEST_CASE("Tests for key stretching") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Account1", "Username1", "Password1");
+  container.AddAccount("Account2", "Username2", "Password2");
+  container.AddAccount("Account3", "Username3", "Password3");
+
+  SECTION("Writes the iterations and salt into the header") {
+    stringstream stream;
+    stream << container;
+
+    string header = stream.str().substr(0, stream.str().find('\n'));
+    REQUIRE(header.find(" iterations=100000 ") != string::npos);
+    REQUIRE(header.find(" salt=") != string::npos);
+  }
+
+  SECTION("Loads the iterations that the data was saved with") {
+    container.SetKdfIterations(2000);
+    stringstream stream;
+    stream << container;
+
+    PasswordContainer loaded(100, "CorrectKey");
+    stream >> loaded;
+
+    REQUIRE(loaded.GetKdfIterations() == 2000);
+    REQUIRE(loaded.GetCryptographerKey() == container.GetCryptographerKey());
+    REQUIRE(HasValidData(loaded));
+  }
+
+  SECTION("Stretches the key of data that was saved without stretching") {
+    Cryptographer unstretched_cryptographer(100, sha256("CorrectKey"));
+    stringstream unstretched_stream(
+        "PWC1 check=" + unstretched_cryptographer.CalculateKeyCheck() + "\n" +
+        unstretched_cryptographer.EncryptString(
+            "Account1\tUsername1\tPassword1\n"
+            "Account2\tUsername2\tPassword2\n"
+            "Account3\tUsername3\tPassword3"));
+    PasswordContainer loaded(100, "CorrectKey");
+    loaded.SetKdfIterations(2000);
+    unstretched_stream >> loaded;
+
+    REQUIRE(HasValidData(loaded));
+    REQUIRE(loaded.GetKdfIterations() == 100000);
+  }
+
+  SECTION("Keeps its key settings when the key check fails") {
+    container.SetKdfIterations(2000);
+    stringstream stream;
+    stream << container;
+
+    PasswordContainer loaded(100, "WrongKey");
+    string cipher_key = loaded.GetCryptographerKey();
+    REQUIRE_THROWS_WITH(stream >> loaded, "Wrong key passed in!");
+
+    REQUIRE(loaded.GetKdfIterations() == 100000);
+    REQUIRE(loaded.GetCryptographerKey() == cipher_key);
+  }
+
+  SECTION("Throws error for iterations out of range in the header") {
+    string header_end = " salt=00\n";
+    PasswordContainer loaded(100, "CorrectKey");
+
+    stringstream no_iterations("PWC1 check=00 iterations=0" + header_end);
+    REQUIRE_THROWS_WITH(no_iterations >> loaded, "Bad header passed in!");
+
+    stringstream too_many_iterations(
+        "PWC1 check=00 iterations=18446744073709551615" + header_end);
+    REQUIRE_THROWS_WITH(too_many_iterations >> loaded,
+                        "Bad header passed in!");
+  }
+
+  SECTION("Uses a different cipher key for the same key with a new salt") {
+    PasswordContainer other(100, "CorrectKey");
+    REQUIRE(other.GetCryptographerKey() != container.GetCryptographerKey());
+  }
+
+  SECTION("Reopening the data with the same key reuses the derived key") {
+    stringstream stream;
+    stream << container;
+    KeyCache::GetInstance().Clear();
+
+    PasswordContainer loaded(100, "CorrectKey");
+    stream >> loaded;
+    REQUIRE(KeyCache::GetInstance().GetSize() == 1);
+
+    stream.clear();
+    stream.seekg(0);
+    PasswordContainer reloaded(100, "CorrectKey");
+    stream >> reloaded;
+    REQUIRE(KeyCache::GetInstance().GetSize() == 1);
+    REQUIRE(HasValidData(reloaded));
+  }
+
+  SECTION("Throws error for too few iterations") {
+    REQUIRE_THROWS_AS(container.SetKdfIterations(999), std::invalid_argument);
+  }
+
+  SECTION("Throws error for too many iterations") {
+    REQUIRE_THROWS_AS(container.SetKdfIterations(10000001),
+                      std::invalid_argument);
+  }
+
+  SECTION("Calibrating picks a valid number of iterations") {
+    size_t iterations =
+        container.CalibrateKdfIterations(std::chrono::milliseconds(10));
+    REQUIRE(iterations >= 1000);
+    REQUIRE(iterations <= 10000000);
+    REQUIRE(container.GetKdfIterations() == iterations);
+  }
+}
+
+TEST_CASE("Tests for RekeyFile") {
+  const string file_path = "../../../tests/resources/Rekey.pwords";
+  PasswordContainer container(100, "CorrectKey");
+  container.SetKdfIterations(1000);
+  container.AddAccount("Account1", "Username1", "Password1");
+  container.AddAccount("Account2", "Username2", "Password2");
+  container.AddAccount("Account3", "Username3", "Password3");
+
+  std::ofstream file_output(file_path);
+  file_output << container;
+  file_output.close();
+
+  SECTION("The rekeyed file can only be loaded with the new key") {
+    size_t last_length = 0;
+    container.RekeyFile(file_path, "NewKey",
+                        [&](size_t rekeyed_length, size_t total_length) {
+                          REQUIRE(rekeyed_length <= total_length);
+                          last_length = rekeyed_length;
+                        });
+    REQUIRE(last_length > 0);
+
+    PasswordContainer loaded(100, "NewKey");
+    ifstream file_input(file_path);
+    file_input >> loaded;
+    REQUIRE(HasValidData(loaded));
+    REQUIRE(loaded.GetKdfIterations() == 1000);
+
+    PasswordContainer wrong_key(100, "CorrectKey");
+    ifstream other_input(file_path);
+    REQUIRE_THROWS_AS(other_input >> wrong_key, std::invalid_argument);
+  }
+
+  SECTION("Keeps the username table of a pooled file") {
+    container.SetUsernamePooling(true);
+    std::ofstream pooled_output(file_path);
+    pooled_output << container;
+    pooled_output.close();
+
+    container.RekeyFile(file_path, "NewKey", nullptr);
+
+    PasswordContainer loaded(100, "NewKey");
+    ifstream file_input(file_path);
+    file_input >> loaded;
+    REQUIRE(HasValidData(loaded));
+    REQUIRE(loaded.IsUsernamePoolingEnabled());
+  }
+
+  SECTION("The container uses the new key after rekeying") {
+    container.RekeyFile(file_path, "NewKey", nullptr);
+
+    PasswordContainer loaded(100, "NewKey");
+    ifstream file_input(file_path);
+    file_input >> loaded;
+    REQUIRE(loaded.GetCryptographerKey() == container.GetCryptographerKey());
+  }
+
+  SECTION("Leaves the file unchanged for a wrong key") {
+    PasswordContainer wrong_key(100, "WrongKey");
+    REQUIRE_THROWS_AS(wrong_key.RekeyFile(file_path, "NewKey", nullptr),
+                      std::invalid_argument);
+
+    PasswordContainer loaded(100, "CorrectKey");
+    ifstream file_input(file_path);
+    file_input >> loaded;
+    REQUIRE(HasValidData(loaded));
+  }
+
+  SECTION("Throws error for an empty key or a missing file") {
+    REQUIRE_THROWS_AS(container.RekeyFile(file_path, "", nullptr),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        container.RekeyFile("../../../tests/resources/Missing.pwords",
+                            "NewKey", nullptr),
+        std::invalid_argument);
+  }
+
+  std::remove(file_path.c_str());
+}
+
+TEST_CASE("Tests for LoadFile") {
+  const string file_path = "../../../tests/resources/Load.pwords";
+  PasswordContainer saved(100, "CorrectKey");
+  saved.SetKdfIterations(1000);
+  saved.AddAccount("Account1", "Username1", "Password1");
+  saved.AddAccount("Account2", "Username2", "Password2");
+  saved.AddAccount("Account3", "Username3", "Password3");
+
+  std::ofstream file_output(file_path);
+  file_output << saved;
+  file_output.close();
+
+  SECTION("Loads the same accounts as the >> operator") {
+    PasswordContainer container(100, "CorrectKey");
+    size_t last_length = 0;
+    size_t file_length = 0;
+    REQUIRE(container.LoadFile(file_path,
+                               [&](size_t read_length, size_t total_length) {
+                                 last_length = read_length;
+                                 file_length = total_length;
+                                 return true;
+                               }));
+
+    REQUIRE(HasValidData(container));
+    REQUIRE(container.GetKdfIterations() == 1000);
+    REQUIRE(last_length == file_length);
+    REQUIRE(file_length > 0);
+  }
+
+  SECTION("Adds no accounts when stopped") {
+    PasswordContainer container(100, "CorrectKey");
+    REQUIRE_FALSE(container.LoadFile(
+        file_path, [](size_t, size_t) { return false; }));
+    REQUIRE(container.GetAccountCount() == 0);
+  }
+
+  SECTION("Throws error for a wrong key or a missing file") {
+    PasswordContainer wrong_key(100, "WrongKey");
+    REQUIRE_THROWS_AS(wrong_key.LoadFile(file_path, nullptr),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        wrong_key.LoadFile("../../../tests/resources/Missing.pwords", nullptr),
+        std::invalid_argument);
+  }
+
+  std::remove(file_path.c_str());
+}
+
+TEST_CASE("Tests for CreateSnapshot") {
+  PasswordContainer container(100, "CorrectKey");
+  container.SetKdfIterations(1000);
+  container.AddAccount("Account1", "Username1", "Password1");
+  container.AddAccount("Account2", "Username2", "Password2");
+  container.AddAccount("Account3", "Username3", "Password3");
+
+  SECTION("Writes the same data as the container") {
+    PasswordContainer::Snapshot snapshot = container.CreateSnapshot();
+    stringstream snapshot_output;
+    snapshot_output << snapshot;
+
+    PasswordContainer loaded(100, "CorrectKey");
+    snapshot_output >> loaded;
+    REQUIRE(HasValidData(loaded));
+    REQUIRE(loaded.GetKdfIterations() == 1000);
+  }
+
+  SECTION("Isn't changed by later changes to the container") {
+    container.SetUsernamePooling(true);
+    PasswordContainer::Snapshot snapshot = container.CreateSnapshot();
+    container.DeleteAccount("Account1");
+    container.SetCryptographerKey("NewKey");
+
+    stringstream snapshot_output;
+    snapshot_output << snapshot;
+    PasswordContainer loaded(100, "CorrectKey");
+    snapshot_output >> loaded;
+    REQUIRE(HasValidData(loaded));
+    REQUIRE(loaded.IsUsernamePoolingEnabled());
+  }
+}
+
+TEST_CASE("Tests for swap") {
+  PasswordContainer first(100, "FirstKey");
+  first.AddAccount("Account1", "Username1", "Password1");
+  PasswordContainer second(150, "SecondKey");
+  second.AddAccount("Account2", "Username2", "Password2");
+  second.AddAccount("Account3", "Username3", "Password3");
+
+  string first_key = first.GetCryptographerKey();
+  string second_key = second.GetCryptographerKey();
+  size_t first_revision = first.GetRevision();
+  size_t second_revision = second.GetRevision();
+  swap(first, second);
+
+  SECTION("Swaps the accounts") {
+    REQUIRE(first.GetAccountNames() ==
+            std::vector<string>({"Account2", "Account3"}));
+    REQUIRE(second.GetAccountNames() == std::vector<string>({"Account1"}));
+    size_t index = first.FindAccount("Account3");
+    REQUIRE(first.GetAccount(index).password == "Password3");
+    REQUIRE(first.SearchAccounts("Account").size() == 2);
+  }
+
+  SECTION("Swaps the keys") {
+    REQUIRE(first.GetCryptographerKey() == second_key);
+    REQUIRE(second.GetCryptographerKey() == first_key);
+
+    stringstream saved;
+    saved << first;
+    PasswordContainer loaded(150, "SecondKey");
+    saved >> loaded;
+    REQUIRE(loaded.GetAccountCount() == 2);
+  }
+
+  SECTION("Both revisions go up") {
+    REQUIRE(first.GetRevision() > std::max(first_revision, second_revision));
+    REQUIRE(second.GetRevision() > std::max(first_revision, second_revision));
+  }
+}
+
+TEST_CASE("Tests for password storage") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Account1", "Username1", "Password1");
+  container.AddAccount("Account2", "Username2", "Password2");
+  container.AddAccount("Account3", "Username3", "Password3");
+
+  SECTION("Keeps every password after the old passwords are compacted") {
+    // Leaves enough changed passwords behind for the arena to be compacted
+    for (size_t count = 0; count < 10000; count++) {
+      container.ModifyAccount("Account1", "Username1",
+                              "Changed password " + std::to_string(count));
+    }
+    container.DeleteAccount("Account2");
+    container.AddAccount("Account4", "Username4", "Password4");
+
+    REQUIRE(container.GetAccount(0).password == "Changed password 9999");
+    REQUIRE(container.GetAccount(1).password == "Password3");
+    REQUIRE(container.GetAccount(2).password == "Password4");
+  }
+
+  SECTION("Writes the passwords from the arena") {
+    container.ModifyAccount("Account2", "Username2", "NewPassword2");
+    stringstream stream;
+    stream << container;
+
+    PasswordContainer loaded(100, "CorrectKey");
+    stream >> loaded;
+    REQUIRE(loaded.GetAccount(1).password == "NewPassword2");
+    REQUIRE(loaded.GetAccount(2).password == "Password3");
+  }
+}
+
 TEST_CASE("Tests for SetCryptographerKey") {
   PasswordContainer container(100, "CorrectKey");
   ifstream file("../../../tests/resources/Data.pwords");
@@ -250,6 +679,117 @@ TEST_CASE("Tests for AddAccount") {
   }
 }
 
+TEST_CASE("Tests for AddAccounts") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Github", "Username1", "Password1");
+
+  PasswordContainer::AccountDetails amazon = {"Amazon", "Username1", "Pass2"};
+  PasswordContainer::AccountDetails netflix = {"Netflix", "Username3", "Pass3"};
+
+  SECTION("Adds every account after the current ones") {
+    container.AddAccounts({amazon, netflix});
+    REQUIRE(container.GetAccountNames() ==
+            vector<string>({"Github", "Amazon", "Netflix"}));
+    REQUIRE(container.GetAccount(2).password == "Pass3");
+    REQUIRE(container.GetAccountsForUsername("Username1") ==
+            vector<string>({"Amazon", "Github"}));
+    REQUIRE(container.SearchAccounts("flix") == vector<string>({"Netflix"}));
+    REQUIRE(container.ScorePasswords().size() == 3);
+  }
+
+  SECTION("Adds nothing when an account is invalid") {
+    PasswordContainer::AccountDetails duplicate = {"Github", "User", "Pass"};
+    PasswordContainer::AccountDetails tabbed = {"Tab\tbed", "User", "Pass"};
+    REQUIRE_THROWS_AS(container.AddAccounts({amazon, duplicate}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(container.AddAccounts({amazon, amazon}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(container.AddAccounts({amazon, tabbed}),
+                      std::invalid_argument);
+    REQUIRE(container.GetAccountCount() == 1);
+  }
+
+  SECTION("Details with tabs or line breaks can't be added or modified") {
+    REQUIRE_THROWS_AS(container.AddAccount("Amazon", "User\tname", "Pass"),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(container.AddAccount("Amazon", "Username", "Pa\nss"),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(container.ModifyAccount("Github", "Username", "Pa\rss"),
+                      std::invalid_argument);
+    REQUIRE(container.GetAccount(0).password == "Password1");
+  }
+}
+
+TEST_CASE("Tests for CommitBatch") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Github", "Username1", "Password1");
+  container.AddAccount("Amazon", "Username1", "Password2");
+  container.AddAccount("Netflix", "Username2", "Password3");
+  AccountBatch batch;
+
+  SECTION("Applies every change in the order it was staged") {
+    batch.DeleteAccount("Github");
+    batch.AddAccount("Spotify", "Username2", "Password4");
+    batch.ModifyAccount("Spotify", "Username3", "Password5");
+    batch.ModifyAccount("Netflix", "Username1", "Password1");
+    batch.AddAccount("Hulu", "Username1", "Password6");
+    batch.DeleteAccount("Hulu");
+    container.CommitBatch(batch);
+
+    REQUIRE(container.GetAccountNames() ==
+            vector<string>({"Amazon", "Netflix", "Spotify"}));
+    REQUIRE(container.GetAccount(1).password == "Password1");
+    REQUIRE(container.GetAccount(2).username == "Username3");
+    REQUIRE(container.GetAccountsForUsername("Username1") ==
+            vector<string>({"Amazon", "Netflix"}));
+    REQUIRE(container.GetAccountsForUsername("Username2").empty());
+    REQUIRE(container.SearchAccounts("git").empty());
+    REQUIRE(container.SearchAccounts("ify") == vector<string>({"Spotify"}));
+    REQUIRE(container.ScorePasswords().size() == 3);
+  }
+
+  SECTION("Deleted names can be added again in the same batch") {
+    batch.DeleteAccount("Amazon");
+    batch.AddAccount("Amazon", "Username3", "Password4");
+    container.CommitBatch(batch);
+
+    REQUIRE(container.GetAccountNames() ==
+            vector<string>({"Github", "Netflix", "Amazon"}));
+    REQUIRE(container.GetAccount(2).password == "Password4");
+  }
+
+  SECTION("Keeps the reuse index up to date once it is built") {
+    REQUIRE(container.FindReusedPasswords().empty());
+    batch.DeleteAccount("Amazon");
+    batch.ModifyAccount("Netflix", "Username2", "Password1");
+    container.CommitBatch(batch);
+
+    REQUIRE(container.FindReusedPasswords() ==
+            vector<vector<string>>({{"Github", "Netflix"}}));
+  }
+
+  SECTION("Changes nothing when any change is invalid") {
+    batch.DeleteAccount("Github");
+    batch.ModifyAccount("Github", "Username3", "Password4");
+    REQUIRE_THROWS_AS(container.CommitBatch(batch), std::invalid_argument);
+
+    batch.Clear();
+    batch.AddAccount("Spotify", "Username3", "Password4");
+    batch.AddAccount("Amazon", "Username3", "Password4");
+    REQUIRE_THROWS_AS(container.CommitBatch(batch), std::invalid_argument);
+
+    batch.Clear();
+    batch.DeleteAccount("Amazon");
+    batch.AddAccount("Spotify", "User\tname", "Password4");
+    REQUIRE_THROWS_AS(container.CommitBatch(batch), std::invalid_argument);
+
+    REQUIRE(container.GetAccountNames() ==
+            vector<string>({"Github", "Amazon", "Netflix"}));
+    REQUIRE(container.GetAccountsForUsername("Username1") ==
+            vector<string>({"Amazon", "Github"}));
+  }
+}
+
 TEST_CASE("Tests for DeleteAccount") {
   PasswordContainer container(100, "CorrectKey");
 
@@ -364,14 +904,432 @@ TEST_CASE("Tests for HasAccount") {
   }
 }
 
+TEST_CASE("Tests for the account columns") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Account1", "Username1", "Password1");
+  container.AddAccount("Account2", "Username2", "Password2");
+  container.AddAccount("Account3", "Username3", "Password3");
+
+  SECTION("GetAccountNames returns only the names in order") {
+    REQUIRE(container.GetAccountNames() ==
+            std::vector<string>({"Account1", "Account2", "Account3"}));
+    REQUIRE(container.GetAccountCount() == 3);
+  }
+
+  SECTION("GetAccount returns every detail of the account at an index") {
+    PasswordContainer::AccountDetails account = container.GetAccount(1);
+    REQUIRE(account.account_name == "Account2");
+    REQUIRE(account.username == "Username2");
+    REQUIRE(account.password == "Password2");
+  }
+
+  SECTION("Columns stay lined up after deleting and modifying") {
+    container.DeleteAccount("Account1");
+    container.ModifyAccount("Account3", "NewUsername", "NewPassword");
+
+    REQUIRE(container.GetAccountNames() ==
+            std::vector<string>({"Account2", "Account3"}));
+    REQUIRE(container.GetAccount(0).username == "Username2");
+    REQUIRE(container.GetAccount(1).username == "NewUsername");
+    REQUIRE(container.GetAccount(1).password == "NewPassword");
+  }
+
+  SECTION("Deleting many accounts keeps the rest in order") {
+    for (size_t index = 4; index <= 100; index++) {
+      container.AddAccount("Account" + std::to_string(index), "Username1",
+                           "Password" + std::to_string(index));
+    }
+    for (size_t index = 1; index <= 100; index += 2) {
+      container.DeleteAccount("Account" + std::to_string(index));
+    }
+
+    REQUIRE(container.GetAccountCount() == 50);
+    REQUIRE_FALSE(container.HasAccount("Account99"));
+    REQUIRE(container.FindAccount("Account100") == 49);
+    REQUIRE(container.GetAccountNames()[1] == "Account4");
+    REQUIRE(container.GetAccount(49).password == "Password100");
+    REQUIRE(container.SearchAccounts("account9") ==
+            vector<string>({"Account90", "Account92", "Account94",
+                            "Account96", "Account98"}));
+    REQUIRE(container.GetAccountsForUsername("Username1").size() == 49);
+  }
+
+  SECTION("Deleted names can be added again") {
+    container.DeleteAccount("Account2");
+    container.AddAccount("Account2", "NewUsername", "NewPassword");
+    container.DeleteAccount("Account1");
+
+    REQUIRE(container.SearchAccounts("account2") ==
+            vector<string>({"Account2"}));
+    REQUIRE(container.GetAccountNames() ==
+            std::vector<string>({"Account3", "Account2"}));
+    REQUIRE(container.GetAccount(1).username == "NewUsername");
+  }
+
+  SECTION("Deleting closes the gap before anything is read") {
+    const vector<string>& account_names = container.GetAccountNames();
+    container.DeleteAccount("Account2");
+
+    REQUIRE(account_names == vector<string>({"Account1", "Account3"}));
+    REQUIRE(container.GetAccountIndex(container.FindAccountHandle(
+                "Account3")) == 1);
+    REQUIRE(&container.GetAccountNames() == &account_names);
+  }
+
+  SECTION("FindAccount returns kNoAccountIndex for a missing account") {
+    REQUIRE(container.FindAccount("Account3") == 2);
+    REQUIRE(container.FindAccount("RandomAccount") ==
+            PasswordContainer::kNoAccountIndex);
+  }
+
+  SECTION("Throws error for an index without an account") {
+    REQUIRE_THROWS_AS(container.GetAccount(3), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Tests for account handles") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Account1", "Username1", "Password1");
+  container.AddAccount("Account2", "Username2", "Password2");
+  container.AddAccount("Account3", "Username3", "Password3");
+  PasswordContainer::AccountHandle handle = container.GetAccountHandle(2);
+
+  SECTION("Handles keep referring to their account when others are deleted") {
+    container.DeleteAccount("Account1");
+    container.AddAccount("Account4", "Username4", "Password4");
+
+    REQUIRE(container.IsValidHandle(handle));
+    REQUIRE(container.GetAccountName(handle) == "Account3");
+    REQUIRE(container.GetAccount(handle).password == "Password3");
+    REQUIRE(container.GetAccountIndex(handle) == 1);
+    REQUIRE(container.FindAccountHandle("Account3") == handle);
+  }
+
+  SECTION("Handles to deleted accounts are detected") {
+    container.DeleteAccount(handle);
+    container.AddAccount("Account4", "Username4", "Password4");
+
+    REQUIRE_FALSE(container.IsValidHandle(handle));
+    REQUIRE(container.FindAccountHandle("Account4") != handle);
+    REQUIRE_THROWS_AS(container.GetAccount(handle), std::invalid_argument);
+    REQUIRE_THROWS_AS(container.DeleteAccount(handle), std::invalid_argument);
+    REQUIRE(container.GetAccountNames() ==
+            vector<string>({"Account1", "Account2", "Account4"}));
+  }
+
+  SECTION("Accounts can be modified through handles") {
+    container.ModifyAccount(handle, "NewUsername", "password");
+
+    REQUIRE(container.GetAccount(2).username == "NewUsername");
+    REQUIRE(container.GetPasswordStrength(handle).rating ==
+            PasswordStrength::kVeryWeak);
+  }
+
+  SECTION("Default handles and missing names don't refer to accounts") {
+    REQUIRE_FALSE(container.IsValidHandle(PasswordContainer::AccountHandle()));
+    REQUIRE_FALSE(
+        container.IsValidHandle(container.FindAccountHandle("Account5")));
+    REQUIRE_THROWS_AS(container.GetAccountHandle(3), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Tests for username pooling") {
+  PasswordContainer container(100, "CorrectKey");
+  container.SetKdfIterations(1000);
+  container.AddAccount("Account1", "shared@example.com", "Password1");
+  container.AddAccount("Account2", "other@example.com", "Password2");
+  container.AddAccount("Account3", "shared@example.com", "Password3");
+
+  SECTION("Only stores every distinct username once") {
+    REQUIRE(container.GetUniqueUsernameCount() == 2);
+
+    container.ModifyAccount("Account2", "shared@example.com", "Password2");
+    REQUIRE(container.GetUniqueUsernameCount() == 1);
+
+    container.DeleteAccount("Account1");
+    container.DeleteAccount("Account2");
+    container.DeleteAccount("Account3");
+    REQUIRE(container.GetUniqueUsernameCount() == 0);
+  }
+
+  SECTION("Pooled data is loaded back with the same accounts") {
+    container.SetUsernamePooling(true);
+    stringstream stream;
+    stream << container;
+
+    string header = stream.str().substr(0, stream.str().find('\n'));
+    REQUIRE(header.find(" layout=pooled") != string::npos);
+
+    PasswordContainer loaded(100, "CorrectKey");
+    stream >> loaded;
+    REQUIRE(loaded.IsUsernamePoolingEnabled());
+    REQUIRE(loaded.GetUniqueUsernameCount() == 2);
+    REQUIRE(loaded.GetAccount(0).username == "shared@example.com");
+    REQUIRE(loaded.GetAccount(1).username == "other@example.com");
+    REQUIRE(loaded.GetAccount(2).username == "shared@example.com");
+    REQUIRE(loaded.GetAccount(2).password == "Password3");
+  }
+
+  SECTION("Pooled data is smaller when usernames are shared") {
+    for (size_t index = 4; index < 50; index++) {
+      container.AddAccount("Account" + std::to_string(index),
+                           "shared@example.com", "Password");
+    }
+
+    stringstream plain_stream;
+    plain_stream << container;
+    container.SetUsernamePooling(true);
+    stringstream pooled_stream;
+    pooled_stream << container;
+
+    REQUIRE(pooled_stream.str().size() < plain_stream.str().size());
+  }
+
+  SECTION("Data without a username table turns pooling off") {
+    container.SetUsernamePooling(false);
+    stringstream stream;
+    stream << container;
+
+    PasswordContainer loaded(100, "CorrectKey");
+    loaded.SetUsernamePooling(true);
+    stream >> loaded;
+    REQUIRE_FALSE(loaded.IsUsernamePoolingEnabled());
+    REQUIRE(loaded.GetAccount(2).username == "shared@example.com");
+  }
+}
+
+TEST_CASE("Tests for SearchAccounts") {
+  PasswordContainer container(100, "CorrectKey");
+  container.SetKdfIterations(1000);
+  container.AddAccount("Gmail", "Username1", "Password1");
+  container.AddAccount("Github", "Username2", "Password2");
+  container.AddAccount("My Gmail", "Username3", "Password3");
+
+  SECTION("Lists prefix matches before other matches") {
+    REQUIRE(container.SearchAccounts("gmail") ==
+            vector<string>({"Gmail", "My Gmail"}));
+    REQUIRE(container.SearchAccounts("G") ==
+            vector<string>({"Github", "Gmail", "My Gmail"}));
+  }
+
+  SECTION("Limits the number of results") {
+    REQUIRE(container.SearchAccounts("g", 1) == vector<string>({"Github"}));
+  }
+
+  SECTION("Follows added and deleted accounts") {
+    container.AddAccount("Gmail Work", "Username4", "Password4");
+    container.DeleteAccount("Gmail");
+    REQUIRE(container.SearchAccounts("gmail") ==
+            vector<string>({"Gmail Work", "My Gmail"}));
+  }
+
+  SECTION("Finds loaded accounts") {
+    stringstream stream;
+    stream << container;
+
+    PasswordContainer loaded(100, "CorrectKey");
+    stream >> loaded;
+    REQUIRE(loaded.SearchAccounts("hub") == vector<string>({"Github"}));
+  }
+}
+
+TEST_CASE("Tests for FindClosestAccounts") {
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Gmail", "Username1", "Password1");
+  container.AddAccount("Github", "Username2", "Password2");
+  container.AddAccount("Amazon", "Username3", "Password3");
+
+  SECTION("Suggests names for mistyped names") {
+    REQUIRE(container.FindClosestAccounts("gmial", 3, 2) ==
+            vector<string>({"Gmail"}));
+    REQUIRE(container.FindClosestAccounts("Amazn", 3, 2) ==
+            vector<string>({"Amazon"}));
+  }
+
+  SECTION("Doesn't suggest names that are too different") {
+    REQUIRE(container.FindClosestAccounts("Netflix", 3, 2).empty());
+  }
+}
+
+TEST_CASE("Tests for GetAccountsForUsername") {
+  PasswordContainer container(100, "CorrectKey");
+  container.SetKdfIterations(1000);
+  container.AddAccount("Github", "shared@example.com", "Password1");
+  container.AddAccount("Amazon", "shared@example.com", "Password2");
+  container.AddAccount("Netflix", "other@example.com", "Password3");
+
+  SECTION("Lists the accounts that use a username") {
+    REQUIRE(container.GetAccountsForUsername("shared@example.com") ==
+            vector<string>({"Amazon", "Github"}));
+    REQUIRE(container.GetAccountsForUsername("missing@example.com").empty());
+  }
+
+  SECTION("Follows modified and deleted accounts") {
+    container.ModifyAccount("Netflix", "shared@example.com", "Password3");
+    container.DeleteAccount("Github");
+    REQUIRE(container.GetAccountsForUsername("shared@example.com") ==
+            vector<string>({"Amazon", "Netflix"}));
+    REQUIRE(container.GetAccountsForUsername("other@example.com").empty());
+  }
+
+  SECTION("Keeps accounts whose username doesn't change") {
+    container.ModifyAccount("Github", "shared@example.com", "Password4");
+    REQUIRE(container.GetAccountsForUsername("shared@example.com") ==
+            vector<string>({"Amazon", "Github"}));
+
+    AccountBatch batch;
+    batch.ModifyAccount("Amazon", "shared@example.com", "Password5");
+    container.CommitBatch(batch);
+    REQUIRE(container.GetAccountsForUsername("shared@example.com") ==
+            vector<string>({"Amazon", "Github"}));
+  }
+
+  SECTION("Follows loaded accounts") {
+    container.SetUsernamePooling(true);
+    stringstream stream;
+    stream << container;
+
+    PasswordContainer loaded(100, "CorrectKey");
+    stream >> loaded;
+    REQUIRE(loaded.GetAccountsForUsername("other@example.com") ==
+            vector<string>({"Netflix"}));
+  }
+}
+
+TEST_CASE("Tests for FindReusedPasswords") {
+  PasswordContainer container(100, "CorrectKey");
+  container.SetKdfIterations(1000);
+  container.AddAccount("Github", "Username1", "Shared1");
+  container.AddAccount("Amazon", "Username2", "Shared1");
+  container.AddAccount("Netflix", "Username3", "Unique1");
+
+  SECTION("Finds accounts that share a password") {
+    REQUIRE(container.FindReusedPasswords() ==
+            vector<vector<string>>({{"Amazon", "Github"}}));
+  }
+
+  SECTION("Follows accounts that change after the first audit") {
+    container.FindReusedPasswords();
+    container.ModifyAccount("Netflix", "Username3", "Shared1");
+    container.AddAccount("Gmail", "Username4", "Unique1");
+    container.AddAccount("Bank", "Username5", "Unique1");
+    container.DeleteAccount("Github");
+    REQUIRE(container.FindReusedPasswords() ==
+            vector<vector<string>>({{"Amazon", "Netflix"}, {"Bank", "Gmail"}}));
+  }
+
+  SECTION("Finds loaded accounts") {
+    container.FindReusedPasswords();
+    stringstream stream;
+    stream << container;
+
+    PasswordContainer loaded(100, "CorrectKey");
+    loaded.FindReusedPasswords();
+    stream >> loaded;
+    REQUIRE(loaded.FindReusedPasswords() ==
+            vector<vector<string>>({{"Amazon", "Github"}}));
+  }
+}
+
+TEST_CASE("Tests for FindBreachedAccounts") {
+  const string corpus_path = "../../../tests/resources/Breaches.txt";
+  {
+    vector<string> hashes = {ConvertToHex(Sha1("password")),
+                             ConvertToHex(Sha1("123456"))};
+    std::sort(hashes.begin(), hashes.end());
+    std::ofstream file(corpus_path, std::ios::binary);
+    file << hashes[0] << ":10\n" << hashes[1] << ":20\n";
+  }
+
+  PasswordContainer container(100, "CorrectKey");
+  container.AddAccount("Github", "Username1", "password");
+  container.AddAccount("Amazon", "Username2", "Xq8!vR2#pL");
+  container.AddAccount("Netflix", "Username3", "123456");
+
+  SECTION("Finds the accounts with breached passwords") {
+    BreachedPasswordChecker checker(corpus_path);
+    REQUIRE(container.FindBreachedAccounts(checker) ==
+            vector<string>({"Github", "Netflix"}));
+  }
+
+  SECTION("Finds the same accounts on many threads") {
+    for (size_t index = 0; index < 1000; index++) {
+      container.AddAccount("Account" + std::to_string(index), "Username",
+                           index % 100 == 0 ? "123456" : "Unique" +
+                                                  std::to_string(index));
+    }
+    container.SetCryptographerParallelism(4, 1 << 20);
+
+    BreachedPasswordChecker checker(corpus_path);
+    REQUIRE(container.FindBreachedAccounts(checker).size() == 12);
+  }
+
+  std::remove(corpus_path.c_str());
+}
+
+TEST_CASE("Tests for password strength") {
+  PasswordContainer container(100, "CorrectKey");
+  container.SetKdfIterations(1000);
+  container.AddAccount("Github", "Username1", "password");
+  container.AddAccount("Amazon", "Username2", "k#9Tq%mZ2&vW8pLr");
+
+  SECTION("Scores the password of an account") {
+    REQUIRE(container.GetPasswordStrength(0).rating ==
+            PasswordStrength::kVeryWeak);
+    REQUIRE(container.GetPasswordStrength(1).rating ==
+            PasswordStrength::kVeryStrong);
+  }
+
+  SECTION("Scores every password in the order accounts were added") {
+    vector<PasswordStrength> strengths = container.ScorePasswords();
+    REQUIRE(strengths.size() == 2);
+    REQUIRE(strengths[0].rating == PasswordStrength::kVeryWeak);
+    REQUIRE(strengths[1].rating == PasswordStrength::kVeryStrong);
+  }
+
+  SECTION("Rescores passwords that change") {
+    container.ScorePasswords();
+    container.ModifyAccount("Github", "Username1", "k#9Tq%mZ2&vW8pLr!");
+    container.AddAccount("Netflix", "Username3", "aaaaaaaa");
+    container.DeleteAccount("Amazon");
+
+    vector<PasswordStrength> strengths = container.ScorePasswords();
+    REQUIRE(strengths.size() == 2);
+    REQUIRE(strengths[0].rating == PasswordStrength::kVeryStrong);
+    REQUIRE(strengths[1].rating == PasswordStrength::kVeryWeak);
+  }
+
+  SECTION("Scores loaded accounts in parallel") {
+    for (size_t index = 0; index < 5000; index++) {
+      container.AddAccount("Account" + std::to_string(index), "Username",
+                           "Unique" + std::to_string(index));
+    }
+    stringstream stream;
+    stream << container;
+
+    PasswordContainer loaded(100, "CorrectKey");
+    loaded.SetCryptographerParallelism(4, 1 << 20);
+    stream >> loaded;
+    vector<PasswordStrength> strengths = loaded.ScorePasswords();
+    REQUIRE(strengths.size() == 5002);
+    REQUIRE(strengths[4000].entropy_bits ==
+            loaded.GetPasswordStrength(4000).entropy_bits);
+  }
+
+  SECTION("Throws exception for an invalid index") {
+    REQUIRE_THROWS_AS(container.GetPasswordStrength(2),
+                      std::invalid_argument);
+  }
+}
+
 TEST_CASE("Tests for FindAccount") {
   PasswordContainer container(100, "CorrectKey");
   ifstream file("../../../tests/resources/Data.pwords");
   file >> container;
 
-  SECTION("Returns correct element iterator for account that exists") {
+  SECTION("Returns correct index for account that exists") {
     PasswordContainer::AccountDetails account =
-        *container.FindAccount("Account1");
+        container.GetAccount(container.FindAccount("Account1"));
     REQUIRE(account.account_name == "Account1");
     REQUIRE(account.username == "Username1");
     REQUIRE(account.password == "Password1");
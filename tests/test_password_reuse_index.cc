@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+#include "core/audit/password_reuse_index.h"
+
+using passwordcontainer::PasswordReuseIndex;
+using std::string;
+using std::vector;
+
+TEST_CASE("Tests for PasswordReuseIndex") {
+  PasswordReuseIndex index;
+  index.Build({"Github", "Amazon", "Netflix", "Gmail", "Bank"},
+              {"Shared1", "Shared1", "Unique1", "Shared2", "Shared1"}, 1);
+
+  SECTION("Groups the accounts that share a password") {
+    REQUIRE(index.GetReuseGroups() ==
+            vector<vector<string>>({{"Amazon", "Bank", "Github"}}));
+  }
+
+  SECTION("Follows added and removed accounts") {
+    index.Add("Yahoo", "Shared2");
+    index.Remove("Bank", "Shared1");
+    index.Remove("Amazon", "Shared1");
+    REQUIRE(index.GetReuseGroups() ==
+            vector<vector<string>>({{"Gmail", "Yahoo"}}));
+  }
+
+  SECTION("Lists the largest groups first") {
+    index.Add("Yahoo", "Shared2");
+    index.Add("Outlook", "Unique1");
+    REQUIRE(index.GetReuseGroups() ==
+            vector<vector<string>>({{"Amazon", "Bank", "Github"},
+                                    {"Gmail", "Yahoo"},
+                                    {"Netflix", "Outlook"}}));
+  }
+
+  SECTION("Gives the same groups when built on many threads") {
+    vector<string> account_names;
+    vector<string> passwords;
+    for (size_t index = 0; index < 5000; index++) {
+      account_names.push_back("Account" + std::to_string(index));
+      passwords.push_back(index < 4000 ? "Password" + std::to_string(index)
+                                       : "Shared");
+    }
+
+    PasswordReuseIndex parallel_index;
+    parallel_index.Build(account_names, passwords, 4);
+    REQUIRE(parallel_index.GetReuseGroups().size() == 1);
+    REQUIRE(parallel_index.GetReuseGroups()[0].size() == 1000);
+  }
+
+  SECTION("Throws exception when removing an account with another password") {
+    REQUIRE_THROWS_AS(index.Remove("Github", "Unique1"),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(index.Remove("Yahoo", "Shared1"), std::invalid_argument);
+  }
+
+  SECTION("Throws exception for mismatched columns") {
+    REQUIRE_THROWS_AS(index.Build({"Github"}, {}, 1), std::invalid_argument);
+  }
+}
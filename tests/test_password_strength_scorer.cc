@@ -0,0 +1,91 @@
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/audit/password_strength_scorer.h"
+
+using passwordcontainer::PasswordStrength;
+using passwordcontainer::PasswordStrengthScorer;
+using std::string;
+using std::vector;
+
+TEST_CASE("Tests for PasswordStrengthScorer") {
+  PasswordStrengthScorer scorer;
+
+  SECTION("Common passwords are very weak") {
+    PasswordStrength strength = scorer.Score("password");
+    REQUIRE(strength.rating == PasswordStrength::kVeryWeak);
+    REQUIRE(strength.pattern_count == 1);
+    REQUIRE(strength.character_class_count == 1);
+  }
+
+  SECTION("Finds dictionary words with capitals and substitutions") {
+    REQUIRE(scorer.Score("P@ssw0rd").pattern_count == 1);
+    REQUIRE(scorer.Score("Dragon!Monkey").pattern_count == 2);
+    REQUIRE(scorer.Score("P@ssw0rd").entropy_bits <
+            scorer.Score("Pq8sw$rd").entropy_bits);
+  }
+
+  SECTION("Finds repeats and sequences") {
+    REQUIRE(scorer.Score("aaaaaaaa").pattern_count == 1);
+    REQUIRE(scorer.Score("abcdefgh").pattern_count == 1);
+    REQUIRE(scorer.Score("87654321").pattern_count == 1);
+    REQUIRE(scorer.Score("87654321").rating == PasswordStrength::kVeryWeak);
+  }
+
+  SECTION("Long random passwords are very strong") {
+    PasswordStrength strength = scorer.Score("k#9Tq%mZ2&vW8pLr");
+    REQUIRE(strength.rating == PasswordStrength::kVeryStrong);
+    REQUIRE(strength.character_class_count == 4);
+    REQUIRE(strength.pattern_count == 0);
+  }
+
+  SECTION("Empty passwords have no entropy") {
+    REQUIRE(scorer.Score("").entropy_bits == 0);
+    REQUIRE(scorer.Score("").rating == PasswordStrength::kVeryWeak);
+  }
+
+  SECTION("Loads extra words from a file") {
+    const string word_list_path = "../../../tests/resources/Words.txt";
+    {
+      std::ofstream file(word_list_path);
+      file << "Zebracorn\r\nab\n";
+    }
+
+    REQUIRE(scorer.Score("zebracorn").pattern_count == 0);
+    scorer.LoadWordList(word_list_path);
+    REQUIRE(scorer.Score("zebracorn").pattern_count == 1);
+    REQUIRE(scorer.Score("ZEBRACORN").pattern_count == 1);
+    std::remove(word_list_path.c_str());
+  }
+
+  SECTION("Throws exception when the word list can't be opened") {
+    REQUIRE_THROWS_AS(scorer.LoadWordList("../../../tests/resources/None.txt"),
+                      std::invalid_argument);
+  }
+
+  SECTION("Scores a batch in parallel the same as one at a time") {
+    vector<string> passwords;
+    for (size_t index = 0; index < 5000; index++) {
+      passwords.push_back("Password" + std::to_string(index * 7919));
+    }
+
+    vector<PasswordStrength> strengths = scorer.ScoreAll(passwords, 4);
+    REQUIRE(strengths.size() == passwords.size());
+    for (size_t index = 0; index < passwords.size(); index++) {
+      REQUIRE(strengths[index].entropy_bits ==
+              scorer.Score(passwords[index]).entropy_bits);
+    }
+  }
+
+  SECTION("Describes strengths") {
+    PasswordStrength strength;
+    strength.entropy_bits = 30.7;
+    strength.rating = PasswordStrength::kWeak;
+    REQUIRE(PasswordStrengthScorer::Describe(strength) == "Weak, 30 bits");
+    REQUIRE(PasswordStrengthScorer::GetRatingName(
+                PasswordStrength::kVeryStrong) == "Very strong");
+  }
+}
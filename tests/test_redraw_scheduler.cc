@@ -0,0 +1,47 @@
+#include <catch2/catch.hpp>
+#include <stdexcept>
+
+#include "gui/redraw_scheduler.h"
+
+using passwordcontainer::gui::RedrawScheduler;
+
+TEST_CASE("Tests for RedrawScheduler") {
+  RedrawScheduler scheduler(2);
+
+  SECTION("Becomes idle once the settle frames are drawn") {
+    REQUIRE_FALSE(scheduler.IsIdle());
+    scheduler.EndFrame();
+    REQUIRE_FALSE(scheduler.IsIdle());
+    scheduler.EndFrame();
+    REQUIRE(scheduler.IsIdle());
+
+    scheduler.EndFrame();
+    REQUIRE(scheduler.GetIdleFrameCount() == 1);
+    REQUIRE(scheduler.GetFrameCount() == 3);
+  }
+
+  SECTION("Invalidating wakes the app up") {
+    scheduler.EndFrame();
+    scheduler.EndFrame();
+    scheduler.Invalidate();
+    REQUIRE_FALSE(scheduler.IsIdle());
+    scheduler.EndFrame();
+    scheduler.EndFrame();
+    REQUIRE(scheduler.IsIdle());
+  }
+
+  SECTION("Only a new revision invalidates the frame") {
+    scheduler.CheckRevision(5);
+    scheduler.EndFrame();
+    scheduler.EndFrame();
+    scheduler.CheckRevision(5);
+    REQUIRE(scheduler.IsIdle());
+
+    scheduler.CheckRevision(6);
+    REQUIRE_FALSE(scheduler.IsIdle());
+  }
+
+  SECTION("Throws error for a settle frame count of 0") {
+    REQUIRE_THROWS_AS(RedrawScheduler(0), std::invalid_argument);
+  }
+}
@@ -0,0 +1,31 @@
+#include <catch2/catch.hpp>
+#include <string>
+
+#include "core/encryption/key_derivation.h"
+#include "core/encryption/sha1.h"
+
+using passwordcontainer::Sha1;
+using passwordcontainer::keyderivation::ConvertToHex;
+using std::string;
+
+TEST_CASE("Tests for Sha1") {
+  SECTION("Matches the standard test vectors") {
+    REQUIRE(ConvertToHex(Sha1("")) ==
+            "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+    REQUIRE(ConvertToHex(Sha1("abc")) ==
+            "a9993e364706816aba3e25717850c26c9cd0d89d");
+    REQUIRE(ConvertToHex(Sha1(
+                "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")) ==
+            "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+  }
+
+  SECTION("Hashes messages longer than a block") {
+    REQUIRE(ConvertToHex(Sha1(string(1000000, 'a'))) ==
+            "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+  }
+
+  SECTION("Hashes a common password") {
+    REQUIRE(ConvertToHex(Sha1("password")) ==
+            "5baa61e4c9b93f3f0682250b6cf8331b7ee68fd8");
+  }
+}
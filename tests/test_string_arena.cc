@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+#include <string>
+
+#include "core/storage/string_arena.h"
+
+using passwordcontainer::StringArena;
+using passwordcontainer::StringRef;
+using std::string;
+
+TEST_CASE("Tests for StringArena") {
+  StringArena arena(64);
+
+  SECTION("Returns the strings that were appended") {
+    StringArena::Handle first = arena.Append("First");
+    StringArena::Handle second = arena.Append("Second");
+
+    REQUIRE(arena.Get(first) == "First");
+    REQUIRE(arena.Get(second) == "Second");
+    REQUIRE(arena.GetUsedBytes() == 11);
+  }
+
+  SECTION("Packs strings into one block until it is full") {
+    for (size_t index = 0; index < 8; index++) {
+      arena.Append(string(8, 'a'));
+    }
+    REQUIRE(arena.GetBlockCount() == 1);
+
+    arena.Append("a");
+    REQUIRE(arena.GetBlockCount() == 2);
+  }
+
+  SECTION("Strings longer than a block get their own block") {
+    StringArena::Handle handle = arena.Append(string(100, 'b'));
+
+    REQUIRE(arena.Get(handle) == string(100, 'b'));
+    REQUIRE(arena.GetAllocatedBytes() == 100);
+  }
+
+  SECTION("Views stay valid when more blocks are allocated") {
+    StringRef first = arena.Get(arena.Append("First"));
+    for (size_t index = 0; index < 100; index++) {
+      arena.Append(string(10, 'c'));
+    }
+
+    REQUIRE(first == "First");
+  }
+
+  SECTION("Empty strings don't use any bytes") {
+    StringArena::Handle handle = arena.Append("");
+
+    REQUIRE(arena.Get(handle) == "");
+    REQUIRE(arena.GetAllocatedBytes() == 0);
+  }
+
+  SECTION("Copies keep the same handles") {
+    StringArena::Handle first = arena.Append("First");
+    StringArena::Handle second = arena.Append(string(100, 'd'));
+    StringArena copy = arena;
+    arena.Clear();
+
+    REQUIRE(copy.Get(first) == "First");
+    REQUIRE(copy.Get(second) == string(100, 'd'));
+    REQUIRE(copy.GetUsedBytes() == 105);
+  }
+
+  SECTION("Clearing frees every block") {
+    arena.Append("First");
+    arena.Clear();
+
+    REQUIRE(arena.GetBlockCount() == 0);
+    REQUIRE(arena.GetUsedBytes() == 0);
+    REQUIRE(arena.GetAllocatedBytes() == 0);
+  }
+
+  SECTION("Throws error for a block size of 0") {
+    REQUIRE_THROWS_AS(StringArena(0), std::invalid_argument);
+  }
+}
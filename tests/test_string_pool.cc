@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+#include <string>
+
+#include "core/storage/string_pool.h"
+
+using passwordcontainer::StringPool;
+using std::string;
+
+TEST_CASE("Tests for StringPool") {
+  StringPool pool;
+  StringPool::Id first = pool.Intern("first@example.com");
+  StringPool::Id second = pool.Intern("second@example.com");
+
+  SECTION("Interning the same string returns the same id") {
+    REQUIRE(pool.Intern("first@example.com") == first);
+    REQUIRE(pool.GetUseCount(first) == 2);
+    REQUIRE(pool.GetSize() == 2);
+  }
+
+  SECTION("Returns the string for an id") {
+    REQUIRE(pool.Get(first) == "first@example.com");
+    REQUIRE(pool.Get(second) == "second@example.com");
+  }
+
+  SECTION("Finds strings without counting a use") {
+    REQUIRE(pool.Find("second@example.com") == second);
+    REQUIRE(pool.Find("missing@example.com") == StringPool::kNoId);
+    REQUIRE(pool.GetUseCount(second) == 1);
+  }
+
+  SECTION("Frees a string once it isn't used anymore") {
+    pool.Intern("first@example.com");
+    pool.Release(first);
+    REQUIRE(pool.Get(first) == "first@example.com");
+
+    pool.Release(first);
+    REQUIRE(pool.Find("first@example.com") == StringPool::kNoId);
+    REQUIRE(pool.GetSize() == 1);
+  }
+
+  SECTION("Reuses the ids of freed strings") {
+    pool.Release(first);
+    REQUIRE(pool.Intern("third@example.com") == first);
+    REQUIRE(pool.Get(first) == "third@example.com");
+  }
+
+  SECTION("Copies keep the same ids") {
+    StringPool copy = pool;
+    pool.Clear();
+
+    REQUIRE(copy.Get(first) == "first@example.com");
+    REQUIRE(copy.Get(second) == "second@example.com");
+    REQUIRE(copy.Intern("first@example.com") == first);
+  }
+
+  SECTION("Throws error for an id that isn't in the pool") {
+    pool.Release(second);
+    REQUIRE_THROWS_AS(pool.Get(second), std::invalid_argument);
+    REQUIRE_THROWS_AS(pool.Release(second), std::invalid_argument);
+    REQUIRE_THROWS_AS(pool.GetUseCount(100), std::invalid_argument);
+  }
+}
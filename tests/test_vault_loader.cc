@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "core/password_container.h"
+#include "core/vault_loader.h"
+
+using passwordcontainer::PasswordContainer;
+using passwordcontainer::VaultLoader;
+using std::string;
+
+namespace {
+
+// Waits for the running load of the passed in loader to finish.
+void WaitForLoad(const VaultLoader& loader) {
+  while (loader.IsLoading()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Tests for VaultLoader") {
+  const string file_path = "../../../tests/resources/Loader.pwords";
+  PasswordContainer saved(100, "CorrectKey");
+  saved.SetKdfIterations(1000);
+  saved.AddAccount("Account1", "Username1", "Password1");
+  saved.AddAccount("Account2", "Username2", "Password2");
+
+  std::ofstream file_output(file_path);
+  file_output << saved;
+  file_output.close();
+
+  PasswordContainer container(100, "DefaultKey");
+  VaultLoader loader(100, 1, 0);
+
+  SECTION("Swaps in the loaded container once it is taken") {
+    REQUIRE_FALSE(loader.TakeLoadedContainer(container));
+
+    loader.Start(file_path, "CorrectKey");
+    WaitForLoad(loader);
+    REQUIRE(loader.GetReadBytes() == loader.GetTotalBytes());
+    REQUIRE(loader.GetTotalBytes() > 0);
+    REQUIRE(container.GetAccountCount() == 0);
+
+    REQUIRE(loader.TakeLoadedContainer(container));
+    REQUIRE(container.GetAccountNames() ==
+            std::vector<string>({"Account1", "Account2"}));
+    REQUIRE(container.GetCryptographerKey() == saved.GetCryptographerKey());
+    REQUIRE_FALSE(loader.TakeLoadedContainer(container));
+  }
+
+  SECTION("Throws the error of a failed load when it is taken") {
+    loader.Start(file_path, "WrongKey");
+    WaitForLoad(loader);
+    REQUIRE_THROWS_AS(loader.TakeLoadedContainer(container),
+                      std::invalid_argument);
+    REQUIRE(container.GetAccountCount() == 0);
+
+    // The key can be entered again after a failed load
+    loader.Start(file_path, "CorrectKey");
+    WaitForLoad(loader);
+    REQUIRE(loader.TakeLoadedContainer(container));
+  }
+
+  SECTION("Canceled loads are never swapped in") {
+    loader.Start(file_path, "CorrectKey");
+    loader.Cancel();
+    WaitForLoad(loader);
+    REQUIRE_FALSE(loader.TakeLoadedContainer(container));
+    REQUIRE(container.GetAccountCount() == 0);
+  }
+
+  std::remove(file_path.c_str());
+}
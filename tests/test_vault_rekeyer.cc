@@ -0,0 +1,113 @@
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+#include "core/encryption/cryptographer.h"
+#include "core/vault_rekeyer.h"
+
+using passwordcontainer::Cryptographer;
+using passwordcontainer::VaultRekeyer;
+using std::string;
+using std::stringstream;
+
+TEST_CASE("Tests for VaultRekeyer") {
+  Cryptographer old_cryptographer(100, "OldKey");
+  Cryptographer new_cryptographer(100, "NewKey");
+
+  string plain_text;
+  for (size_t index = 0; index < 1000; index++) {
+    plain_text += "Account" + std::to_string(index) + "\tUser\tPassword\n";
+  }
+
+  SECTION("Rekeyed data is the same as data encrypted with the new key") {
+    stringstream input(old_cryptographer.EncryptString(plain_text));
+    stringstream output;
+
+    // Uses small chunks so the data is split into many of them
+    VaultRekeyer rekeyer(4, 300);
+    rekeyer.Reencrypt(input, output, old_cryptographer, new_cryptographer,
+                      input.str().size(), nullptr);
+
+    REQUIRE(output.str() == new_cryptographer.EncryptString(plain_text));
+  }
+
+  SECTION("Reports progress after every chunk") {
+    string encrypted_text = old_cryptographer.EncryptString(plain_text);
+    stringstream input(encrypted_text);
+    stringstream output;
+    size_t call_count = 0;
+    size_t last_length = 0;
+
+    VaultRekeyer rekeyer(2, 3000);
+    rekeyer.Reencrypt(input, output, old_cryptographer, new_cryptographer,
+                      encrypted_text.size(),
+                      [&](size_t rekeyed_length, size_t total_length) {
+                        REQUIRE(rekeyed_length > last_length);
+                        REQUIRE(total_length == encrypted_text.size());
+                        last_length = rekeyed_length;
+                        call_count++;
+                      });
+
+    REQUIRE(last_length == encrypted_text.size());
+    REQUIRE(call_count == (encrypted_text.size() + 2999) / 3000);
+  }
+
+  SECTION("Throws error for bad data") {
+    stringstream input(old_cryptographer.EncryptString(plain_text) + "12");
+    stringstream output;
+
+    VaultRekeyer rekeyer(4, 300);
+    REQUIRE_THROWS_AS(rekeyer.Reencrypt(input, output, old_cryptographer,
+                                        new_cryptographer, input.str().size(),
+                                        nullptr),
+                      std::invalid_argument);
+  }
+
+  SECTION("Throws error for a chunk length that splits a character") {
+    REQUIRE_THROWS_AS(VaultRekeyer(4, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(VaultRekeyer(4, 301), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Tests for OverwriteFile") {
+  const string source_path = "../../../tests/resources/Overwrite.pwords.new";
+  const string target_path = "../../../tests/resources/Overwrite.pwords";
+  std::ofstream(target_path) << "old data";
+  std::ofstream(source_path) << "new data";
+
+  SECTION("Replaces the target with the source") {
+    VaultRekeyer::OverwriteFile(source_path, target_path);
+
+    std::ifstream target(target_path);
+    string target_data(std::istreambuf_iterator<char>(target), {});
+    REQUIRE(target_data == "new data");
+    REQUIRE_FALSE(std::ifstream(source_path).good());
+  }
+
+#ifndef _WIN32
+  SECTION("Keeps the permissions of the target") {
+    chmod(target_path.c_str(), 0600);
+    chmod(source_path.c_str(), 0644);
+    VaultRekeyer::OverwriteFile(source_path, target_path);
+
+    struct stat target_status;
+    REQUIRE(stat(target_path.c_str(), &target_status) == 0);
+    REQUIRE((target_status.st_mode & 0777) == 0600);
+  }
+#endif
+
+  SECTION("Throws error for a missing source") {
+    std::remove(source_path.c_str());
+    REQUIRE_THROWS_AS(VaultRekeyer::OverwriteFile(source_path, target_path),
+                      std::invalid_argument);
+  }
+
+  std::remove(source_path.c_str());
+  std::remove(target_path.c_str());
+}
@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "core/password_container.h"
+#include "core/vault_saver.h"
+
+using passwordcontainer::PasswordContainer;
+using passwordcontainer::VaultSaver;
+using std::string;
+
+namespace {
+
+// Waits for the running save of the passed in saver to finish.
+void WaitForSave(const VaultSaver& saver) {
+  while (saver.IsSaving()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Tests for VaultSaver") {
+  const string file_path = "../../../tests/resources/Saver.pwords";
+  PasswordContainer container(100, "CorrectKey");
+  container.SetKdfIterations(1000);
+  container.AddAccount("Account1", "Username1", "Password1");
+  container.AddAccount("Account2", "Username2", "Password2");
+  VaultSaver saver;
+
+  SECTION("Saves the accounts from when the save started") {
+    REQUIRE_FALSE(saver.FinishSave());
+
+    saver.Start(container, file_path);
+    container.AddAccount("Account3", "Username3", "Password3");
+    WaitForSave(saver);
+    REQUIRE(saver.FinishSave());
+    REQUIRE_FALSE(saver.FinishSave());
+
+    PasswordContainer loaded(100, "CorrectKey");
+    std::ifstream file_input(file_path);
+    file_input >> loaded;
+    REQUIRE(loaded.GetAccountNames() ==
+            std::vector<string>({"Account1", "Account2"}));
+  }
+
+  SECTION("Throws the error of a failed save when it is checked") {
+    saver.Start(container, "../../../tests/resources/Missing/Saver.pwords");
+    WaitForSave(saver);
+    REQUIRE_THROWS_AS(saver.FinishSave(), std::invalid_argument);
+
+    // The container can be saved again after a failed save
+    saver.Start(container, file_path);
+    WaitForSave(saver);
+    REQUIRE(saver.FinishSave());
+  }
+
+  std::remove(file_path.c_str());
+}
@@ -0,0 +1,33 @@
+#include <catch2/catch.hpp>
+#include <string>
+
+#include "core/audit/word_trie.h"
+
+using passwordcontainer::WordTrie;
+
+TEST_CASE("Tests for WordTrie") {
+  WordTrie trie;
+  trie.Insert("pass");
+  trie.Insert("password");
+  trie.Insert("word");
+
+  SECTION("Counts distinct words") {
+    REQUIRE(trie.GetWordCount() == 3);
+    trie.Insert("word");
+    trie.Insert("");
+    REQUIRE(trie.GetWordCount() == 3);
+  }
+
+  SECTION("Finds the longest word at a position") {
+    REQUIRE(trie.FindLongestWord("password1", 0) == 8);
+    REQUIRE(trie.FindLongestWord("passwor", 0) == 4);
+    REQUIRE(trie.FindLongestWord("mypassword", 2) == 8);
+    REQUIRE(trie.FindLongestWord("password", 4) == 4);
+  }
+
+  SECTION("Returns 0 when no word starts at a position") {
+    REQUIRE(trie.FindLongestWord("pas", 0) == 0);
+    REQUIRE(trie.FindLongestWord("mypassword", 0) == 0);
+    REQUIRE(trie.FindLongestWord("word", 4) == 0);
+  }
+}